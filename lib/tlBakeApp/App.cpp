@@ -18,6 +18,9 @@
 #include <ftk/Core/Math.h>
 #include <ftk/Core/String.h>
 
+#include <cmath>
+#include <cstring>
+
 namespace tl
 {
     namespace bake
@@ -295,11 +298,31 @@ namespace tl
             io::Info ioInfo;
             ioInfo.video.push_back(_outputInfo);
             ioInfo.videoTime = _timeRange;
+            if (info.audio.isValid())
+            {
+                // The timeline audio is requested in one second chunks, the
+                // first chunk is trimmed to the start of the time range.
+                _audioInfo = info.audio;
+                ioInfo.audio = _audioInfo;
+                ioInfo.audioTime = OTIO_NS::TimeRange(
+                    _timeRange.start_time().rescaled_to(_audioInfo.sampleRate).round(),
+                    _timeRange.duration().rescaled_to(_audioInfo.sampleRate).round());
+                const double seconds = _timeRange.start_time().rescaled_to(1.0).value();
+                _audioSeconds = static_cast<int64_t>(std::floor(seconds));
+                _audioSkip = std::llround((seconds - _audioSeconds) * _audioInfo.sampleRate);
+                _audioTime = OTIO_NS::RationalTime(0.0, _audioInfo.sampleRate);
+            }
             _writer = _writerPlugin->write(file::Path(output), ioInfo, _getIOOptions());
             if (!_writer)
             {
                 throw std::runtime_error(ftk::Format("Cannot open: \"{0}\"").arg(output));
             }
+            if (!_writer->hasAudio())
+            {
+                // The audio is not read or mixed for writers that do not
+                // support it.
+                _audioInfo = audio::Info();
+            }
 
             // Set options.
             if (_cmdLine.ocioFileName->hasValue() ||
@@ -349,6 +372,7 @@ namespace tl
             {
                 _tick();
             }
+            _writer->finish();
 
             const auto now = std::chrono::steady_clock::now();
             const std::chrono::duration<float> diff = now - _startTime;
@@ -494,6 +518,10 @@ namespace tl
                 format,
                 type,
                 _outputImage->getData());
+            if (_audioInfo.isValid())
+            {
+                _writeAudio();
+            }
             _writer->writeVideo(_outputTime, _outputImage);
 
             // Advance the time.
@@ -505,6 +533,100 @@ namespace tl
             _outputTime += OTIO_NS::RationalTime(1, _outputTime.rate());
         }
 
+        void App::_writeAudio()
+        {
+            // Write enough audio to cover the current frame.
+            const OTIO_NS::RationalTime end =
+                (_outputTime + OTIO_NS::RationalTime(1, _outputTime.rate())).
+                rescaled_to(_audioInfo.sampleRate).round();
+            while (_audioTime < end)
+            {
+                const auto audioData = _timeline->getAudio(_audioSeconds).future.get();
+                std::vector<std::shared_ptr<audio::Audio> > layers;
+                for (size_t i = 0; i < audioData.layers.size(); ++i)
+                {
+                    const auto& layerAudio = audioData.layers[i].audio;
+                    if (!layerAudio)
+                    {
+                        continue;
+                    }
+                    if (layerAudio->getChannelCount() == _audioInfo.channelCount &&
+                        layerAudio->getDataType() == _audioInfo.dataType &&
+                        layerAudio->getSampleRate() == _audioInfo.sampleRate)
+                    {
+                        layers.push_back(layerAudio);
+                    }
+                    else
+                    {
+                        layers.push_back(_resampleAudio(i, layerAudio));
+                    }
+                }
+                std::shared_ptr<audio::Audio> audio;
+                if (!layers.empty())
+                {
+                    audio = audio::mix(layers, 1.F);
+                }
+                else
+                {
+                    audio = audio::Audio::create(_audioInfo, _audioInfo.sampleRate);
+                    audio->zero();
+                }
+                if (_audioSkip > 0)
+                {
+                    const size_t skip = std::min(_audioSkip, audio->getSampleCount());
+                    auto trimmed = audio::Audio::create(_audioInfo, audio->getSampleCount() - skip);
+                    std::memcpy(
+                        trimmed->getData(),
+                        audio->getData() + skip * _audioInfo.getByteCount(),
+                        trimmed->getByteCount());
+                    audio = trimmed;
+                    _audioSkip = 0;
+                }
+                const OTIO_NS::RationalTime duration(audio->getSampleCount(), _audioInfo.sampleRate);
+                _writer->writeAudio(OTIO_NS::TimeRange(_audioTime, duration), audio);
+                _audioTime += duration;
+                ++_audioSeconds;
+            }
+        }
+
+        std::shared_ptr<audio::Audio> App::_resampleAudio(
+            size_t layer,
+            const std::shared_ptr<audio::Audio>& audio)
+        {
+            // Each layer has its own resampler and buffer so that the
+            // resampled audio is continuous across the one second chunks.
+            // The output is one second long to match the other layers, the
+            // delay of the resampler is filled with silence.
+            auto& resample = _audioResample[layer];
+            if (!resample || resample->getInputInfo() != audio->getInfo())
+            {
+                resample = audio::AudioResample::create(audio->getInfo(), _audioInfo);
+            }
+            auto& buffer = _audioResampleBuffers[layer];
+            if (auto resampled = resample->process(audio))
+            {
+                buffer.push_back(resampled);
+            }
+            else
+            {
+                throw std::runtime_error(ftk::Format(
+                    "Cannot convert audio from {0} channels {1}Hz to {2} channels {3}Hz").
+                    arg(audio->getChannelCount()).
+                    arg(audio->getSampleRate()).
+                    arg(_audioInfo.channelCount).
+                    arg(_audioInfo.sampleRate));
+            }
+            const size_t sampleCount = _audioInfo.sampleRate;
+            const size_t available = std::min(sampleCount, audio::getSampleCount(buffer));
+            auto out = audio::Audio::create(_audioInfo, sampleCount);
+            out->zero();
+            audio::move(
+                buffer,
+                out->getData() + (sampleCount - available) * _audioInfo.getByteCount(),
+                available);
+            return out;
+        }
+
         void App::_printProgress()
         {
             const int64_t c = static_cast<int64_t>(_inputTime.value() - _timeRange.start_time().value());
@@ -5,6 +5,8 @@
 #include <tlTimeline/Timeline.h>
 
 #include <tlIO/SequenceIO.h>
+
+#include <tlCore/AudioResample.h>
 #if defined(TLRENDER_EXR)
 #include <tlIO/OpenEXR.h>
 #endif // TLRENDER_EXR
@@ -94,6 +96,10 @@ namespace tl
             io::Options _getIOOptions() const;
 
             void _tick();
+            void _writeAudio();
+            std::shared_ptr<audio::Audio> _resampleAudio(
+                size_t layer,
+                const std::shared_ptr<audio::Audio>&);
             void _printProgress();
 
             CmdLine _cmdLine;
@@ -106,6 +112,12 @@ namespace tl
             OTIO_NS::TimeRange _timeRange = time::invalidTimeRange;
             OTIO_NS::RationalTime _inputTime = time::invalidTime;
             OTIO_NS::RationalTime _outputTime = time::invalidTime;
+            audio::Info _audioInfo;
+            int64_t _audioSeconds = 0;
+            size_t _audioSkip = 0;
+            OTIO_NS::RationalTime _audioTime = time::invalidTime;
+            std::map<size_t, std::shared_ptr<audio::AudioResample> > _audioResample;
+            std::map<size_t, std::list<std::shared_ptr<audio::Audio> > > _audioResampleBuffers;
 
             std::shared_ptr<ftk::gl::Window> _window;
             std::shared_ptr<io::IPlugin> _usdPlugin;
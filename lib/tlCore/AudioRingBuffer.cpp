@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlCore/AudioRingBuffer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+
+namespace tl
+{
+    namespace audio
+    {
+        struct AudioRingBuffer::Private
+        {
+            Info info;
+            size_t byteCount = 0;
+            uint64_t sampleCount = 0;
+            std::vector<uint8_t> data;
+
+            // The positions are sample counts that only increase, the
+            // position in the data is the count modulo the size of the
+            // buffer. The read and write positions are kept on separate
+            // cache lines since they are updated by different threads.
+            alignas(64) std::atomic<uint64_t> writePos;
+            alignas(64) std::atomic<uint64_t> readPos;
+            alignas(64) std::atomic<uint64_t> flushPos;
+        };
+
+        void AudioRingBuffer::_init(const Info& info, size_t sampleCount)
+        {
+            FTK_P();
+            p.info = info;
+            p.byteCount = info.getByteCount();
+            p.sampleCount = sampleCount;
+            p.data.resize(sampleCount * p.byteCount);
+            p.writePos = 0;
+            p.readPos = 0;
+            p.flushPos = 0;
+        }
+
+        AudioRingBuffer::AudioRingBuffer() :
+            _p(new Private)
+        {}
+
+        AudioRingBuffer::~AudioRingBuffer()
+        {}
+
+        std::shared_ptr<AudioRingBuffer> AudioRingBuffer::create(
+            const Info& info,
+            size_t sampleCount)
+        {
+            auto out = std::shared_ptr<AudioRingBuffer>(new AudioRingBuffer);
+            out->_init(info, sampleCount);
+            return out;
+        }
+
+        const Info& AudioRingBuffer::getInfo() const
+        {
+            return _p->info;
+        }
+
+        size_t AudioRingBuffer::getSampleCount() const
+        {
+            return _p->sampleCount;
+        }
+
+        size_t AudioRingBuffer::getReadAvailable() const
+        {
+            FTK_P();
+            const uint64_t readPos = std::max(
+                p.readPos.load(std::memory_order_acquire),
+                p.flushPos.load(std::memory_order_acquire));
+            const uint64_t writePos = p.writePos.load(std::memory_order_acquire);
+            return writePos > readPos ? (writePos - readPos) : 0;
+        }
+
+        size_t AudioRingBuffer::getWriteAvailable() const
+        {
+            FTK_P();
+            const uint64_t writePos = p.writePos.load(std::memory_order_relaxed);
+            const uint64_t readPos = p.readPos.load(std::memory_order_acquire);
+            return p.sampleCount - (writePos - readPos);
+        }
+
+        size_t AudioRingBuffer::write(const uint8_t* in, size_t sampleCount)
+        {
+            FTK_P();
+            const uint64_t writePos = p.writePos.load(std::memory_order_relaxed);
+            const uint64_t readPos = p.readPos.load(std::memory_order_acquire);
+            const uint64_t count = std::min(
+                static_cast<uint64_t>(sampleCount),
+                p.sampleCount - (writePos - readPos));
+            if (count > 0)
+            {
+                const uint64_t index = writePos % p.sampleCount;
+                const uint64_t count0 = std::min(count, p.sampleCount - index);
+                std::memcpy(
+                    p.data.data() + index * p.byteCount,
+                    in,
+                    count0 * p.byteCount);
+                if (count0 < count)
+                {
+                    std::memcpy(
+                        p.data.data(),
+                        in + count0 * p.byteCount,
+                        (count - count0) * p.byteCount);
+                }
+                p.writePos.store(writePos + count, std::memory_order_release);
+            }
+            return count;
+        }
+
+        size_t AudioRingBuffer::read(uint8_t* out, size_t sampleCount)
+        {
+            FTK_P();
+            uint64_t readPos = std::max(
+                p.readPos.load(std::memory_order_relaxed),
+                p.flushPos.load(std::memory_order_acquire));
+            const uint64_t writePos = p.writePos.load(std::memory_order_acquire);
+            const uint64_t count = std::min(
+                static_cast<uint64_t>(sampleCount),
+                writePos - readPos);
+            if (count > 0)
+            {
+                const uint64_t index = readPos % p.sampleCount;
+                const uint64_t count0 = std::min(count, p.sampleCount - index);
+                std::memcpy(
+                    out,
+                    p.data.data() + index * p.byteCount,
+                    count0 * p.byteCount);
+                if (count0 < count)
+                {
+                    std::memcpy(
+                        out + count0 * p.byteCount,
+                        p.data.data(),
+                        (count - count0) * p.byteCount);
+                }
+            }
+            p.readPos.store(readPos + count, std::memory_order_release);
+            if (count < sampleCount)
+            {
+                std::memset(
+                    out + count * p.byteCount,
+                    0,
+                    (sampleCount - count) * p.byteCount);
+            }
+            return count;
+        }
+
+        size_t AudioRingBuffer::readBytes(uint8_t* out, size_t byteCount)
+        {
+            FTK_P();
+            const size_t sampleCount = p.byteCount > 0 ? (byteCount / p.byteCount) : 0;
+            const size_t count = read(out, sampleCount);
+            const size_t sampleByteCount = sampleCount * p.byteCount;
+            if (sampleByteCount < byteCount)
+            {
+                std::memset(out + sampleByteCount, 0, byteCount - sampleByteCount);
+            }
+            return count;
+        }
+
+        void AudioRingBuffer::flush()
+        {
+            FTK_P();
+            p.flushPos.store(
+                p.writePos.load(std::memory_order_relaxed),
+                std::memory_order_release);
+        }
+
+        int64_t AudioRingBuffer::getReadCount() const
+        {
+            FTK_P();
+            const uint64_t readPos = p.readPos.load(std::memory_order_acquire);
+            const uint64_t flushPos = p.flushPos.load(std::memory_order_acquire);
+            return readPos > flushPos ? static_cast<int64_t>(readPos - flushPos) : 0;
+        }
+    }
+}
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlCore/Audio.h>
+
+namespace tl
+{
+    namespace audio
+    {
+        //! Lock-free audio ring buffer.
+        //!
+        //! The ring buffer passes audio samples from one producer thread to
+        //! one consumer thread without locks. The memory is allocated when
+        //! the ring buffer is created, reading and writing only copy
+        //! samples, so the buffer can be read from a real-time audio
+        //! callback.
+        class AudioRingBuffer
+        {
+            FTK_NON_COPYABLE(AudioRingBuffer);
+
+        protected:
+            void _init(const Info&, size_t sampleCount);
+
+            AudioRingBuffer();
+
+        public:
+            ~AudioRingBuffer();
+
+            //! Create a new ring buffer.
+            static std::shared_ptr<AudioRingBuffer> create(
+                const Info&,
+                size_t sampleCount);
+
+            //! Get the audio information.
+            const Info& getInfo() const;
+
+            //! Get the maximum number of samples.
+            size_t getSampleCount() const;
+
+            //! Get the number of samples that can be read.
+            size_t getReadAvailable() const;
+
+            //! Get the number of samples that can be written. This function
+            //! should only be called from the producer thread.
+            size_t getWriteAvailable() const;
+
+            //! Write samples. Returns the number of samples written, which
+            //! is less than the given count when the buffer is full. This
+            //! function should only be called from the producer thread.
+            size_t write(const uint8_t*, size_t sampleCount);
+
+            //! Read samples. When fewer samples are available the rest of
+            //! the output is filled with silence. Returns the number of
+            //! samples read. This function should only be called from the
+            //! consumer thread.
+            size_t read(uint8_t*, size_t sampleCount);
+
+            //! Read bytes, for audio device callbacks that request a number
+            //! of bytes. The bytes after the last whole sample are filled
+            //! with silence. Returns the number of samples read. This
+            //! function should only be called from the consumer thread.
+            size_t readBytes(uint8_t*, size_t byteCount);
+
+            //! Discard the samples that have been written. The samples are
+            //! discarded by the next read, until then the space is not
+            //! available for writing. This function should only be called
+            //! from the producer thread.
+            void flush();
+
+            //! Get the number of samples that have been read since the last
+            //! flush. This function can be called from any thread.
+            int64_t getReadCount() const;
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -4,6 +4,7 @@
 #include <tlCore/Init.h>
 
 #include <tlCore/AudioSystem.h>
+#include <tlCore/MemorySystem.h>
 
 #include <ftk/Core/Context.h>
 
@@ -12,5 +13,6 @@ namespace tl
     void init(const std::shared_ptr<ftk::Context>& context)
     {
         audio::System::create(context);
+        memory::System::create(context);
     }
 }
@@ -0,0 +1,406 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlCore/MemorySystem.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/Memory.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace tl
+{
+    namespace memory
+    {
+        namespace
+        {
+            const float scaleStep = .05F;
+
+            bool readLine(const std::filesystem::path& path, std::string& out)
+            {
+                std::ifstream f(path);
+                return f.is_open() && static_cast<bool>(std::getline(f, out));
+            }
+
+            bool readValue(const std::filesystem::path& path, size_t& out)
+            {
+                std::string line;
+                bool valid = readLine(path, line);
+                if (valid)
+                {
+                    std::stringstream ss(line);
+                    valid = static_cast<bool>(ss >> out);
+                }
+                return valid;
+            }
+
+            float getScale(float value, float low, float high, float min)
+            {
+                float out = 1.F;
+                if (value >= high)
+                {
+                    out = min;
+                }
+                else if (value > low && high > low)
+                {
+                    out = 1.F - (value - low) / (high - low) * (1.F - min);
+                }
+                return out;
+            }
+
+#if defined(__linux__)
+            std::filesystem::path getCGroupPath()
+            {
+                // The cgroup v2 hierarchy has a single entry with the ID
+                // zero, for example "0::/user.slice/user-1000.slice".
+                std::filesystem::path out;
+                std::ifstream f("/proc/self/cgroup");
+                std::string line;
+                while (std::getline(f, line))
+                {
+                    if (0 == line.compare(0, 3, "0::"))
+                    {
+                        out = std::filesystem::path("/sys/fs/cgroup") /
+                            std::filesystem::u8path(line.substr(3)).relative_path();
+                        break;
+                    }
+                }
+                return out;
+            }
+#endif // __linux__
+        }
+
+        FTK_ENUM_IMPL(
+            Source,
+            "None",
+            "CGroup",
+            "MemInfo");
+
+        bool Info::operator == (const Info& other) const
+        {
+            return
+                source == other.source &&
+                limit == other.limit &&
+                used == other.used &&
+                pressure == other.pressure;
+        }
+
+        bool Info::operator != (const Info& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool PressureOptions::operator == (const PressureOptions& other) const
+        {
+            return
+                usageLow == other.usageLow &&
+                usageHigh == other.usageHigh &&
+                pressureLow == other.pressureLow &&
+                pressureHigh == other.pressureHigh &&
+                scaleMin == other.scaleMin &&
+                scaleGrow == other.scaleGrow;
+        }
+
+        bool PressureOptions::operator != (const PressureOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        Info readCGroup(const std::filesystem::path& path)
+        {
+            Info out;
+            size_t current = 0;
+            if (readValue(path / "memory.current", current))
+            {
+                out.source = Source::CGroup;
+
+                // The limit is "max" when the cgroup is not limited.
+                size_t max = 0;
+                if (readValue(path / "memory.max", max))
+                {
+                    out.limit = max;
+                }
+
+                // Inactive file pages can be reclaimed by the kernel, so
+                // they are not counted.
+                size_t inactiveFile = 0;
+                std::ifstream f(path / "memory.stat");
+                std::string line;
+                while (std::getline(f, line))
+                {
+                    std::stringstream ss(line);
+                    std::string key;
+                    size_t value = 0;
+                    if (ss >> key >> value && "inactive_file" == key)
+                    {
+                        inactiveFile = value;
+                        break;
+                    }
+                }
+                out.used = current > inactiveFile ? (current - inactiveFile) : 0;
+
+                out.pressure = readPressure(path / "memory.pressure");
+            }
+            return out;
+        }
+
+        Info readMemInfo(
+            const std::filesystem::path& memInfo,
+            const std::filesystem::path& pressure)
+        {
+            Info out;
+            size_t total = 0;
+            size_t available = 0;
+            std::ifstream f(memInfo);
+            std::string line;
+            while (std::getline(f, line))
+            {
+                // The values are in kilobytes, for example
+                // "MemTotal:       16318496 kB".
+                std::stringstream ss(line);
+                std::string key;
+                size_t value = 0;
+                if (ss >> key >> value)
+                {
+                    if ("MemTotal:" == key)
+                    {
+                        total = value * ftk::kilobyte;
+                    }
+                    else if ("MemAvailable:" == key)
+                    {
+                        available = value * ftk::kilobyte;
+                    }
+                }
+            }
+            if (total > 0)
+            {
+                out.source = Source::MemInfo;
+                out.limit = total;
+                out.used = total > available ? (total - available) : 0;
+                out.pressure = readPressure(pressure);
+            }
+            return out;
+        }
+
+        float readPressure(const std::filesystem::path& path)
+        {
+            // The first line has the share of time that some tasks were
+            // stalled, for example "some avg10=1.23 avg60=0.50 ...".
+            float out = 0.F;
+            std::string line;
+            if (readLine(path, line) && 0 == line.compare(0, 4, "some"))
+            {
+                const auto i = line.find("avg10=");
+                if (i != std::string::npos)
+                {
+                    std::stringstream ss(line.substr(i + 6));
+                    float value = 0.F;
+                    if (ss >> value)
+                    {
+                        out = std::clamp(value / 100.F, 0.F, 1.F);
+                    }
+                }
+            }
+            return out;
+        }
+
+        float getScale(const Info& info, const PressureOptions& options)
+        {
+            float out = 1.F;
+            if (info.limit > 0)
+            {
+                out = std::min(out, getScale(
+                    info.used / static_cast<float>(info.limit),
+                    options.usageLow,
+                    options.usageHigh,
+                    options.scaleMin));
+            }
+            out = std::min(out, getScale(
+                info.pressure,
+                options.pressureLow,
+                options.pressureHigh,
+                options.scaleMin));
+            return out;
+        }
+
+        struct System::Private
+        {
+            std::filesystem::path cgroupPath;
+            std::shared_ptr<ftk::ObservableValue<Info> > info;
+            std::shared_ptr<ftk::ObservableValue<float> > scale;
+
+            struct Mutex
+            {
+                PressureOptions options;
+                float scale = 1.F;
+                std::map<int, std::function<void(float)> > caches;
+                int id = 0;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+        };
+
+        System::System(const std::shared_ptr<ftk::Context>& context) :
+            ISystem(context, "tl::memory::System"),
+            _p(new Private)
+        {
+            FTK_P();
+#if defined(__linux__)
+            p.cgroupPath = getCGroupPath();
+#endif // __linux__
+            p.info = ftk::ObservableValue<Info>::create();
+            p.scale = ftk::ObservableValue<float>::create(1.F);
+            tick();
+        }
+
+        System::~System()
+        {}
+
+        std::shared_ptr<System> System::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            auto out = context->getSystem<System>();
+            if (!out)
+            {
+                out = std::shared_ptr<System>(new System(context));
+                context->addSystem(out);
+            }
+            return out;
+        }
+
+        Info System::getInfo() const
+        {
+            return _p->info->get();
+        }
+
+        std::shared_ptr<ftk::IObservableValue<Info> > System::observeInfo() const
+        {
+            return _p->info;
+        }
+
+        PressureOptions System::getOptions() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.options;
+        }
+
+        void System::setOptions(const PressureOptions& value)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.options = value;
+            }
+            _scaleUpdate(p.info->get());
+        }
+
+        float System::getScale() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.scale;
+        }
+
+        std::shared_ptr<ftk::IObservableValue<float> > System::observeScale() const
+        {
+            return _p->scale;
+        }
+
+        int System::addCache(const std::function<void(float)>& callback)
+        {
+            FTK_P();
+            int id = 0;
+            float scale = 1.F;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                id = ++p.mutex.id;
+                p.mutex.caches[id] = callback;
+                scale = p.mutex.scale;
+            }
+            if (callback)
+            {
+                callback(scale);
+            }
+            return id;
+        }
+
+        void System::removeCache(int id)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.caches.erase(id);
+        }
+
+        void System::tick()
+        {
+#if defined(__linux__)
+            FTK_P();
+            Info info;
+            if (!p.cgroupPath.empty())
+            {
+                info = readCGroup(p.cgroupPath);
+            }
+            if (0 == info.limit)
+            {
+                info = readMemInfo("/proc/meminfo", "/proc/pressure/memory");
+            }
+            p.info->setIfChanged(info);
+            _scaleUpdate(info);
+#endif // __linux__
+        }
+
+        std::chrono::milliseconds System::getTickTime() const
+        {
+            return std::chrono::milliseconds(1000);
+        }
+
+        void System::_scaleUpdate(const Info& info)
+        {
+            FTK_P();
+
+            // The scale is rounded down to steps so the caches are not
+            // updated for small changes in the memory usage.
+            float scale = 1.F;
+            float prev = 1.F;
+            std::vector<std::function<void(float)> > callbacks;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                const PressureOptions& options = p.mutex.options;
+                float target = std::floor(memory::getScale(info, options) / scaleStep + .001F) * scaleStep;
+                target = std::clamp(target, std::min(options.scaleMin, 1.F), 1.F);
+                prev = p.mutex.scale;
+                scale = target < prev ? target : std::min(target, prev + options.scaleGrow);
+                if (scale != prev)
+                {
+                    p.mutex.scale = scale;
+                    for (const auto& i : p.mutex.caches)
+                    {
+                        callbacks.push_back(i.second);
+                    }
+                }
+            }
+            if (scale != prev)
+            {
+                _log(ftk::Format("Cache scale: {0} (memory used: {1}MB of {2}MB, pressure: {3}%)").
+                    arg(scale, 2).
+                    arg(info.used / ftk::megabyte).
+                    arg(info.limit / ftk::megabyte).
+                    arg(info.pressure * 100.F, 1));
+                p.scale->setIfChanged(scale);
+                for (const auto& callback : callbacks)
+                {
+                    if (callback)
+                    {
+                        callback(scale);
+                    }
+                }
+            }
+        }
+    }
+}
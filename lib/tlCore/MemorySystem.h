@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlCore/ISystem.h>
+
+#include <ftk/Core/ObservableValue.h>
+#include <ftk/Core/Util.h>
+
+#include <filesystem>
+#include <functional>
+
+namespace tl
+{
+    namespace memory
+    {
+        //! Memory information sources.
+        enum class Source
+        {
+            None,
+            CGroup,
+            MemInfo,
+
+            Count,
+            First = None
+        };
+        FTK_ENUM(Source);
+
+        //! Memory information.
+        struct Info
+        {
+            Source source = Source::None;
+
+            //! Memory limit in bytes. Zero if there is no limit.
+            size_t limit = 0;
+
+            //! Memory used in bytes.
+            size_t used = 0;
+
+            //! Share of the time that tasks were stalled waiting for memory
+            //! over the last ten seconds, from zero to one.
+            float pressure = 0.F;
+
+            bool operator == (const Info&) const;
+            bool operator != (const Info&) const;
+        };
+
+        //! Memory pressure options.
+        struct PressureOptions
+        {
+            //! Memory usage, from zero to one, where the caches start to
+            //! shrink.
+            float usageLow = .75F;
+
+            //! Memory usage, from zero to one, where the caches are
+            //! shrunk to the minimum.
+            float usageHigh = .95F;
+
+            //! Memory pressure, from zero to one, where the caches start
+            //! to shrink.
+            float pressureLow = .05F;
+
+            //! Memory pressure, from zero to one, where the caches are
+            //! shrunk to the minimum.
+            float pressureHigh = .25F;
+
+            //! Minimum cache scale.
+            float scaleMin = .1F;
+
+            //! Maximum amount the cache scale grows each update. The caches
+            //! shrink immediately but grow back slowly so they do not
+            //! oscillate around the limit.
+            float scaleGrow = .05F;
+
+            bool operator == (const PressureOptions&) const;
+            bool operator != (const PressureOptions&) const;
+        };
+
+        //! Read the memory information from a cgroup v2 directory. The
+        //! limit is zero if the cgroup does not have a memory limit.
+        Info readCGroup(const std::filesystem::path&);
+
+        //! Read the memory information from a "/proc/meminfo" file and
+        //! a "/proc/pressure/memory" file.
+        Info readMemInfo(
+            const std::filesystem::path& memInfo,
+            const std::filesystem::path& pressure);
+
+        //! Read the memory pressure from a PSI file.
+        float readPressure(const std::filesystem::path&);
+
+        //! Get the cache scale for the given memory information.
+        float getScale(const Info&, const PressureOptions&);
+
+        //! Memory system.
+        //!
+        //! The system monitors the memory usage and pressure of the process
+        //! and tells the registered caches how much to scale their maximum
+        //! size. On Linux the cgroup v2 memory controller is used when it
+        //! has a limit, otherwise "/proc/meminfo". On other platforms the
+        //! scale is always one.
+        class System : public system::ISystem
+        {
+            FTK_NON_COPYABLE(System);
+
+        protected:
+            System(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            virtual ~System();
+
+            //! Create a new system.
+            static std::shared_ptr<System> create(const std::shared_ptr<ftk::Context>&);
+
+            //! Get the memory information.
+            Info getInfo() const;
+
+            //! Observe the memory information.
+            std::shared_ptr<ftk::IObservableValue<Info> > observeInfo() const;
+
+            //! Get the options.
+            PressureOptions getOptions() const;
+
+            //! Set the options.
+            void setOptions(const PressureOptions&);
+
+            //! Get the cache scale. This function is thread safe.
+            float getScale() const;
+
+            //! Observe the cache scale.
+            std::shared_ptr<ftk::IObservableValue<float> > observeScale() const;
+
+            //! Add a cache. The callback is called with the cache scale
+            //! when it is added and whenever the scale changes. Returns an
+            //! ID used to remove the cache.
+            int addCache(const std::function<void(float)>&);
+
+            //! Remove a cache.
+            void removeCache(int);
+
+            void tick() override;
+            std::chrono::milliseconds getTickTime() const override;
+
+        private:
+            void _scaleUpdate(const Info&);
+
+            FTK_PRIVATE();
+        };
+    }
+}
@@ -0,0 +1,136 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/Compress.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+#include <zlib.h>
+
+namespace tl
+{
+    namespace io
+    {
+        namespace
+        {
+            size_t getElementSize(ftk::ImageType type)
+            {
+                return std::max(static_cast<size_t>(ftk::getBitDepth(type) / 8), size_t(1));
+            }
+
+            // Group the same byte of each sample together, for example the
+            // low bytes and then the high bytes of 16-bit samples. This
+            // makes the data much easier to compress for images with
+            // smooth gradients or flat regions.
+            void shuffle(const uint8_t* in, uint8_t* out, size_t size, size_t elementSize)
+            {
+                const size_t count = size / elementSize;
+                for (size_t i = 0; i < elementSize; ++i)
+                {
+                    uint8_t* plane = out + i * count;
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        plane[j] = in[j * elementSize + i];
+                    }
+                }
+                const size_t remainder = count * elementSize;
+                memcpy(out + remainder, in + remainder, size - remainder);
+            }
+
+            void unshuffle(const uint8_t* in, uint8_t* out, size_t size, size_t elementSize)
+            {
+                const size_t count = size / elementSize;
+                for (size_t i = 0; i < elementSize; ++i)
+                {
+                    const uint8_t* plane = in + i * count;
+                    for (size_t j = 0; j < count; ++j)
+                    {
+                        out[j * elementSize + i] = plane[j];
+                    }
+                }
+                const size_t remainder = count * elementSize;
+                memcpy(out + remainder, in + remainder, size - remainder);
+            }
+        }
+
+        CompressedImage compressImage(const std::shared_ptr<ftk::Image>& image)
+        {
+            CompressedImage out;
+            out.info = image->getInfo();
+            out.tags = image->getTags();
+            const size_t size = out.info.getByteCount();
+            std::vector<uint8_t> shuffled(size);
+            shuffle(image->getData(), shuffled.data(), size, getElementSize(out.info.type));
+
+            // The fastest compression level with run-length encoding,
+            // the images are stored uncompressed if they do not get
+            // smaller.
+            if (size > 0 && size <= UINT_MAX)
+            {
+                z_stream stream;
+                memset(&stream, 0, sizeof(z_stream));
+                if (Z_OK == deflateInit2(&stream, 1, Z_DEFLATED, 15, 8, Z_RLE))
+                {
+                    out.data.resize(deflateBound(&stream, size));
+                    stream.next_in = shuffled.data();
+                    stream.avail_in = size;
+                    stream.next_out = out.data.data();
+                    stream.avail_out = out.data.size();
+                    const int r = deflate(&stream, Z_FINISH);
+                    deflateEnd(&stream);
+                    if (Z_STREAM_END == r && stream.total_out < size)
+                    {
+                        out.data.resize(stream.total_out);
+                        out.data.shrink_to_fit();
+                        out.compressed = true;
+                    }
+                }
+            }
+            if (!out.compressed)
+            {
+                out.data = std::move(shuffled);
+            }
+            return out;
+        }
+
+        std::shared_ptr<ftk::Image> decompressImage(const CompressedImage& in)
+        {
+            auto out = ftk::Image::create(in.info);
+            out->setTags(in.tags);
+            const size_t size = in.info.getByteCount();
+            if (in.compressed)
+            {
+                std::vector<uint8_t> shuffled(size);
+                z_stream stream;
+                memset(&stream, 0, sizeof(z_stream));
+                if (Z_OK != inflateInit(&stream))
+                {
+                    throw std::runtime_error("Cannot initialize decompression");
+                }
+                stream.next_in = const_cast<uint8_t*>(in.data.data());
+                stream.avail_in = in.data.size();
+                stream.next_out = shuffled.data();
+                stream.avail_out = size;
+                const int r = inflate(&stream, Z_FINISH);
+                inflateEnd(&stream);
+                if (r != Z_STREAM_END || stream.total_out != size)
+                {
+                    throw std::runtime_error("Cannot decompress image");
+                }
+                unshuffle(shuffled.data(), out->getData(), size, getElementSize(in.info.type));
+            }
+            else
+            {
+                if (in.data.size() != size)
+                {
+                    throw std::runtime_error("Cannot decompress image");
+                }
+                unshuffle(in.data.data(), out->getData(), size, getElementSize(in.info.type));
+            }
+            return out;
+        }
+    }
+}
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <ftk/Core/Image.h>
+
+#include <memory>
+#include <vector>
+
+namespace tl
+{
+    namespace io
+    {
+        //! Losslessly compressed image.
+        struct CompressedImage
+        {
+            ftk::ImageInfo info;
+            ftk::ImageTags tags;
+
+            //! Whether the data is compressed. Images that do not get
+            //! smaller are stored uncompressed.
+            bool compressed = false;
+
+            std::vector<uint8_t> data;
+        };
+
+        //! Compress an image. The image data is shuffled into byte planes
+        //! so that the same byte of each sample is grouped together, and
+        //! then deflated with run-length encoding. This is fast and works
+        //! well for images with large flat regions, like CG renders.
+        CompressedImage compressImage(const std::shared_ptr<ftk::Image>&);
+
+        //! Decompress an image.
+        std::shared_ptr<ftk::Image> decompressImage(const CompressedImage&);
+    }
+}
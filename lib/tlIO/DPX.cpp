@@ -0,0 +1,545 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/DPXPrivate.h>
+
+#include <ftk/Core/Error.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/String.h>
+
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define TLRENDER_DPX_SSE2
+#include <emmintrin.h>
+#endif // __SSE2__
+
+namespace tl
+{
+    namespace dpx
+    {
+        FTK_ENUM_IMPL(
+            Packing,
+            "Packed",
+            "FilledA",
+            "FilledB");
+
+        namespace
+        {
+            inline uint32_t swap32(uint32_t value)
+            {
+                return
+                    (value << 24) |
+                    ((value << 8) & 0x00ff0000) |
+                    ((value >> 8) & 0x0000ff00) |
+                    (value >> 24);
+            }
+
+            inline uint32_t getWord(const uint8_t* p, bool swapEndian)
+            {
+                uint32_t out = 0;
+                std::memcpy(&out, p, sizeof(uint32_t));
+                return swapEndian ? swap32(out) : out;
+            }
+
+            inline uint16_t to16(uint32_t value)
+            {
+                return static_cast<uint16_t>((value << 6) | (value >> 4));
+            }
+
+#if defined(TLRENDER_DPX_SSE2)
+            inline __m128i swap32(__m128i value)
+            {
+                value = _mm_or_si128(_mm_slli_epi16(value, 8), _mm_srli_epi16(value, 8));
+                value = _mm_shufflelo_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+                return _mm_shufflehi_epi16(value, _MM_SHUFFLE(2, 3, 0, 1));
+            }
+
+            inline __m128i to16(__m128i value)
+            {
+                return _mm_or_si128(_mm_slli_epi32(value, 6), _mm_srli_epi32(value, 4));
+            }
+#endif // TLRENDER_DPX_SSE2
+        }
+
+        void unpack10(
+            const uint8_t* in,
+            uint16_t* out,
+            size_t componentCount,
+            Packing packing,
+            bool swapEndian)
+        {
+            const int shift = Packing::FilledB == packing ? 0 : 2;
+            size_t i = 0;
+#if defined(TLRENDER_DPX_SSE2)
+            // Unpack four words (twelve components) at a time. Each word is
+            // expanded to a 64-bit lane holding three 16-bit components and
+            // stored with a six byte stride; the last two bytes of each
+            // store are overwritten by the next one, so the loop stops
+            // before the final word of the scanline.
+            const __m128i mask = _mm_set1_epi32(0x3ff);
+            const __m128i shift0 = _mm_cvtsi32_si128(20 + shift);
+            const __m128i shift1 = _mm_cvtsi32_si128(10 + shift);
+            const __m128i shift2 = _mm_cvtsi32_si128(shift);
+            for (; i + 12 < componentCount; i += 12, in += 16)
+            {
+                __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                if (swapEndian)
+                {
+                    w = swap32(w);
+                }
+                const __m128i c0 = to16(_mm_and_si128(_mm_srl_epi32(w, shift0), mask));
+                const __m128i c1 = to16(_mm_and_si128(_mm_srl_epi32(w, shift1), mask));
+                const __m128i c2 = to16(_mm_and_si128(_mm_srl_epi32(w, shift2), mask));
+                const __m128i c01 = _mm_or_si128(c0, _mm_slli_epi32(c1, 16));
+                const __m128i lo = _mm_unpacklo_epi32(c01, c2);
+                const __m128i hi = _mm_unpackhi_epi32(c01, c2);
+                uint8_t* o = reinterpret_cast<uint8_t*>(out + i);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(o), lo);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(o + 6), _mm_srli_si128(lo, 8));
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(o + 12), hi);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(o + 18), _mm_srli_si128(hi, 8));
+            }
+#endif // TLRENDER_DPX_SSE2
+            for (; i < componentCount; i += 3, in += 4)
+            {
+                const uint32_t w = getWord(in, swapEndian);
+                out[i] = to16((w >> (20 + shift)) & 0x3ff);
+                if (i + 1 < componentCount)
+                {
+                    out[i + 1] = to16((w >> (10 + shift)) & 0x3ff);
+                }
+                if (i + 2 < componentCount)
+                {
+                    out[i + 2] = to16((w >> shift) & 0x3ff);
+                }
+            }
+        }
+
+        void unpack10Packed(
+            const uint8_t* in,
+            uint16_t* out,
+            size_t componentCount,
+            bool swapEndian)
+        {
+            uint64_t bits = 0;
+            int bitCount = 0;
+            for (size_t i = 0; i < componentCount; ++i)
+            {
+                if (bitCount < 10)
+                {
+                    bits = (bits << 32) | getWord(in, swapEndian);
+                    in += 4;
+                    bitCount += 32;
+                }
+                bitCount -= 10;
+                out[i] = to16((bits >> bitCount) & 0x3ff);
+            }
+        }
+
+        void copy10(
+            const uint8_t* in,
+            uint8_t* out,
+            size_t pixelCount,
+            Packing packing,
+            bool swapEndian)
+        {
+            if (!swapEndian && Packing::FilledA == packing)
+            {
+                std::memcpy(out, in, pixelCount * sizeof(uint32_t));
+                return;
+            }
+            const int shift = Packing::FilledB == packing ? 2 : 0;
+            size_t i = 0;
+#if defined(TLRENDER_DPX_SSE2)
+            const __m128i shiftV = _mm_cvtsi32_si128(shift);
+            for (; i + 4 <= pixelCount; i += 4, in += 16, out += 16)
+            {
+                __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+                if (swapEndian)
+                {
+                    w = swap32(w);
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_sll_epi32(w, shiftV));
+            }
+#endif // TLRENDER_DPX_SSE2
+            for (; i < pixelCount; ++i, in += 4, out += 4)
+            {
+                const uint32_t w = getWord(in, swapEndian) << shift;
+                std::memcpy(out, &w, sizeof(uint32_t));
+            }
+        }
+
+        size_t Header::getScanlineByteCount() const
+        {
+            const size_t componentCount = size.w * channelCount;
+            size_t out = 0;
+            switch (bitDepth)
+            {
+            case 8:
+                out = componentCount;
+                break;
+            case 10:
+                out = Packing::Packed == packing ?
+                    ((componentCount * 10 + 31) / 32 * 4) :
+                    ((componentCount + 2) / 3 * 4);
+                break;
+            case 12:
+            case 16:
+                out = componentCount * 2;
+                break;
+            default: break;
+            }
+            return (out + 3) / 4 * 4 + eolPadding;
+        }
+
+        size_t Header::getDataByteCount() const
+        {
+            return getScanlineByteCount() * size.h;
+        }
+
+        namespace
+        {
+            const uint32_t undefined = 0xffffffff;
+
+            // Check that the image data fits in the file. The check is
+            // written so that a crafted header cannot make it wrap.
+            bool isDataInFile(size_t dataOffset, const Header& header, size_t size)
+            {
+                const size_t scanlineByteCount = header.getScanlineByteCount();
+                return
+                    dataOffset <= size &&
+                    (0 == scanlineByteCount ||
+                        static_cast<size_t>(header.size.h) <= (size - dataOffset) / scanlineByteCount);
+            }
+
+            uint32_t getU32(const uint8_t* p, ftk::Endian endian)
+            {
+                return ftk::Endian::MSB == endian ?
+                    ((static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) | (p[2] << 8) | p[3]) :
+                    ((static_cast<uint32_t>(p[3]) << 24) | (p[2] << 16) | (p[1] << 8) | p[0]);
+            }
+
+            uint16_t getU16(const uint8_t* p, ftk::Endian endian)
+            {
+                return ftk::Endian::MSB == endian ?
+                    ((p[0] << 8) | p[1]) :
+                    ((p[1] << 8) | p[0]);
+            }
+
+            float getF32(const uint8_t* p, ftk::Endian endian)
+            {
+                const uint32_t u = getU32(p, endian);
+                float out = 0.F;
+                std::memcpy(&out, &u, sizeof(float));
+                return out;
+            }
+
+            std::string getString(const uint8_t* p, size_t max)
+            {
+                size_t size = 0;
+                while (size < max && p[size] != 0 && p[size] != 0xff)
+                {
+                    ++size;
+                }
+                return std::string(reinterpret_cast<const char*>(p), size);
+            }
+
+            bool isValid(float value)
+            {
+                return std::isfinite(value) && value > 0.F;
+            }
+
+            std::string getTimecode(uint32_t value)
+            {
+                std::stringstream ss;
+                ss << std::setfill('0') <<
+                    std::setw(2) << (((value >> 28) & 0xf) * 10 + ((value >> 24) & 0xf)) << ":" <<
+                    std::setw(2) << (((value >> 20) & 0xf) * 10 + ((value >> 16) & 0xf)) << ":" <<
+                    std::setw(2) << (((value >> 12) & 0xf) * 10 + ((value >> 8) & 0xf)) << ":" <<
+                    std::setw(2) << (((value >> 4) & 0xf) * 10 + (value & 0xf));
+                return ss.str();
+            }
+
+            bool getFormat(const uint8_t* p, size_t size, Format& format, ftk::Endian& endian)
+            {
+                bool out = false;
+                if (size >= 4)
+                {
+                    if (0 == std::memcmp(p, "SDPX", 4))
+                    {
+                        format = Format::DPX;
+                        endian = ftk::Endian::MSB;
+                        out = true;
+                    }
+                    else if (0 == std::memcmp(p, "XPDS", 4))
+                    {
+                        format = Format::DPX;
+                        endian = ftk::Endian::LSB;
+                        out = true;
+                    }
+                    else if (0x802a5fd7 == getU32(p, ftk::Endian::MSB))
+                    {
+                        format = Format::Cineon;
+                        endian = ftk::Endian::MSB;
+                        out = true;
+                    }
+                    else if (0x802a5fd7 == getU32(p, ftk::Endian::LSB))
+                    {
+                        format = Format::Cineon;
+                        endian = ftk::Endian::LSB;
+                        out = true;
+                    }
+                }
+                return out;
+            }
+
+            void setOrientation(uint32_t value, Header& header)
+            {
+                header.mirrorX = 1 == value || 3 == value;
+                header.mirrorY = !(2 == value || 3 == value);
+            }
+        }
+
+        Header readHeader(const uint8_t* p, size_t size, const std::string& fileName)
+        {
+            Header out;
+            if (!getFormat(p, size, out.format, out.endian))
+            {
+                throw std::runtime_error(ftk::Format("Bad magic number: \"{0}\"").arg(fileName));
+            }
+            const ftk::Endian e = out.endian;
+            uint32_t packing = 0;
+            switch (out.format)
+            {
+            case Format::DPX:
+            {
+                if (size < 1664)
+                {
+                    throw std::runtime_error(ftk::Format("Incomplete file header: \"{0}\"").arg(fileName));
+                }
+                out.dataOffset = getU32(p + 4, e);
+                if (0 == getU16(p + 770, e))
+                {
+                    throw std::runtime_error(ftk::Format("No image elements: \"{0}\"").arg(fileName));
+                }
+                out.size.w = getU32(p + 772, e);
+                out.size.h = getU32(p + 776, e);
+                switch (p[800])
+                {
+                case 6: out.channelCount = 1; break;
+                case 50: out.channelCount = 3; break;
+                case 51: out.channelCount = 4; break;
+                default: break;
+                }
+                out.bitDepth = p[803];
+                packing = getU16(p + 804, e);
+                if (getU16(p + 806, e) != 0)
+                {
+                    throw std::runtime_error(ftk::Format("Unsupported encoding: \"{0}\"").arg(fileName));
+                }
+                const uint32_t elementOffset = getU32(p + 808, e);
+                if (elementOffset != undefined && elementOffset != 0)
+                {
+                    out.dataOffset = elementOffset;
+                }
+                const uint32_t eolPadding = getU32(p + 812, e);
+                out.eolPadding = eolPadding != undefined ? eolPadding : 0;
+                setOrientation(getU16(p + 768, e), out);
+
+                const uint32_t aspectH = getU32(p + 1628, e);
+                const uint32_t aspectV = getU32(p + 1632, e);
+                if (aspectH != undefined && aspectV != undefined && aspectH > 0 && aspectV > 0)
+                {
+                    out.pixelAspectRatio = aspectH / static_cast<float>(aspectV);
+                }
+
+                std::string s = getString(p + 160, 100);
+                if (!s.empty())
+                {
+                    out.tags["Creator"] = s;
+                }
+                s = getString(p + 260, 200);
+                if (!s.empty())
+                {
+                    out.tags["Project"] = s;
+                }
+                s = getString(p + 460, 200);
+                if (!s.empty())
+                {
+                    out.tags["Copyright"] = s;
+                }
+                s = getString(p + 136, 24);
+                if (!s.empty())
+                {
+                    out.tags["Creation Time"] = s;
+                }
+
+                if (size >= 2048 && out.dataOffset >= 2048)
+                {
+                    const float filmSpeed = getF32(p + 1724, e);
+                    const float tvSpeed = getF32(p + 1940, e);
+                    if (isValid(filmSpeed))
+                    {
+                        out.speed = filmSpeed;
+                    }
+                    else if (isValid(tvSpeed))
+                    {
+                        out.speed = tvSpeed;
+                    }
+                    const uint32_t timecode = getU32(p + 1920, e);
+                    if (timecode != undefined)
+                    {
+                        out.tags["Time Code"] = getTimecode(timecode);
+                    }
+                    s = getString(p + 1764, 100);
+                    if (!s.empty())
+                    {
+                        out.tags["Slate"] = s;
+                    }
+                }
+                switch (packing)
+                {
+                case 0: out.packing = Packing::Packed; break;
+                case 1: out.packing = Packing::FilledA; break;
+                case 2: out.packing = Packing::FilledB; break;
+                default:
+                    throw std::runtime_error(ftk::Format("Unsupported packing: \"{0}\"").arg(fileName));
+                }
+                break;
+            }
+            case Format::Cineon:
+            {
+                if (size < 712)
+                {
+                    throw std::runtime_error(ftk::Format("Incomplete file header: \"{0}\"").arg(fileName));
+                }
+                out.dataOffset = getU32(p + 4, e);
+                setOrientation(p[192], out);
+                switch (p[193])
+                {
+                case 1: out.channelCount = 1; break;
+                case 3: out.channelCount = 3; break;
+                default: break;
+                }
+                out.bitDepth = p[198];
+                out.size.w = getU32(p + 200, e);
+                out.size.h = getU32(p + 204, e);
+                packing = p[681];
+                const uint32_t eolPadding = getU32(p + 684, e);
+                out.eolPadding = eolPadding != undefined ? eolPadding : 0;
+                switch (packing)
+                {
+                case 0: out.packing = Packing::Packed; break;
+                case 5: out.packing = Packing::FilledA; break;
+                case 6: out.packing = Packing::FilledB; break;
+                default:
+                    if (out.bitDepth != 8 && out.bitDepth != 16)
+                    {
+                        throw std::runtime_error(ftk::Format("Unsupported packing: \"{0}\"").arg(fileName));
+                    }
+                    break;
+                }
+                break;
+            }
+            }
+
+            if (0 == out.channelCount)
+            {
+                throw std::runtime_error(ftk::Format("Unsupported channels: \"{0}\"").arg(fileName));
+            }
+            switch (out.bitDepth)
+            {
+            case 8:
+            case 10:
+            case 16:
+                break;
+            case 12:
+                if (Packing::Packed == out.packing)
+                {
+                    throw std::runtime_error(ftk::Format("Unsupported packing: \"{0}\"").arg(fileName));
+                }
+                break;
+            default:
+                throw std::runtime_error(ftk::Format("Unsupported bit depth: \"{0}\"").arg(fileName));
+            }
+            if (out.size.w <= 0 || out.size.h <= 0)
+            {
+                throw std::runtime_error(ftk::Format("Invalid image size: \"{0}\"").arg(fileName));
+            }
+            if (!isDataInFile(out.dataOffset, out, size))
+            {
+                throw std::runtime_error(ftk::Format("Incomplete file: \"{0}\"").arg(fileName));
+            }
+            return out;
+        }
+
+        size_t getDataOffset(
+            const uint8_t* p,
+            size_t size,
+            const Header& header,
+            const std::string& fileName)
+        {
+            Format format = Format::DPX;
+            ftk::Endian endian = ftk::Endian::MSB;
+            if (!getFormat(p, size, format, endian) ||
+                format != header.format ||
+                endian != header.endian ||
+                size < 8)
+            {
+                throw std::runtime_error(ftk::Format("Bad magic number: \"{0}\"").arg(fileName));
+            }
+            size_t out = getU32(p + 4, endian);
+            if (Format::DPX == format && size >= 812)
+            {
+                const uint32_t elementOffset = getU32(p + 808, endian);
+                if (elementOffset != undefined && elementOffset != 0)
+                {
+                    out = elementOffset;
+                }
+            }
+            if (!isDataInFile(out, header, size))
+            {
+                throw std::runtime_error(ftk::Format("Incomplete file: \"{0}\"").arg(fileName));
+            }
+            return out;
+        }
+
+        void ReadPlugin::_init(const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            IReadPlugin::_init(
+                "DPX",
+                {
+                    { ".dpx", io::FileType::Sequence },
+                    { ".cin", io::FileType::Sequence }
+                },
+                logSystem);
+        }
+
+        std::shared_ptr<ReadPlugin> ReadPlugin::create(
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<ReadPlugin>(new ReadPlugin);
+            out->_init(logSystem);
+            return out;
+        }
+
+        std::shared_ptr<io::IRead> ReadPlugin::read(
+            const file::Path& path,
+            const io::Options& options)
+        {
+            return Read::create(path, options, _logSystem.lock());
+        }
+
+        std::shared_ptr<io::IRead> ReadPlugin::read(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options)
+        {
+            return Read::create(path, memory, options, _logSystem.lock());
+        }
+    }
+}
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlIO/SequenceIO.h>
+
+namespace tl
+{
+    //! DPX and Cineon image I/O.
+    namespace dpx
+    {
+        //! 10-bit component packing.
+        enum class Packing
+        {
+            Packed,  //!< Components are streamed across 32-bit words
+            FilledA, //!< Three components per 32-bit word, padding in the low bits
+            FilledB, //!< Three components per 32-bit word, padding in the high bits
+
+            Count,
+            First = Packed
+        };
+        FTK_ENUM(Packing);
+
+        //! Unpack 10-bit filled data to 16-bit components. The input is
+        //! read as 32-bit words, three components per word.
+        void unpack10(
+            const uint8_t*,
+            uint16_t*,
+            size_t componentCount,
+            Packing,
+            bool swapEndian);
+
+        //! Unpack 10-bit packed data to 16-bit components.
+        void unpack10Packed(
+            const uint8_t*,
+            uint16_t*,
+            size_t componentCount,
+            bool swapEndian);
+
+        //! Copy 10-bit filled RGB data to the native ftk::ImageType::RGB_U10
+        //! layout, leaving the unpacking to the GPU.
+        void copy10(
+            const uint8_t*,
+            uint8_t*,
+            size_t pixelCount,
+            Packing,
+            bool swapEndian);
+
+        //! DPX and Cineon reader.
+        //!
+        //! Options:
+        //! - "DPX/Passthrough": Return 10-bit RGB data as
+        //!   ftk::ImageType::RGB_U10 instead of unpacking it to
+        //!   ftk::ImageType::RGB_U16.
+        class Read : public io::ISequenceRead
+        {
+        protected:
+            void _init(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            Read();
+
+        public:
+            virtual ~Read();
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+        protected:
+            io::Info _getInfo(
+                const std::string& fileName,
+                const ftk::InMemoryFile*) override;
+            io::VideoData _readVideo(
+                const std::string& fileName,
+                const ftk::InMemoryFile*,
+                const OTIO_NS::RationalTime&,
+                const io::Options&) override;
+
+        private:
+            FTK_PRIVATE();
+        };
+
+        //! DPX and Cineon read plugin.
+        class ReadPlugin : public io::IReadPlugin
+        {
+        protected:
+            void _init(const std::shared_ptr<ftk::LogSystem>&);
+
+            ReadPlugin() = default;
+
+        public:
+            //! Create a new plugin.
+            static std::shared_ptr<ReadPlugin> create(
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const io::Options& = io::Options()) override;
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options& = io::Options()) override;
+        };
+    }
+}
@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlIO/DPX.h>
+
+#include <ftk/Core/Memory.h>
+
+namespace tl
+{
+    namespace dpx
+    {
+        //! File formats.
+        enum class Format
+        {
+            DPX,
+            Cineon
+        };
+
+        //! File header. Only the fields needed to decode the image data are
+        //! kept, the remaining metadata is converted to tags.
+        struct Header
+        {
+            Format format = Format::DPX;
+            ftk::Endian endian = ftk::Endian::MSB;
+            ftk::Size2I size;
+            size_t channelCount = 0;
+            size_t bitDepth = 0;
+            Packing packing = Packing::Packed;
+            size_t dataOffset = 0;
+            size_t eolPadding = 0;
+            bool mirrorX = false;
+            bool mirrorY = true;
+            float pixelAspectRatio = 1.F;
+            float speed = 0.F;
+            ftk::ImageTags tags;
+
+            //! Get the size of a scanline in bytes, including padding.
+            size_t getScanlineByteCount() const;
+
+            //! Get the size of the image data in bytes.
+            size_t getDataByteCount() const;
+        };
+
+        //! Read a file header.
+        Header readHeader(const uint8_t*, size_t, const std::string& fileName);
+
+        //! Get the image data offset from a file header. This is used when
+        //! reading the frames of a sequence, where the rest of the header is
+        //! assumed to be the same as the first frame.
+        size_t getDataOffset(const uint8_t*, size_t, const Header&, const std::string& fileName);
+    }
+}
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/DPXPrivate.h>
+#include <tlIO/FileDataPrivate.h>
+
+#include <ftk/Core/Format.h>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace tl
+{
+    namespace dpx
+    {
+        struct Read::Private
+        {
+            Header header;
+        };
+
+        void Read::_init(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            ISequenceRead::_init(path, memory, options, logSystem);
+        }
+
+        Read::Read() :
+            _p(new Private)
+        {}
+
+        Read::~Read()
+        {
+            _finish();
+        }
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, {}, options, logSystem);
+            return out;
+        }
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, memory, options, logSystem);
+            return out;
+        }
+
+        namespace
+        {
+            bool isPassthrough(const Header& header, const io::Options& options)
+            {
+                bool out = false;
+                const auto i = options.find("DPX/Passthrough");
+                if (i != options.end())
+                {
+                    out =
+                        std::atoi(i->second.c_str()) != 0 &&
+                        10 == header.bitDepth &&
+                        3 == header.channelCount &&
+                        header.packing != Packing::Packed;
+                }
+                return out;
+            }
+
+            ftk::ImageInfo getImageInfo(const Header& header, const io::Options& options)
+            {
+                ftk::ImageInfo out(
+                    header.size,
+                    isPassthrough(header, options) ?
+                    ftk::ImageType::RGB_U10 :
+                    io::getIntType(header.channelCount, 8 == header.bitDepth ? 8 : 16));
+                out.pixelAspectRatio = header.pixelAspectRatio;
+                out.layout.mirror.x = header.mirrorX;
+                out.layout.mirror.y = header.mirrorY;
+                return out;
+            }
+        }
+
+        io::Info Read::_getInfo(
+            const std::string& fileName,
+            const ftk::InMemoryFile* memory)
+        {
+            FTK_P();
+            const io::FileData data(fileName, memory);
+            p.header = readHeader(data.p, data.size, fileName);
+
+            io::Info out;
+            out.video.push_back(getImageInfo(p.header, _options));
+            out.tags = p.header.tags;
+            const float speed = p.header.speed > 0.F ? p.header.speed : _defaultSpeed;
+            out.videoTime = OTIO_NS::TimeRange::range_from_start_end_time_inclusive(
+                OTIO_NS::RationalTime(_startFrame, speed),
+                OTIO_NS::RationalTime(_endFrame, speed));
+            return out;
+        }
+
+        io::VideoData Read::_readVideo(
+            const std::string& fileName,
+            const ftk::InMemoryFile* memory,
+            const OTIO_NS::RationalTime& time,
+            const io::Options& options)
+        {
+            FTK_P();
+            const Header& header = p.header;
+            const io::FileData data(fileName, memory);
+            const size_t dataOffset = getDataOffset(data.p, data.size, header, fileName);
+
+            io::VideoData out;
+            out.time = time;
+            const ftk::ImageInfo imageInfo = getImageInfo(header, options);
+            out.image = ftk::Image::create(imageInfo);
+            out.image->setTags(header.tags);
+
+            const size_t scanlineByteCount = header.getScanlineByteCount();
+            const size_t componentCount = header.size.w * header.channelCount;
+            const bool swapEndian = header.endian != ftk::getEndian();
+            const uint8_t* in = data.p + dataOffset;
+            uint8_t* outP = out.image->getData();
+            for (int y = 0; y < header.size.h; ++y, in += scanlineByteCount)
+            {
+                switch (header.bitDepth)
+                {
+                case 8:
+                    std::memcpy(outP + y * componentCount, in, componentCount);
+                    break;
+                case 10:
+                    if (ftk::ImageType::RGB_U10 == imageInfo.type)
+                    {
+                        copy10(
+                            in,
+                            outP + y * header.size.w * sizeof(uint32_t),
+                            header.size.w,
+                            header.packing,
+                            swapEndian);
+                    }
+                    else if (Packing::Packed == header.packing)
+                    {
+                        unpack10Packed(
+                            in,
+                            reinterpret_cast<uint16_t*>(outP) + y * componentCount,
+                            componentCount,
+                            swapEndian);
+                    }
+                    else
+                    {
+                        unpack10(
+                            in,
+                            reinterpret_cast<uint16_t*>(outP) + y * componentCount,
+                            componentCount,
+                            header.packing,
+                            swapEndian);
+                    }
+                    break;
+                case 12:
+                case 16:
+                {
+                    // The data offset may be odd, so the samples are
+                    // copied instead of read through a uint16_t pointer.
+                    uint16_t* out16 = reinterpret_cast<uint16_t*>(outP) + y * componentCount;
+                    for (size_t i = 0; i < componentCount; ++i)
+                    {
+                        uint16_t v = 0;
+                        std::memcpy(&v, in + i * sizeof(uint16_t), sizeof(uint16_t));
+                        if (swapEndian)
+                        {
+                            v = (v << 8) | (v >> 8);
+                        }
+                        if (12 == header.bitDepth)
+                        {
+                            v = Packing::FilledB == header.packing ?
+                                ((v << 4) | ((v >> 8) & 0xf)) :
+                                (v | (v >> 12));
+                        }
+                        out16[i] = v;
+                    }
+                    break;
+                }
+                default: break;
+                }
+            }
+            return out;
+        }
+    }
+}
@@ -0,0 +1,819 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/DiskCache.h>
+
+#include <tlIO/Compress.h>
+#include <tlIO/FrameCachePrivate.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/FileIO.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/Memory.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+namespace tl
+{
+    namespace io
+    {
+        namespace
+        {
+            //! File magic number.
+            const char magic[4] = { 'T', 'L', 'D', 'C' };
+
+            //! File format version.
+            const uint32_t version = 1;
+
+            const std::string extension = ".tldc";
+            const std::string tmpExtension = ".tmp";
+
+            //! Maximum number of frames waiting to be written. Frames are
+            //! dropped when the queue is full so the players are never
+            //! blocked by the disk.
+            const size_t writeQueueMax = 16;
+
+            //! Number of threads for reading frames.
+            const size_t readThreadCount = 2;
+
+            //! Maximum number of frames waiting to be read. Frames are
+            //! decoded instead when the queue is full.
+            const size_t readQueueMax = 16;
+
+            //! How often the media files are checked for changes.
+            const std::chrono::milliseconds mediaKeyTimeout(1000);
+
+            //! Smoothing for the read and decode time measurements.
+            const float timeSmoothing = .1F;
+
+            //! When decoding is faster, every Nth frame is still read from
+            //! the cache so the measurements are kept up to date.
+            const size_t readProbe = 32;
+
+            //! File header. The header is followed by the frame key, the
+            //! image tags, and the image data.
+            struct Header
+            {
+                char     magic[4]         = { 0, 0, 0, 0 };
+                uint32_t version          = 0;
+                uint32_t keyByteCount     = 0;
+                uint32_t imageType        = 0;
+                uint32_t width            = 0;
+                uint32_t height           = 0;
+                uint32_t alignment        = 1;
+                uint32_t mirrorX          = 0;
+                uint32_t mirrorY          = 0;
+                uint32_t videoLevels      = 0;
+                uint32_t yuvCoefficients  = 0;
+                float    pixelAspectRatio = 1.F;
+                uint32_t compressed       = 0;
+                uint32_t layer            = 0;
+                uint64_t tagsByteCount    = 0;
+                uint64_t dataByteCount    = 0;
+            };
+
+            // FNV-1a hash of the frame key, used for the file name.
+            std::string getFileName(const std::string& frameKey)
+            {
+                uint64_t hash = 14695981039346656037ULL;
+                for (const char c : frameKey)
+                {
+                    hash ^= static_cast<uint8_t>(c);
+                    hash *= 1099511628211ULL;
+                }
+                std::stringstream ss;
+                ss << std::hex << std::setfill('0') << std::setw(16) << hash << extension;
+                return ss.str();
+            }
+
+            void smooth(float& value, float sample)
+            {
+                value = value > 0.F ?
+                    (value + (sample - value) * timeSmoothing) :
+                    sample;
+            }
+        }
+
+        bool DiskCacheOptions::operator == (const DiskCacheOptions& other) const
+        {
+            return
+                path == other.path &&
+                gb == other.gb;
+        }
+
+        bool DiskCacheOptions::operator != (const DiskCacheOptions& other) const
+        {
+            return !(*this == other);
+        }
+
+        struct DiskCacheSystem::Private
+        {
+            struct Entry
+            {
+                size_t byteCount = 0;
+                std::list<std::string>::iterator lru;
+            };
+
+            struct Stats
+            {
+                float decodeTime = 0.F;
+                float readTime = 0.F;
+                size_t probe = 0;
+            };
+
+            struct MediaKey
+            {
+                std::string key;
+                std::chrono::steady_clock::time_point time;
+            };
+
+            struct WriteItem
+            {
+                std::string fileName;
+                std::string frameKey;
+                VideoData videoData;
+            };
+
+            struct ReadItem
+            {
+                std::string mediaKey;
+                std::string frameKey;
+                OTIO_NS::RationalTime time = time::invalidTime;
+                std::promise<VideoData> promise;
+            };
+
+            struct Mutex
+            {
+                DiskCacheOptions options;
+                std::filesystem::path dir;
+
+                //! The most recently used files are at the front.
+                std::list<std::string> lru;
+                std::unordered_map<std::string, Entry> entries;
+                size_t byteCount = 0;
+
+                std::map<std::string, Stats> stats;
+                std::map<std::string, MediaKey> mediaKeys;
+
+                std::list<WriteItem> writes;
+                std::set<std::string> pending;
+                std::list<std::shared_ptr<ReadItem> > reads;
+                bool writing = false;
+                bool running = true;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+            std::condition_variable cv;
+            std::condition_variable waitCV;
+            std::thread thread;
+            std::condition_variable readCV;
+            std::vector<std::thread> readThreads;
+        };
+
+        DiskCacheSystem::DiskCacheSystem(const std::shared_ptr<ftk::Context>& context) :
+            ISystem(context, "tl::io::DiskCacheSystem"),
+            _p(new Private)
+        {
+            FTK_P();
+            p.thread = std::thread(
+                [this]
+                {
+                    _run();
+                });
+            for (size_t i = 0; i < readThreadCount; ++i)
+            {
+                p.readThreads.push_back(std::thread(
+                    [this]
+                    {
+                        _runRead();
+                    }));
+            }
+        }
+
+        DiskCacheSystem::~DiskCacheSystem()
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.running = false;
+            }
+            p.cv.notify_one();
+            p.readCV.notify_all();
+            if (p.thread.joinable())
+            {
+                p.thread.join();
+            }
+            for (auto& thread : p.readThreads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+            for (auto& item : p.mutex.reads)
+            {
+                VideoData videoData;
+                videoData.time = item->time;
+                item->promise.set_value(videoData);
+            }
+        }
+
+        std::shared_ptr<DiskCacheSystem> DiskCacheSystem::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            auto out = context->getSystem<DiskCacheSystem>();
+            if (!out)
+            {
+                out = std::shared_ptr<DiskCacheSystem>(new DiskCacheSystem(context));
+                context->addSystem(out);
+            }
+            return out;
+        }
+
+        DiskCacheOptions DiskCacheSystem::getOptions() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.options;
+        }
+
+        void DiskCacheSystem::setOptions(const DiskCacheOptions& value)
+        {
+            FTK_P();
+            std::vector<std::filesystem::path> remove;
+            std::string error;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (value == p.mutex.options)
+                    return;
+                p.mutex.options = value;
+                p.mutex.dir.clear();
+                p.mutex.lru.clear();
+                p.mutex.entries.clear();
+                p.mutex.byteCount = 0;
+                p.mutex.mediaKeys.clear();
+                p.mutex.writes.clear();
+                p.mutex.pending.clear();
+
+                if (!value.path.empty() && value.gb > 0.F)
+                {
+                    const std::filesystem::path dir = std::filesystem::u8path(value.path);
+                    std::error_code ec;
+                    std::filesystem::create_directories(dir, ec);
+                    if (std::filesystem::is_directory(dir, ec))
+                    {
+                        p.mutex.dir = dir;
+
+                        // Add the files from previous sessions, the least
+                        // recently used first.
+                        std::vector<std::tuple<std::filesystem::file_time_type, std::string, size_t> > found;
+                        for (const auto& i : std::filesystem::directory_iterator(dir, ec))
+                        {
+                            const std::filesystem::path& path = i.path();
+                            const std::string ext = path.extension().u8string();
+                            if (tmpExtension == ext)
+                            {
+                                remove.push_back(path);
+                            }
+                            else if (extension == ext && i.is_regular_file(ec))
+                            {
+                                found.push_back(std::make_tuple(
+                                    i.last_write_time(ec),
+                                    path.filename().u8string(),
+                                    static_cast<size_t>(i.file_size(ec))));
+                            }
+                        }
+                        std::sort(found.begin(), found.end());
+                        for (const auto& i : found)
+                        {
+                            p.mutex.lru.push_front(std::get<1>(i));
+                            Private::Entry entry;
+                            entry.byteCount = std::get<2>(i);
+                            entry.lru = p.mutex.lru.begin();
+                            p.mutex.entries[std::get<1>(i)] = entry;
+                            p.mutex.byteCount += entry.byteCount;
+                        }
+                        _trim(remove);
+                    }
+                    else
+                    {
+                        error = ec.message();
+                    }
+                }
+            }
+            if (!error.empty())
+            {
+                _log(
+                    ftk::Format("Cannot create the disk cache directory: \"{0}\": {1}").
+                        arg(value.path).
+                        arg(error),
+                    ftk::LogType::Error);
+            }
+            else if (!value.path.empty() && value.gb > 0.F)
+            {
+                _log(ftk::Format("Disk cache: \"{0}\" ({1}GB, {2} frames)").
+                    arg(value.path).
+                    arg(value.gb).
+                    arg(getSize()));
+            }
+            _remove(remove);
+        }
+
+        std::string DiskCacheSystem::getMediaKey(const file::Path& path)
+        {
+            FTK_P();
+            std::string out;
+            const std::string fileName = path.get();
+            if (fileName.empty() || path.isSequence())
+                return out;
+
+            const auto now = std::chrono::steady_clock::now();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (p.mutex.dir.empty())
+                    return out;
+                const auto i = p.mutex.mediaKeys.find(fileName);
+                if (i != p.mutex.mediaKeys.end() && now - i->second.time < mediaKeyTimeout)
+                {
+                    return i->second.key;
+                }
+            }
+
+            // The key includes the modification time and size so that the
+            // frames are not used when the file changes.
+            std::error_code ec;
+            const std::filesystem::path fsPath = std::filesystem::u8path(fileName);
+            if (std::filesystem::is_regular_file(fsPath, ec))
+            {
+                const auto mtime = std::filesystem::last_write_time(fsPath, ec);
+                const auto size = std::filesystem::file_size(fsPath, ec);
+                if (!ec)
+                {
+                    std::stringstream ss;
+                    ss << fileName << "|" << mtime.time_since_epoch().count() << "|" << size;
+                    out = ss.str();
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            Private::MediaKey mediaKey;
+            mediaKey.key = out;
+            mediaKey.time = now;
+            p.mutex.mediaKeys[fileName] = mediaKey;
+            return out;
+        }
+
+        std::string DiskCacheSystem::getFrameKey(
+            const std::string& mediaKey,
+            const OTIO_NS::RationalTime& time,
+            const Options& options)
+        {
+            std::stringstream ss;
+            ss << std::setprecision(std::numeric_limits<double>::max_digits10);
+            ss << mediaKey << "|" << time.value() << "/" << time.rate();
+            for (const auto& i : options)
+            {
+                ss << "|" << i.first << "=" << i.second;
+            }
+            return ss.str();
+        }
+
+        bool DiskCacheSystem::canRead(
+            const std::string& mediaKey,
+            const std::string& frameKey)
+        {
+            FTK_P();
+            bool out = false;
+            const std::string fileName = getFileName(frameKey);
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            if (p.mutex.entries.find(fileName) != p.mutex.entries.end() &&
+                p.mutex.reads.size() < readQueueMax)
+            {
+                // Read the frame until there are measurements for both
+                // reading and decoding.
+                auto& stats = p.mutex.stats[mediaKey];
+                out =
+                    stats.readTime <= 0.F ||
+                    stats.decodeTime <= 0.F ||
+                    stats.readTime <= stats.decodeTime ||
+                    0 == ++stats.probe % readProbe;
+            }
+            return out;
+        }
+
+        bool DiskCacheSystem::read(
+            const std::string& mediaKey,
+            const std::string& frameKey,
+            const OTIO_NS::RationalTime& time,
+            VideoData& out)
+        {
+            FTK_P();
+            const std::string fileName = getFileName(frameKey);
+            std::filesystem::path path;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (p.mutex.dir.empty() ||
+                    p.mutex.entries.find(fileName) == p.mutex.entries.end())
+                {
+                    return false;
+                }
+                path = p.mutex.dir / fileName;
+            }
+
+            bool valid = false;
+            const auto t0 = std::chrono::steady_clock::now();
+            try
+            {
+                auto fileIO = ftk::FileIO::create(path.u8string(), ftk::FileMode::Read);
+                const uint64_t fileSize = fileIO->getSize();
+                Header header;
+                fileIO->read(&header, sizeof(Header));
+
+                // Check the sizes against the file size before allocating
+                // memory, in case the file is truncated or corrupt.
+                if (0 == std::memcmp(header.magic, magic, sizeof(magic)) &&
+                    version == header.version &&
+                    fileSize >= sizeof(Header) &&
+                    header.tagsByteCount <= fileSize &&
+                    header.dataByteCount <= fileSize &&
+                    sizeof(Header) +
+                    static_cast<uint64_t>(header.keyByteCount) +
+                    header.tagsByteCount +
+                    header.dataByteCount == fileSize)
+                {
+                    // Check the key in case of a hash collision.
+                    std::string key(header.keyByteCount, 0);
+                    fileIO->read(key.data(), key.size());
+                    if (key == frameKey)
+                    {
+                        std::vector<uint8_t> tags(header.tagsByteCount);
+                        fileIO->read(tags.data(), tags.size());
+
+                        CompressedImage compressed;
+                        compressed.info = ftk::ImageInfo(
+                            ftk::Size2I(header.width, header.height),
+                            static_cast<ftk::ImageType>(header.imageType));
+                        compressed.info.layout.alignment = header.alignment;
+                        compressed.info.layout.mirror.x = header.mirrorX;
+                        compressed.info.layout.mirror.y = header.mirrorY;
+                        compressed.info.videoLevels = static_cast<ftk::VideoLevels>(header.videoLevels);
+                        compressed.info.yuvCoefficients = static_cast<ftk::YUVCoefficients>(header.yuvCoefficients);
+                        compressed.info.pixelAspectRatio = header.pixelAspectRatio;
+                        compressed.tags = framecache::readTags(tags.data(), tags.size());
+                        compressed.compressed = header.compressed != 0;
+                        compressed.data.resize(header.dataByteCount);
+                        fileIO->read(compressed.data.data(), compressed.data.size());
+
+                        out = VideoData(
+                            time,
+                            static_cast<uint16_t>(header.layer),
+                            decompressImage(compressed));
+                        valid = true;
+                    }
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _log(
+                    ftk::Format("Cannot read the disk cache: \"{0}\": {1}").
+                        arg(path.u8string()).
+                        arg(e.what()),
+                    ftk::LogType::Error);
+            }
+            const std::chrono::duration<float> diff = std::chrono::steady_clock::now() - t0;
+
+            std::vector<std::filesystem::path> remove;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                const auto i = p.mutex.entries.find(fileName);
+                if (i != p.mutex.entries.end())
+                {
+                    if (valid)
+                    {
+                        p.mutex.lru.splice(p.mutex.lru.begin(), p.mutex.lru, i->second.lru);
+                    }
+                    else
+                    {
+                        p.mutex.byteCount -= i->second.byteCount;
+                        p.mutex.lru.erase(i->second.lru);
+                        p.mutex.entries.erase(i);
+                        remove.push_back(path);
+                    }
+                }
+                if (valid)
+                {
+                    smooth(p.mutex.stats[mediaKey].readTime, diff.count());
+                }
+            }
+            if (valid)
+            {
+                // Update the modification time so the order of the least
+                // recently used frames is kept between sessions.
+                std::error_code ec;
+                std::filesystem::last_write_time(
+                    path,
+                    std::filesystem::file_time_type::clock::now(),
+                    ec);
+            }
+            _remove(remove);
+            return valid;
+        }
+
+        std::future<VideoData> DiskCacheSystem::readRequest(
+            const std::string& mediaKey,
+            const std::string& frameKey,
+            const OTIO_NS::RationalTime& time)
+        {
+            FTK_P();
+            auto item = std::make_shared<Private::ReadItem>();
+            item->mediaKey = mediaKey;
+            item->frameKey = frameKey;
+            item->time = time;
+            auto future = item->promise.get_future();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.reads.push_back(item);
+            }
+            p.readCV.notify_one();
+            return future;
+        }
+
+        void DiskCacheSystem::write(
+            const std::string& mediaKey,
+            const std::string& frameKey,
+            const VideoData& videoData)
+        {
+            FTK_P();
+            if (!videoData.image)
+                return;
+            const std::string fileName = getFileName(frameKey);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (p.mutex.dir.empty() ||
+                    p.mutex.entries.find(fileName) != p.mutex.entries.end() ||
+                    p.mutex.pending.find(fileName) != p.mutex.pending.end() ||
+                    p.mutex.writes.size() >= writeQueueMax)
+                {
+                    return;
+                }
+                const auto i = p.mutex.stats.find(mediaKey);
+                if (i != p.mutex.stats.end() &&
+                    i->second.readTime > 0.F &&
+                    i->second.decodeTime > 0.F &&
+                    i->second.readTime > i->second.decodeTime)
+                {
+                    return;
+                }
+                Private::WriteItem item;
+                item.fileName = fileName;
+                item.frameKey = frameKey;
+                item.videoData = videoData;
+                p.mutex.writes.push_back(item);
+                p.mutex.pending.insert(fileName);
+            }
+            p.cv.notify_one();
+        }
+
+        void DiskCacheSystem::addDecodeTime(const std::string& mediaKey, float seconds)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            smooth(p.mutex.stats[mediaKey].decodeTime, seconds);
+        }
+
+        size_t DiskCacheSystem::getSize() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.entries.size();
+        }
+
+        size_t DiskCacheSystem::getByteCount() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.byteCount;
+        }
+
+        void DiskCacheSystem::wait()
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.waitCV.wait(
+                lock,
+                [this]
+                {
+                    return _p->mutex.writes.empty() && !_p->mutex.writing;
+                });
+        }
+
+        void DiskCacheSystem::clear()
+        {
+            FTK_P();
+            std::vector<std::filesystem::path> remove;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                for (const auto& i : p.mutex.entries)
+                {
+                    remove.push_back(p.mutex.dir / i.first);
+                }
+                p.mutex.lru.clear();
+                p.mutex.entries.clear();
+                p.mutex.byteCount = 0;
+                p.mutex.stats.clear();
+                p.mutex.writes.clear();
+                p.mutex.pending.clear();
+            }
+            _remove(remove);
+        }
+
+        void DiskCacheSystem::_run()
+        {
+            FTK_P();
+            while (true)
+            {
+                Private::WriteItem item;
+                std::filesystem::path dir;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.cv.wait(
+                        lock,
+                        [this]
+                        {
+                            return !_p->mutex.writes.empty() || !_p->mutex.running;
+                        });
+                    if (!p.mutex.running)
+                        break;
+                    item = std::move(p.mutex.writes.front());
+                    p.mutex.writes.pop_front();
+                    p.mutex.writing = true;
+                    dir = p.mutex.dir;
+                }
+
+                // Write to a temporary file and rename it when finished, so
+                // the cache never has partial files.
+                const std::filesystem::path path = dir / item.fileName;
+                std::filesystem::path tmpPath = path;
+                tmpPath += tmpExtension;
+                size_t byteCount = 0;
+                try
+                {
+                    const CompressedImage compressed = compressImage(item.videoData.image);
+                    const std::vector<uint8_t> tags = framecache::writeTags(compressed.tags);
+
+                    Header header;
+                    std::memcpy(header.magic, magic, sizeof(magic));
+                    header.version = version;
+                    header.keyByteCount = item.frameKey.size();
+                    header.imageType = static_cast<uint32_t>(compressed.info.type);
+                    header.width = compressed.info.size.w;
+                    header.height = compressed.info.size.h;
+                    header.alignment = compressed.info.layout.alignment;
+                    header.mirrorX = compressed.info.layout.mirror.x;
+                    header.mirrorY = compressed.info.layout.mirror.y;
+                    header.videoLevels = static_cast<uint32_t>(compressed.info.videoLevels);
+                    header.yuvCoefficients = static_cast<uint32_t>(compressed.info.yuvCoefficients);
+                    header.pixelAspectRatio = compressed.info.pixelAspectRatio;
+                    header.compressed = compressed.compressed;
+                    header.layer = item.videoData.layer;
+                    header.tagsByteCount = tags.size();
+                    header.dataByteCount = compressed.data.size();
+                    {
+                        auto fileIO = ftk::FileIO::create(tmpPath.u8string(), ftk::FileMode::Write);
+                        fileIO->write(&header, sizeof(Header));
+                        fileIO->write(item.frameKey.data(), item.frameKey.size());
+                        fileIO->write(tags.data(), tags.size());
+                        fileIO->write(compressed.data.data(), compressed.data.size());
+                    }
+                    std::filesystem::rename(tmpPath, path);
+                    byteCount =
+                        sizeof(Header) +
+                        item.frameKey.size() +
+                        tags.size() +
+                        compressed.data.size();
+                }
+                catch (const std::exception& e)
+                {
+                    _log(
+                        ftk::Format("Cannot write the disk cache: \"{0}\": {1}").
+                            arg(path.u8string()).
+                            arg(e.what()),
+                        ftk::LogType::Error);
+                    std::error_code ec;
+                    std::filesystem::remove(tmpPath, ec);
+                }
+
+                std::vector<std::filesystem::path> remove;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.pending.erase(item.fileName);
+                    if (byteCount > 0)
+                    {
+                        if (dir == p.mutex.dir)
+                        {
+                            p.mutex.lru.push_front(item.fileName);
+                            Private::Entry entry;
+                            entry.byteCount = byteCount;
+                            entry.lru = p.mutex.lru.begin();
+                            p.mutex.entries[item.fileName] = entry;
+                            p.mutex.byteCount += byteCount;
+                            _trim(remove);
+                        }
+                        else
+                        {
+                            // The options were changed while writing.
+                            remove.push_back(path);
+                        }
+                    }
+                    p.mutex.writing = false;
+                }
+                p.waitCV.notify_all();
+                _remove(remove);
+            }
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.writing = false;
+            }
+            p.waitCV.notify_all();
+        }
+
+        void DiskCacheSystem::_runRead()
+        {
+            FTK_P();
+            while (true)
+            {
+                std::shared_ptr<Private::ReadItem> item;
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.readCV.wait(
+                        lock,
+                        [this]
+                        {
+                            return !_p->mutex.reads.empty() || !_p->mutex.running;
+                        });
+                    if (!p.mutex.running)
+                        break;
+                    item = p.mutex.reads.front();
+                    p.mutex.reads.pop_front();
+                }
+                VideoData videoData;
+                if (!read(item->mediaKey, item->frameKey, item->time, videoData))
+                {
+                    videoData = VideoData();
+                }
+                videoData.time = item->time;
+                item->promise.set_value(videoData);
+            }
+        }
+
+        void DiskCacheSystem::_trim(std::vector<std::filesystem::path>& remove)
+        {
+            FTK_P();
+            const size_t byteMax = p.mutex.options.gb * ftk::gigabyte;
+            while (p.mutex.byteCount > byteMax && !p.mutex.lru.empty())
+            {
+                const std::string fileName = p.mutex.lru.back();
+                const auto i = p.mutex.entries.find(fileName);
+                if (i != p.mutex.entries.end())
+                {
+                    p.mutex.byteCount -= i->second.byteCount;
+                    p.mutex.entries.erase(i);
+                }
+                p.mutex.lru.pop_back();
+                remove.push_back(p.mutex.dir / fileName);
+            }
+        }
+
+        void DiskCacheSystem::_remove(const std::vector<std::filesystem::path>& paths)
+        {
+            for (const auto& path : paths)
+            {
+                std::error_code ec;
+                std::filesystem::remove(path, ec);
+            }
+        }
+
+        void to_json(nlohmann::json& json, const DiskCacheOptions& value)
+        {
+            json["Path"] = value.path;
+            json["GB"] = value.gb;
+        }
+
+        void from_json(const nlohmann::json& json, DiskCacheOptions& value)
+        {
+            json.at("Path").get_to(value.path);
+            json.at("GB").get_to(value.gb);
+        }
+    }
+}
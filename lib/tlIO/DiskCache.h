@@ -0,0 +1,144 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlIO/IO.h>
+
+#include <tlCore/ISystem.h>
+#include <tlCore/Path.h>
+
+#include <nlohmann/json.hpp>
+
+#include <filesystem>
+#include <future>
+
+namespace tl
+{
+    namespace io
+    {
+        //! Disk cache options.
+        struct DiskCacheOptions
+        {
+            //! Cache directory. The directory is created if it does not
+            //! exist.
+            std::string path;
+
+            //! Maximum size of the cache in gigabytes. Zero disables the
+            //! disk cache.
+            float gb = 0.F;
+
+            bool operator == (const DiskCacheOptions&) const;
+            bool operator != (const DiskCacheOptions&) const;
+        };
+
+        //! Disk cache system.
+        //!
+        //! The disk cache keeps decoded video frames, losslessly compressed,
+        //! in a local directory so that they do not need to be decoded
+        //! again, for example when the same movie is reviewed several times
+        //! a day. The frames are keyed by the media path, modification time,
+        //! and size, the frame time, and the I/O options. The cache persists
+        //! between sessions, and the least recently used frames are removed
+        //! when the cache is larger than the maximum size.
+        //!
+        //! The frames are written on a separate thread, and read by a
+        //! fixed number of threads. Frames are only read from the cache
+        //! when that is faster than decoding them, which is measured for
+        //! each media file.
+        class DiskCacheSystem : public system::ISystem
+        {
+            FTK_NON_COPYABLE(DiskCacheSystem);
+
+        protected:
+            DiskCacheSystem(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            virtual ~DiskCacheSystem();
+
+            //! Create a new system.
+            static std::shared_ptr<DiskCacheSystem> create(const std::shared_ptr<ftk::Context>&);
+
+            //! Get the options.
+            DiskCacheOptions getOptions() const;
+
+            //! Set the options. The frames already in the cache directory
+            //! are added to the cache.
+            void setOptions(const DiskCacheOptions&);
+
+            //! Get the key for a media file. The key is empty if the disk
+            //! cache is disabled or the path is not a file on disk. Image
+            //! sequences are not cached since each frame is a separate file.
+            std::string getMediaKey(const file::Path&);
+
+            //! Get the key for a frame.
+            static std::string getFrameKey(
+                const std::string& mediaKey,
+                const OTIO_NS::RationalTime&,
+                const Options&);
+
+            //! Get whether a frame should be read from the cache. This is
+            //! false if the frame is not in the cache, if decoding the
+            //! media is faster than reading the cache, or if too many
+            //! reads are waiting.
+            bool canRead(
+                const std::string& mediaKey,
+                const std::string& frameKey);
+
+            //! Read a frame. Returns false if the frame cannot be read. This
+            //! function is thread safe.
+            bool read(
+                const std::string& mediaKey,
+                const std::string& frameKey,
+                const OTIO_NS::RationalTime&,
+                VideoData&);
+
+            //! Read a frame on the read threads. The image is null if the
+            //! frame cannot be read.
+            std::future<VideoData> readRequest(
+                const std::string& mediaKey,
+                const std::string& frameKey,
+                const OTIO_NS::RationalTime&);
+
+            //! Write a frame. The frame is not written if it is already in
+            //! the cache, or if decoding the media is faster than reading
+            //! the cache.
+            void write(
+                const std::string& mediaKey,
+                const std::string& frameKey,
+                const VideoData&);
+
+            //! Add a measurement of the time it took to decode a frame.
+            void addDecodeTime(const std::string& mediaKey, float seconds);
+
+            //! Get the number of frames in the cache.
+            size_t getSize() const;
+
+            //! Get the number of bytes used by the cache.
+            size_t getByteCount() const;
+
+            //! Wait for the pending writes.
+            void wait();
+
+            //! Remove all of the frames from the cache.
+            void clear();
+
+        private:
+            void _run();
+            void _runRead();
+            void _trim(std::vector<std::filesystem::path>&);
+            void _remove(const std::vector<std::filesystem::path>&);
+
+            FTK_PRIVATE();
+        };
+
+        //! \name Serialize
+        ///@{
+
+        void to_json(nlohmann::json&, const DiskCacheOptions&);
+
+        void from_json(const nlohmann::json&, DiskCacheOptions&);
+
+        ///@}
+    }
+}
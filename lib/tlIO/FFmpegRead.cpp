@@ -365,6 +365,7 @@ namespace tl
                 }
 
                 // Seek.
+                const auto t0 = std::chrono::steady_clock::now();
                 if (videoRequest &&
                     !videoRequest->time.strictly_equal(p.videoThread.currentTime))
                 {
@@ -388,6 +389,8 @@ namespace tl
                     if (!p.readVideo->isBufferEmpty())
                     {
                         data.image = p.readVideo->popBuffer();
+                        const std::chrono::duration<float> diff = std::chrono::steady_clock::now() - t0;
+                        _addVideoDecodeTime(diff.count());
                     }
                     videoRequest->promise.set_value(data);
                     
@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <ftk/Core/FileIO.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace tl
+{
+    namespace io
+    {
+        //! Memory mapped file data. The data is read from the in-memory file
+        //! if one is given, otherwise the file is memory mapped, or read
+        //! into a buffer when memory mapping is not available.
+        struct FileData
+        {
+            FileData(const std::string& fileName, const ftk::InMemoryFile* memory)
+            {
+                if (memory)
+                {
+                    p = memory->p;
+                    size = memory->size;
+                }
+                else
+                {
+                    fileIO = ftk::FileIO::create(fileName, ftk::FileMode::Read);
+                    size = fileIO->getSize();
+                    p = fileIO->getMemoryP();
+                    if (!p)
+                    {
+                        buffer.resize(size);
+                        fileIO->read(buffer.data(), size);
+                        p = buffer.data();
+                    }
+                }
+            }
+
+            std::shared_ptr<ftk::FileIO> fileIO;
+            std::vector<uint8_t> buffer;
+            const uint8_t* p = nullptr;
+            size_t size = 0;
+        };
+    }
+}
@@ -0,0 +1,210 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/FrameCachePrivate.h>
+
+#include <ftk/Core/Format.h>
+
+#include <cmath>
+#include <cstring>
+
+namespace tl
+{
+    namespace framecache
+    {
+        Header createHeader(const io::Info& info)
+        {
+            Header out;
+            std::memcpy(out.magic, magic, sizeof(magic));
+            out.version = version;
+            out.endian = endianMarker;
+            out.pageSize = static_cast<uint32_t>(pageSize);
+            if (!info.video.empty())
+            {
+                const ftk::ImageInfo& imageInfo = info.video[0];
+                out.imageType = static_cast<uint32_t>(imageInfo.type);
+                out.width = imageInfo.size.w;
+                out.height = imageInfo.size.h;
+                out.alignment = imageInfo.layout.alignment;
+                out.mirrorX = imageInfo.layout.mirror.x;
+                out.mirrorY = imageInfo.layout.mirror.y;
+                out.videoLevels = static_cast<uint32_t>(imageInfo.videoLevels);
+                out.yuvCoefficients = static_cast<uint32_t>(imageInfo.yuvCoefficients);
+                out.pixelAspectRatio = imageInfo.pixelAspectRatio;
+                out.imageByteCount = imageInfo.getByteCount();
+            }
+            if (info.audio.isValid())
+            {
+                out.audioChannelCount = info.audio.channelCount;
+                out.audioDataType = static_cast<uint32_t>(info.audio.dataType);
+                out.audioSampleRate = info.audio.sampleRate;
+            }
+            out.speed = info.videoTime.duration().rate();
+            out.startFrame = info.videoTime.start_time().value();
+            return out;
+        }
+
+        ftk::ImageInfo getImageInfo(const Header& header)
+        {
+            ftk::ImageInfo out(
+                ftk::Size2I(header.width, header.height),
+                static_cast<ftk::ImageType>(header.imageType));
+            out.layout.alignment = header.alignment;
+            out.layout.mirror.x = header.mirrorX;
+            out.layout.mirror.y = header.mirrorY;
+            out.videoLevels = static_cast<ftk::VideoLevels>(header.videoLevels);
+            out.yuvCoefficients = static_cast<ftk::YUVCoefficients>(header.yuvCoefficients);
+            out.pixelAspectRatio = header.pixelAspectRatio;
+            return out;
+        }
+
+        audio::Info getAudioInfo(const Header& header)
+        {
+            return audio::Info(
+                header.audioChannelCount,
+                static_cast<audio::DataType>(header.audioDataType),
+                header.audioSampleRate);
+        }
+
+        namespace
+        {
+            void writeString(std::vector<uint8_t>& out, const std::string& value)
+            {
+                const uint32_t size = value.size();
+                const size_t offset = out.size();
+                out.resize(offset + sizeof(uint32_t) + size);
+                std::memcpy(out.data() + offset, &size, sizeof(uint32_t));
+                std::memcpy(out.data() + offset + sizeof(uint32_t), value.data(), size);
+            }
+
+            bool readString(const uint8_t*& p, const uint8_t* end, std::string& value)
+            {
+                uint32_t size = 0;
+                if (end - p < static_cast<ptrdiff_t>(sizeof(uint32_t)))
+                {
+                    return false;
+                }
+                std::memcpy(&size, p, sizeof(uint32_t));
+                p += sizeof(uint32_t);
+                if (end - p < static_cast<ptrdiff_t>(size))
+                {
+                    return false;
+                }
+                value.assign(reinterpret_cast<const char*>(p), size);
+                p += size;
+                return true;
+            }
+        }
+
+        std::vector<uint8_t> writeTags(const ftk::ImageTags& tags)
+        {
+            std::vector<uint8_t> out;
+            for (const auto& i : tags)
+            {
+                writeString(out, i.first);
+                writeString(out, i.second);
+            }
+            return out;
+        }
+
+        ftk::ImageTags readTags(const uint8_t* p, size_t byteCount)
+        {
+            ftk::ImageTags out;
+            const uint8_t* end = p + byteCount;
+            std::string key;
+            std::string value;
+            while (p < end && readString(p, end, key) && readString(p, end, value))
+            {
+                out[key] = value;
+            }
+            return out;
+        }
+
+        size_t getAudioSampleCount(
+            int64_t frame,
+            double speed,
+            size_t sampleRate)
+        {
+            size_t out = 0;
+            if (speed > 0.0)
+            {
+                const double samplesPerFrame = sampleRate / speed;
+                out =
+                    std::llround((frame + 1) * samplesPerFrame) -
+                    std::llround(frame * samplesPerFrame);
+            }
+            return out;
+        }
+
+        void ReadPlugin::_init(const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            IReadPlugin::_init(
+                "FrameCache",
+                { { ".tlfc", io::FileType::Media } },
+                logSystem);
+        }
+
+        std::shared_ptr<ReadPlugin> ReadPlugin::create(
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<ReadPlugin>(new ReadPlugin);
+            out->_init(logSystem);
+            return out;
+        }
+
+        std::shared_ptr<io::IRead> ReadPlugin::read(
+            const file::Path& path,
+            const io::Options& options)
+        {
+            return Read::create(path, options, _logSystem.lock());
+        }
+
+        std::shared_ptr<io::IRead> ReadPlugin::read(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options)
+        {
+            return Read::create(path, memory, options, _logSystem.lock());
+        }
+
+        void WritePlugin::_init(const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            IWritePlugin::_init(
+                "FrameCache",
+                { { ".tlfc", io::FileType::Media } },
+                logSystem);
+        }
+
+        std::shared_ptr<WritePlugin> WritePlugin::create(
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<WritePlugin>(new WritePlugin);
+            out->_init(logSystem);
+            return out;
+        }
+
+        ftk::ImageInfo WritePlugin::getInfo(
+            const ftk::ImageInfo& info,
+            const io::Options&) const
+        {
+            // Images are stored as-is, so any image type is supported.
+            ftk::ImageInfo out;
+            if (info.type != ftk::ImageType::None)
+            {
+                out = info;
+            }
+            return out;
+        }
+
+        std::shared_ptr<io::IWrite> WritePlugin::write(
+            const file::Path& path,
+            const io::Info& info,
+            const io::Options& options)
+        {
+            if (info.video.empty() || (!info.video.empty() && !_isCompatible(info.video[0], options)))
+                throw std::runtime_error(ftk::Format("Unsupported video: \"{0}\"").
+                    arg(path.get()));
+            return Write::create(path, info, options, _logSystem.lock());
+        }
+    }
+}
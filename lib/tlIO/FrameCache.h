@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlIO/Read.h>
+#include <tlIO/Write.h>
+
+namespace tl
+{
+    //! Frame cache I/O.
+    //!
+    //! The frame cache is an uncompressed container for pre-conformed
+    //! video and audio. The images are stored in the same layout the
+    //! renderer consumes, each at a page aligned offset, so that reading
+    //! a frame is limited by the disk bandwidth instead of decoding.
+    //!
+    //! File layout:
+    //! - Header
+    //! - Tags
+    //! - Frames (audio samples followed by the page aligned image)
+    //! - Frame table
+    //! - Trailer
+    namespace framecache
+    {
+        //! Frame cache reader.
+        class Read : public io::IRead
+        {
+        protected:
+            void _init(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            Read();
+
+        public:
+            virtual ~Read();
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            std::future<io::Info> getInfo() override;
+            std::future<io::VideoData> readVideo(
+                const OTIO_NS::RationalTime&,
+                const io::Options& = io::Options()) override;
+            std::future<io::AudioData> readAudio(
+                const OTIO_NS::TimeRange&,
+                const io::Options& = io::Options()) override;
+            void cancelRequests() override;
+
+        private:
+            FTK_PRIVATE();
+        };
+
+        //! Frame cache writer.
+        //!
+        //! Frames are appended in the order they are written. Audio is
+        //! buffered until the video frame it belongs to is written. The
+        //! frame table and trailer are written by finish(), a writer that
+        //! is destroyed without finishing leaves a file that the reader
+        //! rejects.
+        class Write : public io::IWrite
+        {
+        protected:
+            void _init(
+                const file::Path&,
+                const io::Info&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            Write();
+
+        public:
+            virtual ~Write();
+
+            //! Create a new writer.
+            static std::shared_ptr<Write> create(
+                const file::Path&,
+                const io::Info&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            void writeVideo(
+                const OTIO_NS::RationalTime&,
+                const std::shared_ptr<ftk::Image>&,
+                const io::Options& = io::Options()) override;
+            void writeAudio(
+                const OTIO_NS::TimeRange&,
+                const std::shared_ptr<audio::Audio>&,
+                const io::Options& = io::Options()) override;
+            bool hasAudio() const override;
+            void finish() override;
+
+        private:
+            FTK_PRIVATE();
+        };
+
+        //! Frame cache read plugin.
+        class ReadPlugin : public io::IReadPlugin
+        {
+        protected:
+            void _init(const std::shared_ptr<ftk::LogSystem>&);
+
+            ReadPlugin() = default;
+
+        public:
+            //! Create a new plugin.
+            static std::shared_ptr<ReadPlugin> create(
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const io::Options& = io::Options()) override;
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options& = io::Options()) override;
+        };
+
+        //! Frame cache write plugin.
+        class WritePlugin : public io::IWritePlugin
+        {
+        protected:
+            void _init(const std::shared_ptr<ftk::LogSystem>&);
+
+            WritePlugin() = default;
+
+        public:
+            //! Create a new plugin.
+            static std::shared_ptr<WritePlugin> create(
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            ftk::ImageInfo getInfo(
+                const ftk::ImageInfo&,
+                const io::Options& = io::Options()) const override;
+            std::shared_ptr<io::IWrite> write(
+                const file::Path&,
+                const io::Info&,
+                const io::Options& = io::Options()) override;
+        };
+    }
+}
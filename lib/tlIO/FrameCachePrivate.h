@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlIO/FrameCache.h>
+
+namespace tl
+{
+    namespace framecache
+    {
+        //! File magic number.
+        const char magic[4] = { 'T', 'L', 'F', 'C' };
+
+        //! File format version.
+        const uint32_t version = 1;
+
+        //! Endian marker, written in the native byte order.
+        const uint32_t endianMarker = 0x01020304;
+
+        //! Image data alignment.
+        const size_t pageSize = 4096;
+
+        //! File header.
+        struct Header
+        {
+            char     magic[4]          = { 0, 0, 0, 0 };
+            uint32_t version           = 0;
+            uint32_t endian            = 0;
+            uint32_t pageSize          = 0;
+            uint32_t imageType         = 0;
+            uint32_t width             = 0;
+            uint32_t height            = 0;
+            uint32_t alignment         = 1;
+            uint32_t mirrorX           = 0;
+            uint32_t mirrorY           = 0;
+            uint32_t videoLevels       = 0;
+            uint32_t yuvCoefficients   = 0;
+            float    pixelAspectRatio  = 1.F;
+            uint32_t audioChannelCount = 0;
+            uint32_t audioDataType     = 0;
+            uint32_t audioSampleRate   = 0;
+            double   speed             = 0.0;
+            int64_t  startFrame        = 0;
+            uint64_t imageByteCount    = 0;
+            uint64_t tagsOffset        = 0;
+            uint64_t tagsByteCount     = 0;
+        };
+
+        //! Frame table entry.
+        struct Frame
+        {
+            uint64_t imageOffset      = 0;
+            uint64_t audioOffset      = 0;
+            uint64_t audioSampleCount = 0;
+            uint64_t reserved         = 0;
+        };
+
+        //! File trailer. The trailer is written last, so a file that was
+        //! not finished is rejected by the reader.
+        struct Trailer
+        {
+            uint64_t tableOffset = 0;
+            uint64_t frameCount  = 0;
+            uint32_t endian      = 0;
+            char     magic[4]    = { 0, 0, 0, 0 };
+        };
+
+        //! Create a header.
+        Header createHeader(const io::Info&);
+
+        //! Get the image information from a header.
+        ftk::ImageInfo getImageInfo(const Header&);
+
+        //! Get the audio information from a header.
+        audio::Info getAudioInfo(const Header&);
+
+        //! Serialize tags.
+        std::vector<uint8_t> writeTags(const ftk::ImageTags&);
+
+        //! Deserialize tags.
+        ftk::ImageTags readTags(const uint8_t*, size_t byteCount);
+
+        //! Get the number of audio samples that belong to a frame.
+        size_t getAudioSampleCount(
+            int64_t frame,
+            double speed,
+            size_t sampleRate);
+    }
+}
@@ -0,0 +1,392 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/FrameCachePrivate.h>
+#include <tlIO/FileDataPrivate.h>
+
+#include <ftk/Core/FileIO.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/LogSystem.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace tl
+{
+    namespace framecache
+    {
+        namespace
+        {
+            const size_t threadCount = 4;
+        }
+
+        struct Read::Private
+        {
+            void open(const std::string& fileName, const ftk::InMemoryFile*);
+            io::VideoData readVideo(const OTIO_NS::RationalTime&) const;
+
+            std::shared_ptr<io::FileData> data;
+            Header header;
+            ftk::ImageInfo imageInfo;
+            audio::Info audioInfo;
+            std::vector<Frame> frames;
+            std::vector<uint64_t> audioSampleOffsets;
+            io::Info info;
+
+            struct VideoRequest
+            {
+                OTIO_NS::RationalTime time = time::invalidTime;
+                std::promise<io::VideoData> promise;
+            };
+
+            struct Mutex
+            {
+                std::list<std::shared_ptr<VideoRequest> > videoRequests;
+                bool stopped = false;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+
+            struct Thread
+            {
+                std::condition_variable cv;
+                std::vector<std::thread> threads;
+            };
+            Thread thread;
+        };
+
+        void Read::_init(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            IRead::_init(path, memory, options, logSystem);
+            FTK_P();
+            try
+            {
+                p.open(path.get(), !_memory.empty() ? &_memory[0] : nullptr);
+            }
+            catch (const std::exception& e)
+            {
+                p.data.reset();
+                p.info = io::Info();
+                if (logSystem)
+                {
+                    logSystem->print(
+                        "tl::io::framecache::Read",
+                        e.what(),
+                        ftk::LogType::Error);
+                }
+            }
+
+            // The images are copied from the memory mapping by a fixed
+            // number of worker threads.
+            if (p.data)
+            {
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    p.thread.threads.push_back(std::thread(
+                        [this]
+                        {
+                            FTK_P();
+                            while (true)
+                            {
+                                std::shared_ptr<Private::VideoRequest> request;
+                                {
+                                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                                    p.thread.cv.wait(
+                                        lock,
+                                        [this]
+                                        {
+                                            return
+                                                _p->mutex.stopped ||
+                                                !_p->mutex.videoRequests.empty();
+                                        });
+                                    if (p.mutex.stopped)
+                                    {
+                                        break;
+                                    }
+                                    request = p.mutex.videoRequests.front();
+                                    p.mutex.videoRequests.pop_front();
+                                }
+                                io::VideoData videoData;
+                                videoData.time = request->time;
+                                try
+                                {
+                                    const auto t0 = std::chrono::steady_clock::now();
+                                    videoData = p.readVideo(request->time);
+                                    if (videoData.image)
+                                    {
+                                        const std::chrono::duration<float> diff = std::chrono::steady_clock::now() - t0;
+                                        _addVideoDecodeTime(diff.count());
+                                    }
+                                }
+                                catch (const std::exception&)
+                                {}
+                                request->promise.set_value(videoData);
+                            }
+                        }));
+                }
+            }
+        }
+
+        Read::Read() :
+            _p(new Private)
+        {}
+
+        Read::~Read()
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stopped = true;
+            }
+            p.thread.cv.notify_all();
+            for (auto& thread : p.thread.threads)
+            {
+                thread.join();
+            }
+            cancelRequests();
+        }
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, {}, options, logSystem);
+            return out;
+        }
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, memory, options, logSystem);
+            return out;
+        }
+
+        std::future<io::Info> Read::getInfo()
+        {
+            std::promise<io::Info> promise;
+            auto future = promise.get_future();
+            promise.set_value(_p->info);
+            return future;
+        }
+
+        std::future<io::VideoData> Read::readVideo(
+            const OTIO_NS::RationalTime& time,
+            const io::Options&)
+        {
+            FTK_P();
+            auto request = std::make_shared<Private::VideoRequest>();
+            request->time = time;
+            auto future = request->promise.get_future();
+            bool valid = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (p.data && !p.mutex.stopped)
+                {
+                    valid = true;
+                    p.mutex.videoRequests.push_back(request);
+                }
+            }
+            if (valid)
+            {
+                p.thread.cv.notify_one();
+            }
+            else
+            {
+                io::VideoData videoData;
+                videoData.time = time;
+                request->promise.set_value(videoData);
+            }
+            return future;
+        }
+
+        std::future<io::AudioData> Read::readAudio(
+            const OTIO_NS::TimeRange& timeRange,
+            const io::Options&)
+        {
+            FTK_P();
+            io::AudioData out;
+            out.time = timeRange.start_time();
+            if (p.data && p.audioInfo.isValid())
+            {
+                const OTIO_NS::TimeRange range(
+                    timeRange.start_time().rescaled_to(p.audioInfo.sampleRate).round(),
+                    timeRange.duration().rescaled_to(p.audioInfo.sampleRate).round());
+                const size_t sampleCount = range.duration().value();
+                out.audio = audio::Audio::create(p.audioInfo, sampleCount);
+                out.audio->zero();
+
+                // Copy the samples from each frame that intersects the
+                // requested range.
+                const size_t byteCount = p.audioInfo.getByteCount();
+                const int64_t start =
+                    static_cast<int64_t>(range.start_time().value()) -
+                    static_cast<int64_t>(p.info.audioTime.start_time().value());
+                const int64_t end = start + static_cast<int64_t>(sampleCount);
+                auto i = std::upper_bound(
+                    p.audioSampleOffsets.begin(),
+                    p.audioSampleOffsets.end(),
+                    static_cast<uint64_t>(std::max(start, static_cast<int64_t>(0))));
+                size_t frame = i != p.audioSampleOffsets.begin() ?
+                    (i - p.audioSampleOffsets.begin() - 1) :
+                    0;
+                for (; frame < p.frames.size(); ++frame)
+                {
+                    const int64_t frameStart = p.audioSampleOffsets[frame];
+                    const int64_t frameEnd = p.audioSampleOffsets[frame + 1];
+                    if (frameStart >= end)
+                    {
+                        break;
+                    }
+                    const int64_t copyStart = std::max(start, frameStart);
+                    const int64_t copyEnd = std::min(end, frameEnd);
+                    if (copyStart < copyEnd)
+                    {
+                        std::memcpy(
+                            out.audio->getData() + (copyStart - start) * byteCount,
+                            p.data->p + p.frames[frame].audioOffset + (copyStart - frameStart) * byteCount,
+                            (copyEnd - copyStart) * byteCount);
+                    }
+                }
+            }
+            std::promise<io::AudioData> promise;
+            auto future = promise.get_future();
+            promise.set_value(out);
+            return future;
+        }
+
+        void Read::cancelRequests()
+        {
+            FTK_P();
+            std::list<std::shared_ptr<Private::VideoRequest> > videoRequests;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                videoRequests = std::move(p.mutex.videoRequests);
+                p.mutex.videoRequests.clear();
+            }
+            for (auto& request : videoRequests)
+            {
+                io::VideoData videoData;
+                videoData.time = request->time;
+                request->promise.set_value(videoData);
+            }
+        }
+
+        io::VideoData Read::Private::readVideo(const OTIO_NS::RationalTime& time) const
+        {
+            io::VideoData out;
+            out.time = time;
+            const int64_t frame =
+                static_cast<int64_t>(time.rescaled_to(header.speed).round().value()) - header.startFrame;
+            if (frame >= 0 && frame < static_cast<int64_t>(frames.size()))
+            {
+                out.image = ftk::Image::create(imageInfo);
+                out.image->setTags(info.tags);
+                std::memcpy(
+                    out.image->getData(),
+                    data->p + frames[frame].imageOffset,
+                    imageInfo.getByteCount());
+            }
+            return out;
+        }
+
+        void Read::Private::open(const std::string& fileName, const ftk::InMemoryFile* memory)
+        {
+            data = std::make_shared<io::FileData>(fileName, memory);
+
+            // Read the header and trailer.
+            if (data->size < sizeof(Header) + sizeof(Trailer))
+            {
+                throw std::runtime_error(ftk::Format("Bad file: \"{0}\"").arg(fileName));
+            }
+            std::memcpy(&header, data->p, sizeof(Header));
+            Trailer trailer;
+            std::memcpy(&trailer, data->p + data->size - sizeof(Trailer), sizeof(Trailer));
+            if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 ||
+                std::memcmp(trailer.magic, magic, sizeof(magic)) != 0)
+            {
+                throw std::runtime_error(ftk::Format("Bad magic number: \"{0}\"").arg(fileName));
+            }
+            if (header.version != version)
+            {
+                throw std::runtime_error(ftk::Format("Unsupported version: \"{0}\"").arg(fileName));
+            }
+            if (header.endian != endianMarker || trailer.endian != endianMarker)
+            {
+                throw std::runtime_error(ftk::Format("Unsupported byte order: \"{0}\"").arg(fileName));
+            }
+            imageInfo = getImageInfo(header);
+            if (ftk::ImageType::None == imageInfo.type ||
+                imageInfo.size.w <= 0 ||
+                imageInfo.size.h <= 0 ||
+                imageInfo.getByteCount() != header.imageByteCount ||
+                header.speed <= 0.0)
+            {
+                throw std::runtime_error(ftk::Format("Bad header: \"{0}\"").arg(fileName));
+            }
+            audioInfo = getAudioInfo(header);
+
+            // Read the frame table.
+            const size_t tableEnd = data->size - sizeof(Trailer);
+            if (trailer.tableOffset > tableEnd ||
+                trailer.frameCount > (tableEnd - trailer.tableOffset) / sizeof(Frame))
+            {
+                throw std::runtime_error(ftk::Format("Bad frame table: \"{0}\"").arg(fileName));
+            }
+            frames.resize(trailer.frameCount);
+            std::memcpy(frames.data(), data->p + trailer.tableOffset, frames.size() * sizeof(Frame));
+            audioSampleOffsets.resize(frames.size() + 1);
+            audioSampleOffsets[0] = 0;
+            const size_t audioByteCount = audioInfo.isValid() ? audioInfo.getByteCount() : 0;
+            for (size_t i = 0; i < frames.size(); ++i)
+            {
+                const Frame& frame = frames[i];
+                if (frame.imageOffset > trailer.tableOffset ||
+                    header.imageByteCount > trailer.tableOffset - frame.imageOffset ||
+                    frame.audioOffset > trailer.tableOffset ||
+                    frame.audioSampleCount * audioByteCount > trailer.tableOffset - frame.audioOffset)
+                {
+                    throw std::runtime_error(ftk::Format("Bad frame table: \"{0}\"").arg(fileName));
+                }
+                audioSampleOffsets[i + 1] = audioSampleOffsets[i] +
+                    (audioByteCount > 0 ? frame.audioSampleCount : 0);
+            }
+
+            // Read the tags.
+            ftk::ImageTags tags;
+            if (header.tagsOffset <= data->size &&
+                header.tagsByteCount <= data->size - header.tagsOffset)
+            {
+                tags = readTags(data->p + header.tagsOffset, header.tagsByteCount);
+            }
+
+            // Set the information.
+            info.video.push_back(imageInfo);
+            info.videoTime = OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(header.startFrame, header.speed),
+                OTIO_NS::RationalTime(frames.size(), header.speed));
+            if (audioInfo.isValid())
+            {
+                info.audio = audioInfo;
+                info.audioTime = OTIO_NS::TimeRange(
+                    info.videoTime.start_time().rescaled_to(audioInfo.sampleRate).round(),
+                    OTIO_NS::RationalTime(audioSampleOffsets.back(), audioInfo.sampleRate));
+            }
+            info.tags = tags;
+        }
+    }
+}
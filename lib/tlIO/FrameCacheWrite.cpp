@@ -0,0 +1,189 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/FrameCachePrivate.h>
+
+#include <ftk/Core/FileIO.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/LogSystem.h>
+
+#include <cstring>
+#include <list>
+
+namespace tl
+{
+    namespace framecache
+    {
+        struct Write::Private
+        {
+            void write(const void*, size_t);
+            void pad();
+
+            std::string fileName;
+            std::shared_ptr<ftk::FileIO> fileIO;
+            uint64_t pos = 0;
+            Header header;
+            audio::Info audioInfo;
+            std::list<std::shared_ptr<audio::Audio> > audio;
+            std::vector<uint8_t> audioBuffer;
+            std::vector<Frame> frames;
+            bool finished = false;
+        };
+
+        void Write::_init(
+            const file::Path& path,
+            const io::Info& info,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            IWrite::_init(path, options, info, logSystem);
+
+            FTK_P();
+            p.fileName = path.get();
+            if (info.video.empty())
+            {
+                throw std::runtime_error(ftk::Format("No video: \"{0}\"").arg(p.fileName));
+            }
+            p.header = createHeader(info);
+            p.audioInfo = info.audio;
+
+            const std::vector<uint8_t> tags = writeTags(info.tags);
+            p.header.tagsOffset = sizeof(Header);
+            p.header.tagsByteCount = tags.size();
+
+            p.fileIO = ftk::FileIO::create(p.fileName, ftk::FileMode::Write);
+            p.write(&p.header, sizeof(Header));
+            p.write(tags.data(), tags.size());
+        }
+
+        Write::Write() :
+            _p(new Private)
+        {}
+
+        Write::~Write()
+        {
+            FTK_P();
+            if (!p.finished)
+            {
+                if (auto logSystem = _logSystem.lock())
+                {
+                    logSystem->print(
+                        "tl::io::framecache::Write",
+                        ftk::Format("File was not finished: \"{0}\"").arg(p.fileName),
+                        ftk::LogType::Warning);
+                }
+            }
+        }
+
+        std::shared_ptr<Write> Write::create(
+            const file::Path& path,
+            const io::Info& info,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<Write>(new Write);
+            out->_init(path, info, options, logSystem);
+            return out;
+        }
+
+        void Write::writeVideo(
+            const OTIO_NS::RationalTime&,
+            const std::shared_ptr<ftk::Image>& image,
+            const io::Options&)
+        {
+            FTK_P();
+            if (p.finished)
+            {
+                throw std::runtime_error(ftk::Format("File is finished: \"{0}\"").arg(p.fileName));
+            }
+            if (image->getInfo().getByteCount() != p.header.imageByteCount)
+            {
+                throw std::runtime_error(ftk::Format("Incompatible image: \"{0}\"").arg(p.fileName));
+            }
+            Frame frame;
+
+            // Write the audio that belongs to this frame, padding with
+            // silence if not enough audio has been written.
+            if (p.audioInfo.isValid())
+            {
+                const size_t sampleCount = getAudioSampleCount(
+                    p.frames.size(),
+                    p.header.speed,
+                    p.audioInfo.sampleRate);
+                const size_t byteCount = sampleCount * p.audioInfo.getByteCount();
+                p.audioBuffer.resize(byteCount);
+                const size_t available = std::min(sampleCount, audio::getSampleCount(p.audio));
+                audio::move(p.audio, p.audioBuffer.data(), available);
+                std::memset(
+                    p.audioBuffer.data() + available * p.audioInfo.getByteCount(),
+                    0,
+                    (sampleCount - available) * p.audioInfo.getByteCount());
+                frame.audioOffset = p.pos;
+                frame.audioSampleCount = sampleCount;
+                p.write(p.audioBuffer.data(), byteCount);
+            }
+
+            // Write the image.
+            p.pad();
+            frame.imageOffset = p.pos;
+            p.write(image->getData(), p.header.imageByteCount);
+            p.frames.push_back(frame);
+        }
+
+        void Write::writeAudio(
+            const OTIO_NS::TimeRange&,
+            const std::shared_ptr<audio::Audio>& audio,
+            const io::Options&)
+        {
+            FTK_P();
+            if (audio && audio->getInfo().channelCount == p.audioInfo.channelCount &&
+                audio->getInfo().dataType == p.audioInfo.dataType &&
+                audio->getInfo().sampleRate == p.audioInfo.sampleRate)
+            {
+                p.audio.push_back(audio);
+            }
+        }
+
+        bool Write::hasAudio() const
+        {
+            return _p->audioInfo.isValid();
+        }
+
+        void Write::finish()
+        {
+            FTK_P();
+            if (!p.finished)
+            {
+                // Write the frame table and trailer.
+                Trailer trailer;
+                trailer.tableOffset = p.pos;
+                trailer.frameCount = p.frames.size();
+                trailer.endian = endianMarker;
+                std::memcpy(trailer.magic, magic, sizeof(magic));
+                p.write(p.frames.data(), p.frames.size() * sizeof(Frame));
+                p.write(&trailer, sizeof(Trailer));
+                p.fileIO.reset();
+                p.finished = true;
+            }
+        }
+
+        void Write::Private::write(const void* data, size_t size)
+        {
+            if (size > 0)
+            {
+                fileIO->write(reinterpret_cast<const uint8_t*>(data), size);
+                pos += size;
+            }
+        }
+
+        void Write::Private::pad()
+        {
+            const size_t size = (pageSize - pos % pageSize) % pageSize;
+            if (size > 0)
+            {
+                const std::vector<uint8_t> zero(size, 0);
+                write(zero.data(), size);
+            }
+        }
+    }
+}
@@ -3,6 +3,8 @@
 
 #include <tlIO/IO.h>
 
+#include <cstdlib>
+
 namespace tl
 {
     namespace io
@@ -95,5 +97,28 @@ namespace tl
             }
             return out;
         }
+
+        int getProxyScale(const Options& options)
+        {
+            int out = 1;
+            const auto i = options.find("Proxy");
+            if (i != options.end())
+            {
+                const int value = std::atoi(i->second.c_str());
+                if (value >= 8)
+                {
+                    out = 8;
+                }
+                else if (value >= 4)
+                {
+                    out = 4;
+                }
+                else if (value >= 2)
+                {
+                    out = 2;
+                }
+            }
+            return out;
+        }
     }
 }
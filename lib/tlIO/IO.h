@@ -33,6 +33,10 @@ namespace tl
             //! Video time range.
             OTIO_NS::TimeRange videoTime = time::invalidTimeRange;
 
+            //! Whether the video can be decoded at a reduced resolution with
+            //! the "Proxy" option.
+            bool videoProxy = false;
+
             //! Audio information.
             audio::Info audio;
 
@@ -92,6 +96,11 @@ namespace tl
 
         //! Merge options.
         Options merge(const Options&, const Options&);
+
+        //! Get the proxy scale from the "Proxy" option. The scale is the
+        //! denominator of the requested resolution (1, 2, 4, or 8), readers
+        //! that support reduced resolution decoding use it to skip work.
+        int getProxyScale(const Options&);
     }
 }
 
@@ -10,6 +10,7 @@ namespace tl
             return
                 video == other.video &&
                 time::compareExact(videoTime, other.videoTime) &&
+                videoProxy == other.videoProxy &&
                 audio == other.audio &&
                 time::compareExact(audioTime, other.audioTime) &&
                 tags == other.tags;
@@ -3,6 +3,7 @@
 
 #include <tlIO/Init.h>
 
+#include <tlIO/DiskCache.h>
 #include <tlIO/System.h>
 
 #include <tlCore/Init.h>
@@ -20,6 +21,7 @@ namespace tl
             ftk::gl::init(context);
             ReadSystem::create(context);
             WriteSystem::create(context);
+            DiskCacheSystem::create(context);
         }
     }
 }
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/JPEG.h>
+
+namespace tl
+{
+    namespace jpeg
+    {
+        void ReadPlugin::_init(const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            IReadPlugin::_init(
+                "JPEG",
+                {
+                    { ".jpeg", io::FileType::Sequence },
+                    { ".jpg", io::FileType::Sequence }
+                },
+                logSystem);
+        }
+
+        std::shared_ptr<ReadPlugin> ReadPlugin::create(
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<ReadPlugin>(new ReadPlugin);
+            out->_init(logSystem);
+            return out;
+        }
+
+        std::shared_ptr<io::IRead> ReadPlugin::read(
+            const file::Path& path,
+            const io::Options& options)
+        {
+            return Read::create(path, options, _logSystem.lock());
+        }
+
+        std::shared_ptr<io::IRead> ReadPlugin::read(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options)
+        {
+            return Read::create(path, memory, options, _logSystem.lock());
+        }
+    }
+}
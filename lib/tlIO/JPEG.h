@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlIO/SequenceIO.h>
+
+namespace tl
+{
+    //! JPEG image I/O.
+    namespace jpeg
+    {
+        //! JPEG reader.
+        //!
+        //! The "Proxy" option selects DCT domain scaled decoding (1/2, 1/4,
+        //! or 1/8 resolution).
+        class Read : public io::ISequenceRead
+        {
+        protected:
+            void _init(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            Read();
+
+        public:
+            virtual ~Read();
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+        protected:
+            io::Info _getInfo(
+                const std::string& fileName,
+                const ftk::InMemoryFile*) override;
+            io::VideoData _readVideo(
+                const std::string& fileName,
+                const ftk::InMemoryFile*,
+                const OTIO_NS::RationalTime&,
+                const io::Options&) override;
+
+        private:
+            FTK_PRIVATE();
+        };
+
+        //! JPEG read plugin.
+        class ReadPlugin : public io::IReadPlugin
+        {
+        protected:
+            void _init(const std::shared_ptr<ftk::LogSystem>&);
+
+            ReadPlugin() = default;
+
+        public:
+            //! Create a new plugin.
+            static std::shared_ptr<ReadPlugin> create(
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const io::Options& = io::Options()) override;
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options& = io::Options()) override;
+        };
+    }
+}
@@ -0,0 +1,342 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/JPEG.h>
+#include <tlIO/FileDataPrivate.h>
+
+#include <ftk/Core/Format.h>
+
+#include <array>
+#include <csetjmp>
+#include <cstdio>
+#include <mutex>
+
+#include <jpeglib.h>
+
+namespace tl
+{
+    namespace jpeg
+    {
+        namespace
+        {
+            struct ErrorStruct
+            {
+                struct jpeg_error_mgr pub;
+                std::array<char, JMSG_LENGTH_MAX> message;
+                std::jmp_buf jump;
+            };
+
+            void errorFunc(j_common_ptr in)
+            {
+                auto error = reinterpret_cast<ErrorStruct*>(in->err);
+                in->err->format_message(in, error->message.data());
+                std::longjmp(error->jump, 1);
+            }
+
+            void warningFunc(j_common_ptr, int)
+            {}
+
+            //! Decoder. The decoders are pooled so the libjpeg allocations
+            //! are re-used between frames.
+            //!
+            //! Note that the libjpeg error handling uses longjmp(), so the
+            //! functions that call into libjpeg must not have C++ objects
+            //! with destructors on the stack.
+            class Decoder
+            {
+            public:
+                Decoder()
+                {
+                    _cinfo.err = jpeg_std_error(&_error.pub);
+                    _error.pub.error_exit = errorFunc;
+                    _error.pub.emit_message = warningFunc;
+                    _error.message[0] = 0;
+                }
+
+                ~Decoder()
+                {
+                    if (_init)
+                    {
+                        jpeg_destroy_decompress(&_cinfo);
+                    }
+                }
+
+                bool init()
+                {
+                    if (!_init)
+                    {
+                        if (setjmp(_error.jump))
+                        {
+                            return false;
+                        }
+                        jpeg_create_decompress(&_cinfo);
+                        _init = true;
+                    }
+                    return true;
+                }
+
+                bool readHeader(
+                    const uint8_t* p,
+                    size_t size,
+                    int proxyScale)
+                {
+                    if (setjmp(_error.jump))
+                    {
+                        return false;
+                    }
+                    jpeg_mem_src(&_cinfo, p, size);
+                    jpeg_read_header(&_cinfo, TRUE);
+                    if (JCS_GRAYSCALE != _cinfo.jpeg_color_space)
+                    {
+                        _cinfo.out_color_space = JCS_RGB;
+                    }
+                    _cinfo.scale_num = 1;
+                    _cinfo.scale_denom = proxyScale;
+                    jpeg_calc_output_dimensions(&_cinfo);
+                    return true;
+                }
+
+                bool decode(JSAMPROW* rows)
+                {
+                    if (setjmp(_error.jump))
+                    {
+                        return false;
+                    }
+                    jpeg_start_decompress(&_cinfo);
+                    while (_cinfo.output_scanline < _cinfo.output_height)
+                    {
+                        jpeg_read_scanlines(
+                            &_cinfo,
+                            rows + _cinfo.output_scanline,
+                            _cinfo.output_height - _cinfo.output_scanline);
+                    }
+                    jpeg_finish_decompress(&_cinfo);
+                    return true;
+                }
+
+                void abort()
+                {
+                    if (_init)
+                    {
+                        jpeg_abort_decompress(&_cinfo);
+                    }
+                }
+
+                ftk::ImageInfo getImageInfo() const
+                {
+                    ftk::ImageInfo out;
+                    switch (_cinfo.out_color_space)
+                    {
+                    case JCS_GRAYSCALE: out.type = ftk::ImageType::L_U8; break;
+                    case JCS_RGB: out.type = ftk::ImageType::RGB_U8; break;
+                    default: break;
+                    }
+                    out.size.w = _cinfo.output_width;
+                    out.size.h = _cinfo.output_height;
+                    if (_cinfo.X_density > 0 && _cinfo.Y_density > 0)
+                    {
+                        out.pixelAspectRatio = _cinfo.X_density / static_cast<float>(_cinfo.Y_density);
+                    }
+                    out.layout.mirror.y = true;
+                    return out;
+                }
+
+                std::string getError() const
+                {
+                    return _error.message.data();
+                }
+
+                std::vector<JSAMPROW>& getRows()
+                {
+                    return _rows;
+                }
+
+            private:
+                jpeg_decompress_struct _cinfo;
+                ErrorStruct _error;
+                std::vector<JSAMPROW> _rows;
+                bool _init = false;
+            };
+
+            //! Decoder pool.
+            class DecoderPool
+            {
+            public:
+                std::unique_ptr<Decoder> get()
+                {
+                    std::unique_ptr<Decoder> out;
+                    {
+                        std::unique_lock<std::mutex> lock(_mutex);
+                        if (!_decoders.empty())
+                        {
+                            out = std::move(_decoders.back());
+                            _decoders.pop_back();
+                        }
+                    }
+                    if (!out)
+                    {
+                        out.reset(new Decoder);
+                    }
+                    return out;
+                }
+
+                void release(std::unique_ptr<Decoder> decoder)
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _decoders.push_back(std::move(decoder));
+                }
+
+            private:
+                std::vector<std::unique_ptr<Decoder> > _decoders;
+                std::mutex _mutex;
+            };
+
+            //! Borrow a decoder from the pool. The decoder is reset and
+            //! returned to the pool when the guard goes out of scope, so
+            //! it is not lost when an error is thrown.
+            class DecoderGuard
+            {
+            public:
+                explicit DecoderGuard(DecoderPool& pool) :
+                    _pool(pool),
+                    _decoder(pool.get())
+                {}
+
+                ~DecoderGuard()
+                {
+                    _decoder->abort();
+                    _pool.release(std::move(_decoder));
+                }
+
+                DecoderGuard(const DecoderGuard&) = delete;
+                DecoderGuard& operator = (const DecoderGuard&) = delete;
+
+                Decoder& operator * () { return *_decoder; }
+                Decoder* operator -> () { return _decoder.get(); }
+
+            private:
+                DecoderPool& _pool;
+                std::unique_ptr<Decoder> _decoder;
+            };
+        }
+
+        struct Read::Private
+        {
+            DecoderPool decoderPool;
+        };
+
+        void Read::_init(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            ISequenceRead::_init(path, memory, options, logSystem);
+        }
+
+        Read::Read() :
+            _p(new Private)
+        {}
+
+        Read::~Read()
+        {
+            _finish();
+        }
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, {}, options, logSystem);
+            return out;
+        }
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, memory, options, logSystem);
+            return out;
+        }
+
+        namespace
+        {
+            ftk::ImageInfo readHeader(
+                Decoder& decoder,
+                const io::FileData& data,
+                int proxyScale,
+                const std::string& fileName)
+            {
+                if (!decoder.init() || !decoder.readHeader(data.p, data.size, proxyScale))
+                {
+                    throw std::runtime_error(ftk::Format("Cannot open: \"{0}\": {1}").
+                        arg(fileName).
+                        arg(decoder.getError()));
+                }
+                const ftk::ImageInfo out = decoder.getImageInfo();
+                if (ftk::ImageType::None == out.type)
+                {
+                    throw std::runtime_error(ftk::Format("Unsupported color space: \"{0}\"").
+                        arg(fileName));
+                }
+                return out;
+            }
+        }
+
+        io::Info Read::_getInfo(
+            const std::string& fileName,
+            const ftk::InMemoryFile* memory)
+        {
+            FTK_P();
+            DecoderGuard decoder(p.decoderPool);
+            const io::FileData data(fileName, memory);
+            io::Info out;
+            out.video.push_back(readHeader(*decoder, data, io::getProxyScale(_options), fileName));
+            out.videoProxy = true;
+            out.videoTime = OTIO_NS::TimeRange::range_from_start_end_time_inclusive(
+                OTIO_NS::RationalTime(_startFrame, _defaultSpeed),
+                OTIO_NS::RationalTime(_endFrame, _defaultSpeed));
+            return out;
+        }
+
+        io::VideoData Read::_readVideo(
+            const std::string& fileName,
+            const ftk::InMemoryFile* memory,
+            const OTIO_NS::RationalTime& time,
+            const io::Options& options)
+        {
+            FTK_P();
+            DecoderGuard decoder(p.decoderPool);
+            const io::FileData data(fileName, memory);
+            const ftk::ImageInfo imageInfo = readHeader(
+                *decoder,
+                data,
+                io::getProxyScale(options),
+                fileName);
+
+            // Decode directly into the image.
+            io::VideoData out;
+            out.time = time;
+            out.image = ftk::Image::create(imageInfo);
+            const size_t rowByteCount = imageInfo.size.w * ftk::getChannelCount(imageInfo.type);
+            auto& rows = decoder->getRows();
+            rows.resize(imageInfo.size.h);
+            for (int y = 0; y < imageInfo.size.h; ++y)
+            {
+                rows[y] = out.image->getData() + y * rowByteCount;
+            }
+            if (!decoder->decode(rows.data()))
+            {
+                throw std::runtime_error(ftk::Format("Cannot read: \"{0}\": {1}").
+                    arg(fileName).
+                    arg(decoder->getError()));
+            }
+            return out;
+        }
+    }
+}
@@ -9,6 +9,12 @@ namespace tl
 {
     namespace io
     {
+        namespace
+        {
+            //! Smoothing for the decode time measurements.
+            const float decodeTimeSmoothing = .1F;
+        }
+
         void IRead::_init(
             const file::Path& path,
             const std::vector<ftk::InMemoryFile>& memory,
@@ -19,7 +25,8 @@ namespace tl
             _memory = memory;
         }
 
-        IRead::IRead()
+        IRead::IRead() :
+            _videoDecodeTime(0.F)
         {}
 
         IRead::~IRead()
@@ -39,6 +46,23 @@ namespace tl
             return std::future<AudioData>();
         }
 
+        float IRead::getVideoDecodeTime() const
+        {
+            return _videoDecodeTime.load();
+        }
+
+        void IRead::_addVideoDecodeTime(float seconds)
+        {
+            float value = _videoDecodeTime.load();
+            float smoothed = 0.F;
+            do
+            {
+                smoothed = value > 0.F ?
+                    (value + (seconds - value) * decodeTimeSmoothing) :
+                    seconds;
+            } while (!_videoDecodeTime.compare_exchange_weak(value, smoothed));
+        }
+
         struct IReadPlugin::Private
         {
         };
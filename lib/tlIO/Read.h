@@ -5,6 +5,8 @@
 
 #include <tlIO/Plugin.h>
 
+#include <atomic>
+
 namespace tl
 {
     namespace io
@@ -40,8 +42,21 @@ namespace tl
             //! Cancel pending requests.
             virtual void cancelRequests() = 0;
 
+            //! Get the average time in seconds it takes to decode a video
+            //! frame, or zero if it has not been measured. The time is
+            //! measured by the reader, so it does not include the time the
+            //! requests wait in a queue. This function is thread safe.
+            float getVideoDecodeTime() const;
+
         protected:
+            //! Add a measurement of the time it took to decode a video
+            //! frame.
+            void _addVideoDecodeTime(float seconds);
+
             std::vector<ftk::InMemoryFile> _memory;
+
+        private:
+            std::atomic<float> _videoDecodeTime;
         };
 
         //! Base class for read plugins.
@@ -234,11 +234,17 @@ namespace tl
                             {
                                 const int64_t frame = time.value();
                                 const int64_t memoryIndex = seq ? (frame - _startFrame) : 0;
+                                const auto t0 = std::chrono::steady_clock::now();
                                 out = _readVideo(
                                     fileName,
                                     memoryIndex >= 0 && memoryIndex < _memory.size() ? &_memory[memoryIndex] : nullptr,
                                     time,
                                     options);
+                                if (out.image)
+                                {
+                                    const std::chrono::duration<float> diff = std::chrono::steady_clock::now() - t0;
+                                    _addVideoDecodeTime(diff.count());
+                                }
                             }
                             catch (const std::exception&)
                             {
@@ -3,9 +3,16 @@
 
 #include <tlIO/System.h>
 
+#include <tlIO/DPX.h>
+#include <tlIO/FrameCache.h>
+#include <tlIO/YUV.h>
+
 #if defined(TLRENDER_FFMPEG)
 #include <tlIO/FFmpeg.h>
 #endif // TLRENDER_FFMPEG
+#if defined(TLRENDER_JPEG)
+#include <tlIO/JPEG.h>
+#endif // TLRENDER_JPEG
 #if defined(TLRENDER_EXR)
 #include <tlIO/OpenEXR.h>
 #endif // TLRENDER_EXR
@@ -19,19 +26,75 @@
 #include <tlIO/WMF.h>
 #endif // TLRENDER_WMF
 
+#include <tlCore/MemorySystem.h>
+
 #include <ftk/Core/Context.h>
 #include <ftk/Core/String.h>
 
 #include <iomanip>
+#include <map>
+#include <mutex>
 #include <sstream>
+#include <tuple>
 
 namespace tl
 {
     namespace io
     {
+        namespace
+        {
+            const size_t readMaxDefault = 32;
+
+            struct ReadKey
+            {
+                std::string path;
+                std::string number;
+                std::vector<const uint8_t*> memory;
+                Options options;
+
+                bool operator < (const ReadKey& other) const
+                {
+                    return std::tie(path, number, memory, options) <
+                        std::tie(other.path, other.number, other.memory, other.options);
+                }
+            };
+
+            ReadKey getReadKey(
+                const file::Path& path,
+                const std::vector<ftk::InMemoryFile>& memory,
+                const Options& options)
+            {
+                ReadKey out;
+                out.path = path.get();
+                out.number = path.getNumber();
+                for (const auto& i : memory)
+                {
+                    out.memory.push_back(i.p);
+                }
+                out.options = options;
+                return out;
+            }
+        }
+
         struct ReadSystem::Private
         {
             std::vector<std::string> names;
+            std::weak_ptr<memory::System> memorySystem;
+            int memoryCache = 0;
+
+            struct PoolRead
+            {
+                std::shared_ptr<IRead> read;
+                uint64_t lastUse = 0;
+            };
+            struct Mutex
+            {
+                std::map<ReadKey, PoolRead> reads;
+                size_t readMax = readMaxDefault;
+                uint64_t counter = 0;
+                std::mutex mutex;
+            };
+            mutable Mutex mutex;
         };
 
         ReadSystem::ReadSystem(const std::shared_ptr<ftk::Context>& context) :
@@ -43,6 +106,12 @@ namespace tl
             if (auto context = _context.lock())
             {
                 auto logSystem = context->getLogSystem();
+                _plugins.push_back(dpx::ReadPlugin::create(logSystem));
+                _plugins.push_back(framecache::ReadPlugin::create(logSystem));
+                _plugins.push_back(yuv::ReadPlugin::create(logSystem));
+#if defined(TLRENDER_JPEG)
+                _plugins.push_back(jpeg::ReadPlugin::create(logSystem));
+#endif // TLRENDER_JPEG
 #if defined(TLRENDER_EXR)
                 _plugins.push_back(exr::ReadPlugin::create(logSystem));
 #endif // TLRENDER_EXR
@@ -65,10 +134,38 @@ namespace tl
             {
                 p.names.push_back(plugin->getName());
             }
+
+#if defined(TLRENDER_USD)
+            // Shrink the USD caches when the memory pressure is high.
+            auto context = _context.lock();
+            auto usdPlugin = getPlugin<usd::ReadPlugin>();
+            if (context && usdPlugin)
+            {
+                if (auto memorySystem = context->getSystem<memory::System>())
+                {
+                    std::weak_ptr<usd::ReadPlugin> usdPluginWeak(usdPlugin);
+                    p.memorySystem = memorySystem;
+                    p.memoryCache = memorySystem->addCache(
+                        [usdPluginWeak](float value)
+                        {
+                            if (auto usdPlugin = usdPluginWeak.lock())
+                            {
+                                usdPlugin->setCacheScale(value);
+                            }
+                        });
+                }
+            }
+#endif // TLRENDER_USD
         }
 
         ReadSystem::~ReadSystem()
-        {}
+        {
+            FTK_P();
+            if (auto memorySystem = p.memorySystem.lock())
+            {
+                memorySystem->removeCache(p.memoryCache);
+            }
+        }
 
         std::shared_ptr<ReadSystem> ReadSystem::create(const std::shared_ptr<ftk::Context>& context)
         {
@@ -178,6 +275,127 @@ namespace tl
             return nullptr;
         }
 
+        std::shared_ptr<IRead> ReadSystem::getRead(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const Options& options)
+        {
+            FTK_P();
+            std::shared_ptr<IRead> out;
+            const ReadKey key = getReadKey(path, memory, options);
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                const auto i = p.mutex.reads.find(key);
+                if (i != p.mutex.reads.end())
+                {
+                    i->second.lastUse = ++p.mutex.counter;
+                    out = i->second.read;
+                }
+            }
+            if (!out)
+            {
+                // Create the reader without holding the lock, if another
+                // consumer created the same reader in the meantime then use
+                // that one instead.
+                out = read(path, memory, options);
+                if (out)
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    auto& poolRead = p.mutex.reads[key];
+                    if (poolRead.read)
+                    {
+                        out = poolRead.read;
+                    }
+                    else
+                    {
+                        poolRead.read = out;
+                    }
+                    poolRead.lastUse = ++p.mutex.counter;
+                }
+            }
+
+            // Readers that were held by consumers when the pool was full
+            // may be idle now.
+            _readMaxUpdate();
+            return out;
+        }
+
+        size_t ReadSystem::getReadMax() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.readMax;
+        }
+
+        void ReadSystem::setReadMax(size_t value)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.readMax = value;
+            }
+            _readMaxUpdate();
+        }
+
+        size_t ReadSystem::getReadCount() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.reads.size();
+        }
+
+        void ReadSystem::clearReads()
+        {
+            FTK_P();
+            std::vector<std::shared_ptr<IRead> > reads;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                auto i = p.mutex.reads.begin();
+                while (i != p.mutex.reads.end())
+                {
+                    if (1 == i->second.read.use_count())
+                    {
+                        reads.push_back(i->second.read);
+                        i = p.mutex.reads.erase(i);
+                    }
+                    else
+                    {
+                        ++i;
+                    }
+                }
+            }
+        }
+
+        void ReadSystem::_readMaxUpdate()
+        {
+            FTK_P();
+
+            // The readers are destroyed outside of the lock since closing a
+            // reader may need to wait for its threads to finish.
+            std::vector<std::shared_ptr<IRead> > reads;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                while (p.mutex.reads.size() > p.mutex.readMax)
+                {
+                    auto oldest = p.mutex.reads.end();
+                    for (auto i = p.mutex.reads.begin(); i != p.mutex.reads.end(); ++i)
+                    {
+                        if (1 == i->second.read.use_count() &&
+                            (oldest == p.mutex.reads.end() || i->second.lastUse < oldest->second.lastUse))
+                        {
+                            oldest = i;
+                        }
+                    }
+                    if (oldest == p.mutex.reads.end())
+                    {
+                        break;
+                    }
+                    reads.push_back(oldest->second.read);
+                    p.mutex.reads.erase(oldest);
+                }
+            }
+        }
+
         struct WriteSystem::Private
         {
             std::vector<std::string> names;
@@ -192,6 +410,7 @@ namespace tl
             if (auto context = _context.lock())
             {
                 auto logSystem = context->getLogSystem();
+                _plugins.push_back(framecache::WritePlugin::create(logSystem));
 #if defined(TLRENDER_EXR)
                 _plugins.push_back(exr::WritePlugin::create(logSystem));
 #endif // TLRENDER_EXR
@@ -64,7 +64,39 @@ namespace tl
                 const std::vector<ftk::InMemoryFile>&,
                 const Options& = Options());
 
+            //! \name Reader Pool
+            //! Readers in the pool are shared by consumers that open the same
+            //! path and memory locations with the same options. Consumers
+            //! with conflicting access patterns, like playback and
+            //! thumbnails, can be kept apart by using different options.
+            ///@{
+
+            //! Get a reader from the pool, creating it if necessary.
+            std::shared_ptr<IRead> getRead(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const Options& = Options());
+
+            //! Get the maximum number of readers in the pool. When the
+            //! maximum is exceeded the least recently used readers that
+            //! are not held by any consumers are closed. Readers that are
+            //! held are closed by a later request once they are released.
+            size_t getReadMax() const;
+
+            //! Set the maximum number of readers in the pool.
+            void setReadMax(size_t);
+
+            //! Get the number of readers in the pool.
+            size_t getReadCount() const;
+
+            //! Remove the readers that are not held by any consumers.
+            void clearReads();
+
+            ///@}
+
         private:
+            void _readMaxUpdate();
+
             std::vector<std::shared_ptr<IReadPlugin> > _plugins;
 
             FTK_PRIVATE();
@@ -117,6 +117,11 @@ namespace tl
             return Read::create(id, p.render, path, options, _logSystem.lock());
         }
 
+        void ReadPlugin::setCacheScale(float value)
+        {
+            _p->render->setCacheScale(value);
+        }
+
         void to_json(nlohmann::json& json, const Options& value)
         {
             json["RenderWidth"] = value.renderWidth;
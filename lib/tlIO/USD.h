@@ -104,6 +104,9 @@ namespace tl
                 const file::Path&,
                 const std::vector<ftk::InMemoryFile>&,
                 const io::Options& = io::Options()) override;
+
+            //! Set the scale applied to the stage and disk cache sizes.
+            void setCacheScale(float);
                 
         private:
             FTK_PRIVATE();
@@ -47,6 +47,9 @@ namespace tl
             //! Cancel requests.
             void cancelRequests(int64_t id);
 
+            //! Set the scale applied to the stage and disk cache sizes.
+            void setCacheScale(float);
+
         private:
             void _open(
                 const std::string&,
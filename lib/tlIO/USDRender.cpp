@@ -32,6 +32,7 @@
 
 #include <SDL2/SDL.h>
 
+#include <algorithm>
 #include <filesystem>
 
 using namespace PXR_NS;
@@ -85,6 +86,7 @@ namespace tl
             {
                 std::list<std::shared_ptr<InfoRequest> > infoRequests;
                 std::list<std::shared_ptr<Request> > requests;
+                float cacheScale = 1.F;
                 bool stopped = false;
                 std::mutex mutex;
             };
@@ -371,6 +373,13 @@ namespace tl
                 request->promise.set_value(io::VideoData());
             }
         }
+
+        void Render::setCacheScale(float value)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.cacheScale = value;
+        }
                         
         namespace
         {
@@ -525,8 +534,10 @@ namespace tl
                 // Check requests.
                 std::shared_ptr<Private::InfoRequest> infoRequest;
                 std::shared_ptr<Private::Request> request;
+                float cacheScale = 1.F;
                 {
                     std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    cacheScale = p.mutex.cacheScale;
                     if (p.thread.cv.wait_for(
                         lock,
                         std::chrono::milliseconds(5),
@@ -570,8 +581,10 @@ namespace tl
                 {
                     diskCacheByteCount = std::atoll(i->second.c_str());
                 }
-                p.thread.stageCache.setMax(stageCacheCount);
-                p.thread.diskCache.setMax(diskCacheByteCount);
+                p.thread.stageCache.setMax(std::max(
+                    static_cast<size_t>(stageCacheCount * cacheScale),
+                    size_t(1)));
+                p.thread.diskCache.setMax(diskCacheByteCount * cacheScale);
                 if (diskCacheByteCount > 0 && p.thread.tempDir.empty())
                 {
                     p.thread.tempDir = std::tmpnam(nullptr);
@@ -1317,7 +1317,13 @@ namespace tl
                 {
                     io::VideoData data;
                     data.time = videoRequest->time;
+                    const auto t0 = std::chrono::steady_clock::now();
                     data.image = wmf.readImage(videoRequest->time);
+                    if (data.image)
+                    {
+                        const std::chrono::duration<float> diff = std::chrono::steady_clock::now() - t0;
+                        _addVideoDecodeTime(diff.count());
+                    }
                     videoRequest->promise.set_value(data);
                     p.thread.videoTime += OTIO_NS::RationalTime(1.0, p.info.videoTime.duration().rate());
                 }
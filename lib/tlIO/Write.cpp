@@ -25,6 +25,20 @@ namespace tl
         IWrite::~IWrite()
         {}
 
+        void IWrite::writeAudio(
+            const OTIO_NS::TimeRange&,
+            const std::shared_ptr<audio::Audio>&,
+            const Options&)
+        {}
+
+        bool IWrite::hasAudio() const
+        {
+            return false;
+        }
+
+        void IWrite::finish()
+        {}
+
         struct IWritePlugin::Private
         {
         };
@@ -30,6 +30,21 @@ namespace tl
                 const std::shared_ptr<ftk::Image>&,
                 const Options& = Options()) = 0;
 
+            //! Write audio data. Writers that do not support audio ignore
+            //! the data.
+            virtual void writeAudio(
+                const OTIO_NS::TimeRange&,
+                const std::shared_ptr<audio::Audio>&,
+                const Options& = Options());
+
+            //! Get whether the writer supports audio.
+            virtual bool hasAudio() const;
+
+            //! Finish writing the file. This is called after the last frame
+            //! has been written, writers that need to finalize the file do
+            //! it here. A file that is not finished may be incomplete.
+            virtual void finish();
+
         protected:
             Info _info;
         };
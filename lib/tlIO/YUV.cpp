@@ -0,0 +1,412 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/YUVPrivate.h>
+
+#include <ftk/Core/Error.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/Memory.h>
+#include <ftk/Core/String.h>
+
+#include <cstdlib>
+#include <cstring>
+
+namespace tl
+{
+    namespace yuv
+    {
+        FTK_ENUM_IMPL(
+            Format,
+            "Gray",
+            "YUV420",
+            "YUV422",
+            "YUV444");
+
+        bool Options::operator == (const Options& other) const
+        {
+            return
+                width == other.width &&
+                height == other.height &&
+                format == other.format &&
+                bitDepth == other.bitDepth &&
+                speed == other.speed;
+        }
+
+        bool Options::operator != (const Options& other) const
+        {
+            return !(*this == other);
+        }
+
+        io::Options getOptions(const Options& value)
+        {
+            io::Options out;
+            out["YUV/Width"] = ftk::Format("{0}").arg(value.width);
+            out["YUV/Height"] = ftk::Format("{0}").arg(value.height);
+            out["YUV/Format"] = to_string(value.format);
+            out["YUV/BitDepth"] = ftk::Format("{0}").arg(value.bitDepth);
+            out["YUV/Speed"] = ftk::Format("{0}").arg(value.speed);
+            return out;
+        }
+
+        size_t Header::getFrameOffset(size_t frame) const
+        {
+            return !frameOffsets.empty() ?
+                frameOffsets[frame] :
+                (dataOffset + frame * frameByteCount);
+        }
+
+        namespace
+        {
+            ftk::Size2I getChromaSize(const ftk::Size2I& size, Format format)
+            {
+                ftk::Size2I out;
+                switch (format)
+                {
+                case Format::YUV420: out = ftk::Size2I((size.w + 1) / 2, (size.h + 1) / 2); break;
+                case Format::YUV422: out = ftk::Size2I((size.w + 1) / 2, size.h); break;
+                case Format::YUV444: out = size; break;
+                default: break;
+                }
+                return out;
+            }
+
+            bool parseRatio(const std::string& value, int& num, int& den)
+            {
+                const auto pieces = ftk::split(value, ':');
+                if (2 == pieces.size())
+                {
+                    num = std::atoi(pieces[0].c_str());
+                    den = std::atoi(pieces[1].c_str());
+                    return true;
+                }
+                return false;
+            }
+
+            bool parseColorSpace(const std::string& value, Format& format, int& bitDepth)
+            {
+                std::string rest;
+                if (0 == value.compare(0, 4, "mono"))
+                {
+                    format = Format::Gray;
+                    rest = value.substr(4);
+                    bitDepth = rest.empty() ? 8 : std::atoi(rest.c_str());
+                }
+                else
+                {
+                    if (0 == value.compare(0, 3, "420"))
+                    {
+                        format = Format::YUV420;
+                    }
+                    else if (0 == value.compare(0, 3, "422"))
+                    {
+                        format = Format::YUV422;
+                    }
+                    else if (0 == value.compare(0, 3, "444"))
+                    {
+                        format = Format::YUV444;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                    rest = value.substr(3);
+                    if (!rest.empty() && 'p' == rest[0])
+                    {
+                        bitDepth = std::atoi(rest.c_str() + 1);
+                    }
+                    else if (rest.empty() ||
+                        "jpeg" == rest ||
+                        "paldv" == rest ||
+                        "mpeg2" == rest)
+                    {
+                        bitDepth = 8;
+                    }
+                    else
+                    {
+                        return false;
+                    }
+                }
+                return bitDepth >= 8 && bitDepth <= 16;
+            }
+        }
+
+        size_t getFrameByteCount(const ftk::Size2I& size, Format format, int bitDepth)
+        {
+            const size_t sampleByteCount = bitDepth > 8 ? 2 : 1;
+            const ftk::Size2I chromaSize = getChromaSize(size, format);
+            return
+                (size.w * size.h + chromaSize.w * chromaSize.h * 2) *
+                sampleByteCount;
+        }
+
+        Header readY4MHeader(
+            const uint8_t* p,
+            size_t size,
+            const std::string& fileName)
+        {
+            Header out;
+
+            // Read the stream header.
+            const uint8_t* end = p + size;
+            const uint8_t* lineEnd = static_cast<const uint8_t*>(std::memchr(p, '\n', size));
+            if (size < 9 || std::memcmp(p, "YUV4MPEG2", 9) != 0 || !lineEnd)
+            {
+                throw std::runtime_error(ftk::Format("Bad magic number: \"{0}\"").arg(fileName));
+            }
+            const std::string line(reinterpret_cast<const char*>(p) + 9, lineEnd);
+            for (const auto& token : ftk::split(line, ' '))
+            {
+                if (token.empty())
+                {
+                    continue;
+                }
+                const std::string value = token.substr(1);
+                int num = 0;
+                int den = 0;
+                switch (token[0])
+                {
+                case 'W': out.size.w = std::atoi(value.c_str()); break;
+                case 'H': out.size.h = std::atoi(value.c_str()); break;
+                case 'F':
+                    if (parseRatio(value, num, den) && num > 0 && den > 0)
+                    {
+                        out.speed = num / static_cast<double>(den);
+                    }
+                    break;
+                case 'A':
+                    if (parseRatio(value, num, den) && num > 0 && den > 0)
+                    {
+                        out.pixelAspectRatio = num / static_cast<float>(den);
+                    }
+                    break;
+                case 'C':
+                    if (!parseColorSpace(value, out.format, out.bitDepth))
+                    {
+                        throw std::runtime_error(ftk::Format("Unsupported color space: \"{0}\"").
+                            arg(fileName));
+                    }
+                    break;
+                case 'X':
+                    if ("COLORRANGE=FULL" == value)
+                    {
+                        out.videoLevels = ftk::VideoLevels::FullRange;
+                    }
+                    break;
+                default: break;
+                }
+            }
+            if (out.size.w <= 0 || out.size.h <= 0)
+            {
+                throw std::runtime_error(ftk::Format("Bad size: \"{0}\"").arg(fileName));
+            }
+            out.dataOffset = lineEnd + 1 - p;
+            out.frameByteCount = getFrameByteCount(out.size, out.format, out.bitDepth);
+
+            // Index the frames. Each frame header starts with "FRAME" and
+            // ends with a newline, the parameters in between are ignored. A
+            // truncated last frame is not indexed.
+            const uint8_t* frame = lineEnd + 1;
+            while (frame < end)
+            {
+                const uint8_t* frameEnd = static_cast<const uint8_t*>(std::memchr(frame, '\n', end - frame));
+                if (end - frame < 5 || std::memcmp(frame, "FRAME", 5) != 0 || !frameEnd)
+                {
+                    throw std::runtime_error(ftk::Format("Bad frame header: \"{0}\"").arg(fileName));
+                }
+                const uint8_t* frameData = frameEnd + 1;
+                if (static_cast<size_t>(end - frameData) < out.frameByteCount)
+                {
+                    break;
+                }
+                out.frameOffsets.push_back(frameData - p);
+                frame = frameData + out.frameByteCount;
+            }
+            out.frameCount = out.frameOffsets.size();
+            return out;
+        }
+
+        Header getRawHeader(
+            const io::Options& options,
+            size_t size,
+            const std::string& fileName)
+        {
+            Header out;
+            auto i = options.find("YUV/Width");
+            if (i != options.end())
+            {
+                out.size.w = std::atoi(i->second.c_str());
+            }
+            i = options.find("YUV/Height");
+            if (i != options.end())
+            {
+                out.size.h = std::atoi(i->second.c_str());
+            }
+            i = options.find("YUV/Format");
+            if (i != options.end())
+            {
+                from_string(i->second, out.format);
+            }
+            i = options.find("YUV/BitDepth");
+            if (i != options.end())
+            {
+                out.bitDepth = std::atoi(i->second.c_str());
+            }
+            i = options.find("YUV/Speed");
+            if (i != options.end())
+            {
+                out.speed = std::atof(i->second.c_str());
+            }
+            if (out.size.w <= 0 || out.size.h <= 0)
+            {
+                throw std::runtime_error(ftk::Format("No size given for raw YUV: \"{0}\"").arg(fileName));
+            }
+            if (out.bitDepth < 8 || out.bitDepth > 16 || out.speed <= 0.0)
+            {
+                throw std::runtime_error(ftk::Format("Unsupported format: \"{0}\"").arg(fileName));
+            }
+            out.frameByteCount = getFrameByteCount(out.size, out.format, out.bitDepth);
+            out.frameCount = size / out.frameByteCount;
+            return out;
+        }
+
+        ftk::ImageInfo getImageInfo(const Header& header)
+        {
+            ftk::ImageInfo out;
+            out.size = header.size;
+            const bool u16 = header.bitDepth > 8;
+            switch (header.format)
+            {
+            case Format::Gray:
+                out.type = u16 ? ftk::ImageType::L_U16 : ftk::ImageType::L_U8;
+                break;
+            case Format::YUV420:
+                out.type = u16 ? ftk::ImageType::YUV_420P_U16 : ftk::ImageType::YUV_420P_U8;
+                break;
+            case Format::YUV422:
+                out.type = u16 ? ftk::ImageType::YUV_422P_U16 : ftk::ImageType::YUV_422P_U8;
+                break;
+            case Format::YUV444:
+                out.type = u16 ? ftk::ImageType::YUV_444P_U16 : ftk::ImageType::YUV_444P_U8;
+                break;
+            default: break;
+            }
+            out.pixelAspectRatio = header.pixelAspectRatio;
+            out.videoLevels = header.videoLevels;
+            out.layout.mirror.y = true;
+            return out;
+        }
+
+        namespace
+        {
+            //! Copy a plane, cropping the chroma planes of odd sized images
+            //! and expanding 9 to 15 bit samples to 16 bits.
+            void copyPlane(
+                const uint8_t* in,
+                int inWidth,
+                uint8_t* out,
+                const ftk::Size2I& outSize,
+                int bitDepth)
+            {
+                if (8 == bitDepth)
+                {
+                    for (int y = 0; y < outSize.h; ++y)
+                    {
+                        std::memcpy(out + y * outSize.w, in + y * inWidth, outSize.w);
+                    }
+                }
+                else
+                {
+                    const bool swapEndian = ftk::getEndian() != ftk::Endian::LSB;
+                    const int shift = 16 - bitDepth;
+                    for (int y = 0; y < outSize.h; ++y)
+                    {
+                        const uint8_t* inP = in + y * inWidth * 2;
+                        uint16_t* outP = reinterpret_cast<uint16_t*>(out) + y * outSize.w;
+                        for (int x = 0; x < outSize.w; ++x, inP += 2)
+                        {
+                            const uint16_t v = swapEndian ?
+                                (inP[0] << 8 | inP[1]) :
+                                (inP[0] | inP[1] << 8);
+                            outP[x] = shift > 0 ?
+                                static_cast<uint16_t>((v << shift) | (v >> (bitDepth - shift))) :
+                                v;
+                        }
+                    }
+                }
+            }
+        }
+
+        void copyFrame(
+            const uint8_t* in,
+            const Header& header,
+            const std::shared_ptr<ftk::Image>& image)
+        {
+            const ftk::Size2I& size = header.size;
+            const ftk::Size2I chromaSize = getChromaSize(size, header.format);
+            const size_t sampleByteCount = header.bitDepth > 8 ? 2 : 1;
+            uint8_t* out = image->getData();
+            const size_t byteCount = image->getInfo().getByteCount();
+            if (byteCount == header.frameByteCount &&
+                (8 == header.bitDepth ||
+                (16 == header.bitDepth && ftk::getEndian() == ftk::Endian::LSB)))
+            {
+                // The layouts match, copy the whole frame.
+                std::memcpy(out, in, byteCount);
+            }
+            else
+            {
+                ftk::Size2I outChromaSize;
+                switch (header.format)
+                {
+                case Format::YUV420: outChromaSize = ftk::Size2I(size.w / 2, size.h / 2); break;
+                case Format::YUV422: outChromaSize = ftk::Size2I(size.w / 2, size.h); break;
+                case Format::YUV444: outChromaSize = size; break;
+                default: break;
+                }
+                copyPlane(in, size.w, out, size, header.bitDepth);
+                in += size.w * size.h * sampleByteCount;
+                out += size.w * size.h * sampleByteCount;
+                for (int i = 0; i < 2 && outChromaSize.w > 0; ++i)
+                {
+                    copyPlane(in, chromaSize.w, out, outChromaSize, header.bitDepth);
+                    in += chromaSize.w * chromaSize.h * sampleByteCount;
+                    out += outChromaSize.w * outChromaSize.h * sampleByteCount;
+                }
+            }
+        }
+
+        void ReadPlugin::_init(const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            IReadPlugin::_init(
+                "YUV",
+                {
+                    { ".y4m", io::FileType::Media },
+                    { ".yuv", io::FileType::Media }
+                },
+                logSystem);
+        }
+
+        std::shared_ptr<ReadPlugin> ReadPlugin::create(
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<ReadPlugin>(new ReadPlugin);
+            out->_init(logSystem);
+            return out;
+        }
+
+        std::shared_ptr<io::IRead> ReadPlugin::read(
+            const file::Path& path,
+            const io::Options& options)
+        {
+            return Read::create(path, options, _logSystem.lock());
+        }
+
+        std::shared_ptr<io::IRead> ReadPlugin::read(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options)
+        {
+            return Read::create(path, memory, options, _logSystem.lock());
+        }
+    }
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlIO/Read.h>
+
+namespace tl
+{
+    //! Y4M and raw YUV video I/O.
+    namespace yuv
+    {
+        //! Chroma formats.
+        enum class Format
+        {
+            Gray,
+            YUV420,
+            YUV422,
+            YUV444,
+
+            Count,
+            First = Gray
+        };
+        FTK_ENUM(Format);
+
+        //! Raw YUV options. Y4M files store this information in the file
+        //! header, so these options are only used for raw files.
+        struct Options
+        {
+            int    width    = 0;
+            int    height   = 0;
+            Format format   = Format::YUV420;
+            int    bitDepth = 8;
+            double speed    = 24.0;
+
+            bool operator == (const Options&) const;
+            bool operator != (const Options&) const;
+        };
+
+        //! Get raw YUV options.
+        io::Options getOptions(const Options&);
+
+        //! Y4M and raw YUV reader.
+        //!
+        //! Y4M frame offsets are indexed when the file is opened and raw
+        //! frames are stored at a fixed stride, so seeking is constant time.
+        //! The frames are copied by a fixed number of worker threads.
+        class Read : public io::IRead
+        {
+        protected:
+            void _init(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            Read();
+
+        public:
+            virtual ~Read();
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            //! Create a new reader.
+            static std::shared_ptr<Read> create(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options&,
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            std::future<io::Info> getInfo() override;
+            std::future<io::VideoData> readVideo(
+                const OTIO_NS::RationalTime&,
+                const io::Options& = io::Options()) override;
+            void cancelRequests() override;
+
+        private:
+            FTK_PRIVATE();
+        };
+
+        //! Y4M and raw YUV read plugin.
+        class ReadPlugin : public io::IReadPlugin
+        {
+        protected:
+            void _init(const std::shared_ptr<ftk::LogSystem>&);
+
+            ReadPlugin() = default;
+
+        public:
+            //! Create a new plugin.
+            static std::shared_ptr<ReadPlugin> create(
+                const std::shared_ptr<ftk::LogSystem>&);
+
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const io::Options& = io::Options()) override;
+            std::shared_ptr<io::IRead> read(
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&,
+                const io::Options& = io::Options()) override;
+        };
+    }
+}
@@ -0,0 +1,55 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlIO/YUV.h>
+
+namespace tl
+{
+    namespace yuv
+    {
+        //! Video header.
+        struct Header
+        {
+            ftk::Size2I      size;
+            Format           format           = Format::YUV420;
+            int              bitDepth         = 8;
+            double           speed            = 24.0;
+            float            pixelAspectRatio = 1.F;
+            ftk::VideoLevels videoLevels      = ftk::VideoLevels::LegalRange;
+            size_t           dataOffset       = 0;
+            size_t           frameByteCount   = 0;
+            size_t           frameCount       = 0;
+
+            //! Byte offsets of the frame data. Y4M frame headers can have
+            //! parameters and vary in size, so the offsets are indexed when
+            //! the file is opened. Raw files leave this empty.
+            std::vector<size_t> frameOffsets;
+
+            //! Get the byte offset of a frame's data.
+            size_t getFrameOffset(size_t frame) const;
+        };
+
+        //! Get the number of bytes in a frame.
+        size_t getFrameByteCount(const ftk::Size2I&, Format, int bitDepth);
+
+        //! Read a Y4M header.
+        Header readY4MHeader(
+            const uint8_t*,
+            size_t size,
+            const std::string& fileName);
+
+        //! Get a raw YUV header from the options.
+        Header getRawHeader(
+            const io::Options&,
+            size_t size,
+            const std::string& fileName);
+
+        //! Get the image information.
+        ftk::ImageInfo getImageInfo(const Header&);
+
+        //! Copy frame data into an image.
+        void copyFrame(const uint8_t*, const Header&, const std::shared_ptr<ftk::Image>&);
+    }
+}
@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIO/YUVPrivate.h>
+#include <tlIO/FileDataPrivate.h>
+
+#include <ftk/Core/LogSystem.h>
+#include <ftk/Core/String.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+
+namespace tl
+{
+    namespace yuv
+    {
+        namespace
+        {
+            const size_t threadCount = 4;
+        }
+
+        struct Read::Private
+        {
+            io::VideoData readVideo(const OTIO_NS::RationalTime&) const;
+
+            std::string fileName;
+            std::shared_ptr<io::FileData> data;
+            Header header;
+            io::Info info;
+
+            struct VideoRequest
+            {
+                OTIO_NS::RationalTime time = time::invalidTime;
+                std::promise<io::VideoData> promise;
+            };
+
+            struct Mutex
+            {
+                std::list<std::shared_ptr<VideoRequest> > videoRequests;
+                bool stopped = false;
+                std::mutex mutex;
+            };
+            Mutex mutex;
+
+            struct Thread
+            {
+                std::condition_variable cv;
+                std::vector<std::thread> threads;
+            };
+            Thread thread;
+        };
+
+        void Read::_init(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            IRead::_init(path, memory, options, logSystem);
+            FTK_P();
+            p.fileName = path.get();
+            try
+            {
+                p.data = std::make_shared<io::FileData>(p.fileName, !_memory.empty() ? &_memory[0] : nullptr);
+                p.header = ".y4m" == ftk::toLower(path.getExtension()) ?
+                    readY4MHeader(p.data->p, p.data->size, p.fileName) :
+                    getRawHeader(options, p.data->size, p.fileName);
+                p.info.video.push_back(getImageInfo(p.header));
+                p.info.videoTime = OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(0.0, p.header.speed),
+                    OTIO_NS::RationalTime(p.header.frameCount, p.header.speed));
+            }
+            catch (const std::exception& e)
+            {
+                p.data.reset();
+                p.info = io::Info();
+                if (logSystem)
+                {
+                    logSystem->print(
+                        "tl::io::yuv::Read",
+                        e.what(),
+                        ftk::LogType::Error);
+                }
+            }
+
+            // The frames are copied from the memory mapping by a fixed
+            // number of worker threads.
+            if (p.data)
+            {
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    p.thread.threads.push_back(std::thread(
+                        [this]
+                        {
+                            FTK_P();
+                            while (true)
+                            {
+                                std::shared_ptr<Private::VideoRequest> request;
+                                {
+                                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                                    p.thread.cv.wait(
+                                        lock,
+                                        [this]
+                                        {
+                                            return
+                                                _p->mutex.stopped ||
+                                                !_p->mutex.videoRequests.empty();
+                                        });
+                                    if (p.mutex.stopped)
+                                    {
+                                        break;
+                                    }
+                                    request = p.mutex.videoRequests.front();
+                                    p.mutex.videoRequests.pop_front();
+                                }
+                                io::VideoData videoData;
+                                videoData.time = request->time;
+                                try
+                                {
+                                    const auto t0 = std::chrono::steady_clock::now();
+                                    videoData = p.readVideo(request->time);
+                                    if (videoData.image)
+                                    {
+                                        const std::chrono::duration<float> diff = std::chrono::steady_clock::now() - t0;
+                                        _addVideoDecodeTime(diff.count());
+                                    }
+                                }
+                                catch (const std::exception&)
+                                {}
+                                request->promise.set_value(videoData);
+                            }
+                        }));
+                }
+            }
+        }
+
+        Read::Read() :
+            _p(new Private)
+        {}
+
+        Read::~Read()
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.stopped = true;
+            }
+            p.thread.cv.notify_all();
+            for (auto& thread : p.thread.threads)
+            {
+                thread.join();
+            }
+            cancelRequests();
+        }
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, {}, options, logSystem);
+            return out;
+        }
+
+        std::shared_ptr<Read> Read::create(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memory,
+            const io::Options& options,
+            const std::shared_ptr<ftk::LogSystem>& logSystem)
+        {
+            auto out = std::shared_ptr<Read>(new Read);
+            out->_init(path, memory, options, logSystem);
+            return out;
+        }
+
+        std::future<io::Info> Read::getInfo()
+        {
+            std::promise<io::Info> promise;
+            auto future = promise.get_future();
+            promise.set_value(_p->info);
+            return future;
+        }
+
+        std::future<io::VideoData> Read::readVideo(
+            const OTIO_NS::RationalTime& time,
+            const io::Options&)
+        {
+            FTK_P();
+            auto request = std::make_shared<Private::VideoRequest>();
+            request->time = time;
+            auto future = request->promise.get_future();
+            bool valid = false;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (p.data && !p.mutex.stopped)
+                {
+                    valid = true;
+                    p.mutex.videoRequests.push_back(request);
+                }
+            }
+            if (valid)
+            {
+                p.thread.cv.notify_one();
+            }
+            else
+            {
+                io::VideoData videoData;
+                videoData.time = time;
+                request->promise.set_value(videoData);
+            }
+            return future;
+        }
+
+        void Read::cancelRequests()
+        {
+            FTK_P();
+            std::list<std::shared_ptr<Private::VideoRequest> > videoRequests;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                videoRequests = std::move(p.mutex.videoRequests);
+                p.mutex.videoRequests.clear();
+            }
+            for (auto& request : videoRequests)
+            {
+                io::VideoData videoData;
+                videoData.time = request->time;
+                request->promise.set_value(videoData);
+            }
+        }
+
+        io::VideoData Read::Private::readVideo(const OTIO_NS::RationalTime& time) const
+        {
+            io::VideoData out;
+            out.time = time;
+            const int64_t frame = static_cast<int64_t>(time.rescaled_to(header.speed).round().value());
+            if (frame >= 0 && frame < static_cast<int64_t>(header.frameCount))
+            {
+                out.image = ftk::Image::create(info.video[0]);
+                copyFrame(data->p + header.getFrameOffset(frame), header, out.image);
+            }
+            return out;
+        }
+    }
+}
@@ -13,6 +13,8 @@
 #include <ftk/UI/DialogSystem.h>
 #include <ftk/UI/FileBrowser.h>
 #include <ftk/Core/File.h>
+#include <ftk/Core/FileIO.h>
+#include <ftk/Core/LogSystem.h>
 
 namespace tl
 {
@@ -26,13 +28,18 @@ namespace tl
                 "input",
                 "One or more timelines, movies, or image sequences.",
                 true);
+            _cmdLine.stats = ftk::CmdLineValueOption<std::string>::create(
+                { "-stats" },
+                "Write the playback statistics to a JSON file on exit.",
+                "Playback");
 
             ftk::App::_init(
                 context,
                 argv,
                 "tlplay",
                 "Example player application.",
-                { _cmdLine.inputs });
+                { _cmdLine.inputs },
+                { _cmdLine.stats });
         }
 
         App::~App()
@@ -151,6 +158,33 @@ namespace tl
             }
 
             ftk::App::run();
+
+            if (_cmdLine.stats->hasValue())
+            {
+                _writeStats(_cmdLine.stats->getValue());
+            }
+        }
+
+        void App::_writeStats(const std::string& fileName)
+        {
+            try
+            {
+                nlohmann::json json = nlohmann::json::array();
+                for (const auto& player : _filesModel->observePlayers()->get())
+                {
+                    nlohmann::json item;
+                    item["Path"] = player->getPath().get();
+                    item["Stats"] = player->observeStats()->get();
+                    json.push_back(item);
+                }
+                const std::string s = json.dump(4);
+                auto fileIO = ftk::FileIO::create(fileName, ftk::FileMode::Write);
+                fileIO->write(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+            }
+            catch (const std::exception& e)
+            {
+                _context->getLogSystem()->print("tl::play::App", e.what(), ftk::LogType::Error);
+            }
         }
 
         void App::_tick()
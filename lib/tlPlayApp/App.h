@@ -56,9 +56,12 @@ namespace tl
             void _tick() override;
 
         private:
+            void _writeStats(const std::string&);
+
             struct CmdLine
             {
                 std::shared_ptr<ftk::CmdLineListArg<std::string> > inputs;
+                std::shared_ptr<ftk::CmdLineValueOption<std::string> > stats;
             };
             CmdLine _cmdLine;
 
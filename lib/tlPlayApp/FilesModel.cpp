@@ -5,6 +5,12 @@
 
 #include "SettingsModel.h"
 
+#include <tlTimeline/PlayerCache.h>
+
+#include <ftk/Core/Context.h>
+
+#include <algorithm>
+
 namespace tl
 {
     namespace play
@@ -21,16 +27,60 @@ namespace tl
             _bPlayerIndex = ftk::ObservableValue<int>::create(-1);
             _compare = ftk::ObservableValue<timeline::Compare>::create(timeline::Compare::A);
 
+            // The cache settings are shared between all of the players,
+            // the current player gets the largest part. The files next to
+            // the current file are preloaded with a separate budget.
             _cacheObserver = ftk::ValueObserver<timeline::PlayerCacheOptions>::create(
                 settingsModel->observeCache(),
                 [this](const timeline::PlayerCacheOptions& value)
                 {
                     _cacheOptions = value;
+                    _cacheBudgetUpdate();
                     for (const auto& player : _players->get())
                     {
                         player->setCacheOptions(value);
                     }
                 });
+
+            _preloadObserver = ftk::ValueObserver<PreloadSettings>::create(
+                settingsModel->observePreload(),
+                [this](const PreloadSettings& value)
+                {
+                    _preload = value;
+                    _cacheBudgetUpdate();
+                    _cachePriorityUpdate();
+                });
+
+            _diskCacheObserver = ftk::ValueObserver<io::DiskCacheOptions>::create(
+                settingsModel->observeDiskCache(),
+                [this](const io::DiskCacheOptions& value)
+                {
+                    if (auto context = _context.lock())
+                    {
+                        context->getSystem<io::DiskCacheSystem>()->setOptions(value);
+                    }
+                });
+
+            _playersObserver = ftk::ListObserver<std::shared_ptr<timeline::Player> >::create(
+                _players,
+                [this](const std::vector<std::shared_ptr<timeline::Player> >&)
+                {
+                    _cachePriorityUpdate();
+                });
+
+            _playerObserver = ftk::ValueObserver<std::shared_ptr<timeline::Player> >::create(
+                _player,
+                [this](const std::shared_ptr<timeline::Player>&)
+                {
+                    _cachePriorityUpdate();
+                });
+
+            _bPlayerObserver = ftk::ValueObserver<std::shared_ptr<timeline::Player> >::create(
+                _bPlayer,
+                [this](const std::shared_ptr<timeline::Player>&)
+                {
+                    _cachePriorityUpdate();
+                });
         }
 
         FilesModel::~FilesModel()
@@ -246,6 +296,56 @@ namespace tl
                 player->tick();
             }
         }
+
+        void FilesModel::_cacheBudgetUpdate()
+        {
+            if (auto context = _context.lock())
+            {
+                if (auto cacheSystem = context->getSystem<timeline::PlayerCacheSystem>())
+                {
+                    timeline::PlayerCacheBudget budget;
+                    budget.videoGB = _cacheOptions.videoGB;
+                    budget.audioGB = _cacheOptions.audioGB;
+                    budget.videoCompressedGB = _cacheOptions.videoCompressedGB;
+                    budget.preloadVideoGB = _preload.videoGB;
+                    budget.preloadFrames = std::max(_preload.frames, 1);
+                    cacheSystem->setBudget(budget);
+                }
+            }
+        }
+
+        void FilesModel::_cachePriorityUpdate()
+        {
+            const auto player = _player->get();
+            const auto bPlayer = _bPlayer->get();
+            const auto& players = _players->get();
+            const int size = static_cast<int>(players.size());
+            const int index = _players->indexOf(player) != ftk::ObservableListInvalidIndex ?
+                static_cast<int>(_players->indexOf(player)) :
+                -1;
+            for (int i = 0; i < size; ++i)
+            {
+                // Next and previous wrap around the list, so the distance
+                // to the current file does too.
+                timeline::PlayerCachePriority priority = timeline::PlayerCachePriority::Background;
+                if (players[i] == player)
+                {
+                    priority = timeline::PlayerCachePriority::Focused;
+                }
+                else if (players[i] == bPlayer)
+                {
+                    priority = timeline::PlayerCachePriority::Normal;
+                }
+                else if (index >= 0)
+                {
+                    const int diff = std::abs(i - index);
+                    if (std::min(diff, size - diff) <= _preload.count)
+                    {
+                        priority = timeline::PlayerCachePriority::Preload;
+                    }
+                }
+                players[i]->setCachePriority(priority);
+            }
+        }
     }
 }
-
@@ -3,14 +3,12 @@
 
 #pragma once
 
-#include <tlTimeline/Player.h>
+#include "SettingsModel.h"
 
 namespace tl
 {
     namespace play
     {
-        class SettingsModel;
-
         //! Files model.
         class FilesModel : public std::enable_shared_from_this<FilesModel>
         {
@@ -55,6 +53,9 @@ namespace tl
             void tick();
 
         private:
+            void _cacheBudgetUpdate();
+            void _cachePriorityUpdate();
+
             std::weak_ptr<ftk::Context> _context;
             std::shared_ptr<ftk::ObservableList<std::shared_ptr<timeline::Player> > > _players;
             std::shared_ptr<ftk::ObservableValue<std::shared_ptr<timeline::Player> > > _player;
@@ -63,7 +64,13 @@ namespace tl
             std::shared_ptr<ftk::ObservableValue<int> > _bPlayerIndex;
             std::shared_ptr<ftk::ObservableValue<timeline::Compare> > _compare;
             timeline::PlayerCacheOptions _cacheOptions;
+            PreloadSettings _preload;
             std::shared_ptr<ftk::ValueObserver<timeline::PlayerCacheOptions> > _cacheObserver;
+            std::shared_ptr<ftk::ValueObserver<PreloadSettings> > _preloadObserver;
+            std::shared_ptr<ftk::ValueObserver<io::DiskCacheOptions> > _diskCacheObserver;
+            std::shared_ptr<ftk::ListObserver<std::shared_ptr<timeline::Player> > > _playersObserver;
+            std::shared_ptr<ftk::ValueObserver<std::shared_ptr<timeline::Player> > > _playerObserver;
+            std::shared_ptr<ftk::ValueObserver<std::shared_ptr<timeline::Player> > > _bPlayerObserver;
         };
     }
 }
\ No newline at end of file
@@ -200,6 +200,9 @@ namespace tl
             addAction(actions["ResetInPoint"]);
             addAction(actions["SetOutPoint"]);
             addAction(actions["ResetOutPoint"]);
+            addDivider();
+            addAction(actions["PinInOutRange"]);
+            addAction(actions["ClearPinnedRanges"]);
         }
 
         PlaybackMenu::~PlaybackMenu()
@@ -6,6 +6,8 @@
 #include "App.h"
 #include "FilesModel.h"
 
+#include <algorithm>
+
 namespace tl
 {
     namespace play
@@ -185,6 +187,40 @@ namespace tl
                 });
             _actions["ResetOutPoint"]->setTooltip("Reset the playback out point.");
 
+            _actions["PinInOutRange"] = ftk::Action::create(
+                "Pin In/Out Range",
+                ftk::Key::P,
+                0,
+                [this]
+                {
+                    if (_player)
+                    {
+                        auto ranges = _player->getPinnedRanges();
+                        const OTIO_NS::TimeRange& range = _player->getInOutRange();
+                        if (std::find(ranges.begin(), ranges.end(), range) == ranges.end())
+                        {
+                            ranges.push_back(range);
+                            _player->setPinnedRanges(ranges);
+                        }
+                    }
+                });
+            _actions["PinInOutRange"]->setTooltip(
+                "Keep the frames in the playback in/out range cached, so "
+                "switching back to the range does not need to read them again.");
+
+            _actions["ClearPinnedRanges"] = ftk::Action::create(
+                "Clear Pinned Ranges",
+                ftk::Key::P,
+                static_cast<int>(ftk::KeyModifier::Shift),
+                [this]
+                {
+                    if (_player)
+                    {
+                        _player->setPinnedRanges({});
+                    }
+                });
+            _actions["ClearPinnedRanges"]->setTooltip("Clear the pinned cache ranges.");
+
             _playerObserver = ftk::ValueObserver<std::shared_ptr<timeline::Player> >::create(
                 app->getFilesModel()->observePlayer(),
                 [this](const std::shared_ptr<timeline::Player>& value)
@@ -7,6 +7,19 @@ namespace tl
 {
     namespace play
     {
+        bool PreloadSettings::operator == (const PreloadSettings& other) const
+        {
+            return
+                count == other.count &&
+                frames == other.frames &&
+                videoGB == other.videoGB;
+        }
+
+        bool PreloadSettings::operator != (const PreloadSettings& other) const
+        {
+            return !(*this == other);
+        }
+
         void SettingsModel::_init(
             const std::shared_ptr<ftk::Context>& context,
             const std::filesystem::path& path)
@@ -16,11 +29,21 @@ namespace tl
             timeline::PlayerCacheOptions cache;
             _settings->getT("/Cache", cache);
             _cache = ftk::ObservableValue<timeline::PlayerCacheOptions>::create(cache);
+
+            PreloadSettings preload;
+            _settings->getT("/Preload", preload);
+            _preload = ftk::ObservableValue<PreloadSettings>::create(preload);
+
+            io::DiskCacheOptions diskCache;
+            _settings->getT("/DiskCache", diskCache);
+            _diskCache = ftk::ObservableValue<io::DiskCacheOptions>::create(diskCache);
         }
 
         SettingsModel::~SettingsModel()
         {
             _settings->setT("/Cache", _cache->get());
+            _settings->setT("/Preload", _preload->get());
+            _settings->setT("/DiskCache", _diskCache->get());
         }
 
         std::shared_ptr<SettingsModel> SettingsModel::create(
@@ -51,5 +74,49 @@ namespace tl
         {
             _cache->setIfChanged(value);
         }
+
+        const PreloadSettings& SettingsModel::getPreload() const
+        {
+            return _preload->get();
+        }
+
+        std::shared_ptr<ftk::IObservableValue<PreloadSettings> > SettingsModel::observePreload() const
+        {
+            return _preload;
+        }
+
+        void SettingsModel::setPreload(const PreloadSettings& value)
+        {
+            _preload->setIfChanged(value);
+        }
+
+        const io::DiskCacheOptions& SettingsModel::getDiskCache() const
+        {
+            return _diskCache->get();
+        }
+
+        std::shared_ptr<ftk::IObservableValue<io::DiskCacheOptions> > SettingsModel::observeDiskCache() const
+        {
+            return _diskCache;
+        }
+
+        void SettingsModel::setDiskCache(const io::DiskCacheOptions& value)
+        {
+            _diskCache->setIfChanged(value);
+        }
+
+        void to_json(nlohmann::json& json, const PreloadSettings& value)
+        {
+            json["Count"] = value.count;
+            json["Frames"] = value.frames;
+            json["VideoGB"] = value.videoGB;
+        }
+
+        void from_json(const nlohmann::json& json, PreloadSettings& value)
+        {
+            json.at("Count").get_to(value.count);
+            json.at("Frames").get_to(value.frames);
+            json.at("VideoGB").get_to(value.videoGB);
+        }
     }
 }
\ No newline at end of file
@@ -5,12 +5,31 @@
 
 #include <tlTimeline/Player.h>
 
+#include <tlIO/DiskCache.h>
+
 #include <ftk/UI/Settings.h>
 
 namespace tl
 {
     namespace play
     {
+        //! Preload settings. The files next to the current file are
+        //! preloaded so that switching between them does not stall.
+        struct PreloadSettings
+        {
+            //! Number of files to preload on each side of the current file.
+            int count = 1;
+
+            //! Number of video frames to preload.
+            int frames = 24;
+
+            //! Video cache size for all of the preloaded files in gigabytes.
+            float videoGB = .5F;
+
+            bool operator == (const PreloadSettings&) const;
+            bool operator != (const PreloadSettings&) const;
+        };
+
         //! Settings model.
         class SettingsModel : public std::enable_shared_from_this<SettingsModel>
         {
@@ -43,9 +62,38 @@ namespace tl
             //! Set the cache settings.
             void setCache(const timeline::PlayerCacheOptions&);
 
+            //! Get the preload settings.
+            const PreloadSettings& getPreload() const;
+
+            //! Observe the preload settings.
+            std::shared_ptr<ftk::IObservableValue<PreloadSettings> > observePreload() const;
+
+            //! Set the preload settings.
+            void setPreload(const PreloadSettings&);
+
+            //! Get the disk cache settings.
+            const io::DiskCacheOptions& getDiskCache() const;
+
+            //! Observe the disk cache settings.
+            std::shared_ptr<ftk::IObservableValue<io::DiskCacheOptions> > observeDiskCache() const;
+
+            //! Set the disk cache settings.
+            void setDiskCache(const io::DiskCacheOptions&);
+
         private:
             std::shared_ptr<ftk::Settings> _settings;
             std::shared_ptr<ftk::ObservableValue<timeline::PlayerCacheOptions> > _cache;
+            std::shared_ptr<ftk::ObservableValue<PreloadSettings> > _preload;
+            std::shared_ptr<ftk::ObservableValue<io::DiskCacheOptions> > _diskCache;
         };
+
+        //! \name Serialize
+        ///@{
+
+        void to_json(nlohmann::json&, const PreloadSettings&);
+
+        void from_json(const nlohmann::json&, PreloadSettings&);
+
+        ///@}
     }
 }
\ No newline at end of file
@@ -24,18 +24,36 @@ namespace tl
             _videoEdit->setStep(1.0);
             _videoEdit->setLargeStep(10.0);
 
+            _videoCompressedEdit = ftk::DoubleEdit::create(context);
+            _videoCompressedEdit->setRange(0.0, 128.0);
+            _videoCompressedEdit->setStep(1.0);
+            _videoCompressedEdit->setLargeStep(10.0);
+
             _audioEdit = ftk::DoubleEdit::create(context);
             _audioEdit->setRange(0.0, 128.0);
             _audioEdit->setStep(1.0);
             _audioEdit->setLargeStep(10.0);
 
+            _pinnedVideoEdit = ftk::DoubleEdit::create(context);
+            _pinnedVideoEdit->setRange(0.0, 128.0);
+            _pinnedVideoEdit->setStep(1.0);
+            _pinnedVideoEdit->setLargeStep(10.0);
+
+            _pinnedAudioEdit = ftk::DoubleEdit::create(context);
+            _pinnedAudioEdit->setRange(0.0, 128.0);
+            _pinnedAudioEdit->setStep(1.0);
+            _pinnedAudioEdit->setLargeStep(10.0);
+
             _readBehindEdit = ftk::DoubleEdit::create(context);
             _readBehindEdit->setRange(0.0, 2.0);
 
             _layout = ftk::FormLayout::create(context, shared_from_this());
             _layout->setSpacingRole(ftk::SizeRole::SpacingSmall);
             _layout->addRow("Video cache (GB):", _videoEdit);
+            _layout->addRow("Compressed video cache (GB):", _videoCompressedEdit);
             _layout->addRow("Audio cache (GB):", _audioEdit);
+            _layout->addRow("Pinned video cache (GB):", _pinnedVideoEdit);
+            _layout->addRow("Pinned audio cache (GB):", _pinnedAudioEdit);
             _layout->addRow("Read behind (seconds):", _readBehindEdit);
 
             std::weak_ptr<App> appWeak(app);
@@ -50,6 +68,17 @@ namespace tl
                     }
                 });
 
+            _videoCompressedEdit->setCallback(
+                [appWeak](double value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        auto cache = app->getSettingsModel()->getCache();
+                        cache.videoCompressedGB = value;
+                        app->getSettingsModel()->setCache(cache);
+                    }
+                });
+
             _audioEdit->setCallback(
                 [appWeak](double value)
                 {
@@ -61,6 +90,28 @@ namespace tl
                     }
                 });
 
+            _pinnedVideoEdit->setCallback(
+                [appWeak](double value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        auto cache = app->getSettingsModel()->getCache();
+                        cache.pinnedVideoGB = value;
+                        app->getSettingsModel()->setCache(cache);
+                    }
+                });
+
+            _pinnedAudioEdit->setCallback(
+                [appWeak](double value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        auto cache = app->getSettingsModel()->getCache();
+                        cache.pinnedAudioGB = value;
+                        app->getSettingsModel()->setCache(cache);
+                    }
+                });
+
             _readBehindEdit->setCallback(
                 [appWeak](double value)
                 {
@@ -77,7 +128,10 @@ namespace tl
                 [this](const timeline::PlayerCacheOptions& value)
                 {
                     _videoEdit->setValue(value.videoGB);
+                    _videoCompressedEdit->setValue(value.videoCompressedGB);
                     _audioEdit->setValue(value.audioGB);
+                    _pinnedVideoEdit->setValue(value.pinnedVideoGB);
+                    _pinnedAudioEdit->setValue(value.pinnedAudioGB);
                     _readBehindEdit->setValue(value.readBehind);
                 });
         }
@@ -107,6 +161,178 @@ namespace tl
             _setSizeHint(_layout->getSizeHint());
         }
 
+        void PreloadSettingsWidget::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IWidget::_init(context, "PreloadSettingsWidget", parent);
+
+            _countEdit = ftk::IntEdit::create(context);
+            _countEdit->setRange(0, 10);
+
+            _framesEdit = ftk::IntEdit::create(context);
+            _framesEdit->setRange(1, 1000);
+            _framesEdit->setStep(1);
+            _framesEdit->setLargeStep(10);
+
+            _videoEdit = ftk::DoubleEdit::create(context);
+            _videoEdit->setRange(0.0, 16.0);
+            _videoEdit->setStep(.1);
+            _videoEdit->setLargeStep(1.0);
+
+            _layout = ftk::FormLayout::create(context, shared_from_this());
+            _layout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            _layout->addRow("Files:", _countEdit);
+            _layout->addRow("Frames:", _framesEdit);
+            _layout->addRow("Video cache (GB):", _videoEdit);
+
+            std::weak_ptr<App> appWeak(app);
+            _countEdit->setCallback(
+                [appWeak](int value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        auto preload = app->getSettingsModel()->getPreload();
+                        preload.count = value;
+                        app->getSettingsModel()->setPreload(preload);
+                    }
+                });
+
+            _framesEdit->setCallback(
+                [appWeak](int value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        auto preload = app->getSettingsModel()->getPreload();
+                        preload.frames = value;
+                        app->getSettingsModel()->setPreload(preload);
+                    }
+                });
+
+            _videoEdit->setCallback(
+                [appWeak](double value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        auto preload = app->getSettingsModel()->getPreload();
+                        preload.videoGB = value;
+                        app->getSettingsModel()->setPreload(preload);
+                    }
+                });
+
+            _preloadObserver = ftk::ValueObserver<PreloadSettings>::create(
+                app->getSettingsModel()->observePreload(),
+                [this](const PreloadSettings& value)
+                {
+                    _countEdit->setValue(value.count);
+                    _framesEdit->setValue(value.frames);
+                    _videoEdit->setValue(value.videoGB);
+                });
+        }
+
+        PreloadSettingsWidget::~PreloadSettingsWidget()
+        {}
+
+        std::shared_ptr<PreloadSettingsWidget> PreloadSettingsWidget::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<PreloadSettingsWidget>(new PreloadSettingsWidget);
+            out->_init(context, app, parent);
+            return out;
+        }
+
+        void PreloadSettingsWidget::setGeometry(const ftk::Box2I& value)
+        {
+            IWidget::setGeometry(value);
+            _layout->setGeometry(value);
+        }
+
+        void PreloadSettingsWidget::sizeHintEvent(const ftk::SizeHintEvent& event)
+        {
+            IWidget::sizeHintEvent(event);
+            _setSizeHint(_layout->getSizeHint());
+        }
+
+        void DiskCacheSettingsWidget::_init(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            IWidget::_init(context, "DiskCacheSettingsWidget", parent);
+
+            _pathEdit = ftk::LineEdit::create(context);
+            _pathEdit->setHStretch(ftk::Stretch::Expanding);
+
+            _gbEdit = ftk::DoubleEdit::create(context);
+            _gbEdit->setRange(0.0, 1024.0);
+            _gbEdit->setStep(1.0);
+            _gbEdit->setLargeStep(10.0);
+
+            _layout = ftk::FormLayout::create(context, shared_from_this());
+            _layout->setSpacingRole(ftk::SizeRole::SpacingSmall);
+            _layout->addRow("Directory:", _pathEdit);
+            _layout->addRow("Size (GB):", _gbEdit);
+
+            std::weak_ptr<App> appWeak(app);
+            _pathEdit->setTextCallback(
+                [appWeak](const std::string& value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        auto diskCache = app->getSettingsModel()->getDiskCache();
+                        diskCache.path = value;
+                        app->getSettingsModel()->setDiskCache(diskCache);
+                    }
+                });
+
+            _gbEdit->setCallback(
+                [appWeak](double value)
+                {
+                    if (auto app = appWeak.lock())
+                    {
+                        auto diskCache = app->getSettingsModel()->getDiskCache();
+                        diskCache.gb = value;
+                        app->getSettingsModel()->setDiskCache(diskCache);
+                    }
+                });
+
+            _diskCacheObserver = ftk::ValueObserver<io::DiskCacheOptions>::create(
+                app->getSettingsModel()->observeDiskCache(),
+                [this](const io::DiskCacheOptions& value)
+                {
+                    _pathEdit->setText(value.path);
+                    _gbEdit->setValue(value.gb);
+                });
+        }
+
+        DiskCacheSettingsWidget::~DiskCacheSettingsWidget()
+        {}
+
+        std::shared_ptr<DiskCacheSettingsWidget> DiskCacheSettingsWidget::create(
+            const std::shared_ptr<ftk::Context>& context,
+            const std::shared_ptr<App>& app,
+            const std::shared_ptr<IWidget>& parent)
+        {
+            auto out = std::shared_ptr<DiskCacheSettingsWidget>(new DiskCacheSettingsWidget);
+            out->_init(context, app, parent);
+            return out;
+        }
+
+        void DiskCacheSettingsWidget::setGeometry(const ftk::Box2I& value)
+        {
+            IWidget::setGeometry(value);
+            _layout->setGeometry(value);
+        }
+
+        void DiskCacheSettingsWidget::sizeHintEvent(const ftk::SizeHintEvent& event)
+        {
+            IWidget::sizeHintEvent(event);
+            _setSizeHint(_layout->getSizeHint());
+        }
+
         void SettingsWidget::_init(
             const std::shared_ptr<ftk::Context>& context,
             const std::shared_ptr<App>& app,
@@ -118,6 +344,10 @@ namespace tl
             _layout->setSpacingRole(ftk::SizeRole::SpacingSmall);
             auto groupBox = ftk::GroupBox::create(context, "Cache", _layout);
             CacheSettingsWidget::create(context, app, groupBox);
+            groupBox = ftk::GroupBox::create(context, "Preload", _layout);
+            PreloadSettingsWidget::create(context, app, groupBox);
+            groupBox = ftk::GroupBox::create(context, "Disk Cache", _layout);
+            DiskCacheSettingsWidget::create(context, app, groupBox);
         }
 
         SettingsWidget::~SettingsWidget()
@@ -3,10 +3,12 @@
 
 #pragma once
 
-#include <tlTimeline/Player.h>
+#include "SettingsModel.h"
 
 #include <ftk/UI/DoubleEdit.h>
 #include <ftk/UI/FormLayout.h>
+#include <ftk/UI/IntEdit.h>
+#include <ftk/UI/LineEdit.h>
 #include <ftk/UI/RowLayout.h>
 
 namespace tl
@@ -41,12 +43,78 @@ namespace tl
 
         private:
             std::shared_ptr<ftk::DoubleEdit> _videoEdit;
+            std::shared_ptr<ftk::DoubleEdit> _videoCompressedEdit;
             std::shared_ptr<ftk::DoubleEdit> _audioEdit;
+            std::shared_ptr<ftk::DoubleEdit> _pinnedVideoEdit;
+            std::shared_ptr<ftk::DoubleEdit> _pinnedAudioEdit;
             std::shared_ptr<ftk::DoubleEdit> _readBehindEdit;
             std::shared_ptr<ftk::FormLayout> _layout;
             std::shared_ptr<ftk::ValueObserver<timeline::PlayerCacheOptions> > _cacheObserver;
         };
 
+        //! Preload settings widget.
+        class PreloadSettingsWidget : public ftk::IWidget
+        {
+            FTK_NON_COPYABLE(PreloadSettingsWidget);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            PreloadSettingsWidget() = default;
+
+        public:
+            ~PreloadSettingsWidget();
+
+            static std::shared_ptr<PreloadSettingsWidget> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            void setGeometry(const ftk::Box2I&) override;
+            void sizeHintEvent(const ftk::SizeHintEvent&) override;
+
+        private:
+            std::shared_ptr<ftk::IntEdit> _countEdit;
+            std::shared_ptr<ftk::IntEdit> _framesEdit;
+            std::shared_ptr<ftk::DoubleEdit> _videoEdit;
+            std::shared_ptr<ftk::FormLayout> _layout;
+            std::shared_ptr<ftk::ValueObserver<PreloadSettings> > _preloadObserver;
+        };
+
+        //! Disk cache settings widget.
+        class DiskCacheSettingsWidget : public ftk::IWidget
+        {
+            FTK_NON_COPYABLE(DiskCacheSettingsWidget);
+
+        protected:
+            void _init(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent);
+
+            DiskCacheSettingsWidget() = default;
+
+        public:
+            ~DiskCacheSettingsWidget();
+
+            static std::shared_ptr<DiskCacheSettingsWidget> create(
+                const std::shared_ptr<ftk::Context>&,
+                const std::shared_ptr<App>&,
+                const std::shared_ptr<IWidget>& parent = nullptr);
+
+            void setGeometry(const ftk::Box2I&) override;
+            void sizeHintEvent(const ftk::SizeHintEvent&) override;
+
+        private:
+            std::shared_ptr<ftk::LineEdit> _pathEdit;
+            std::shared_ptr<ftk::DoubleEdit> _gbEdit;
+            std::shared_ptr<ftk::FormLayout> _layout;
+            std::shared_ptr<ftk::ValueObserver<io::DiskCacheOptions> > _diskCacheObserver;
+        };
+
         //! Settings widget.
         class SettingsWidget : public ftk::IWidget
         {
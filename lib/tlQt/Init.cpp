@@ -81,6 +81,7 @@ namespace tl
             qRegisterMetaType<timeline::PlayerCacheInfo>("tl::timeline::PlayerCacheInfo");
             qRegisterMetaType<timeline::PlayerCacheOptions>("tl::timeline::PlayerCacheOptions");
             qRegisterMetaType<timeline::PlayerOptions>("tl::timeline::PlayerOptions");
+            qRegisterMetaType<timeline::PlayerStats>("tl::timeline::PlayerStats");
             qRegisterMetaType<timeline::TimeAction>("tl::timeline::TimeAction");
             qRegisterMetaType<timeline::TimeUnits>("tl::timeline::TimeUnits");
             qRegisterMetaType<timeline::Transition>("tl::timeline::Transition");
@@ -45,6 +45,7 @@ namespace tl
             std::shared_ptr<ftk::ListObserver<timeline::AudioData> > currentAudioObserver;
             std::shared_ptr<ftk::ValueObserver<timeline::PlayerCacheOptions> > cacheOptionsObserver;
             std::shared_ptr<ftk::ValueObserver<timeline::PlayerCacheInfo> > cacheInfoObserver;
+            std::shared_ptr<ftk::ValueObserver<timeline::PlayerStats> > statsObserver;
         };
 
         void PlayerObject::_init(
@@ -189,6 +190,13 @@ namespace tl
                     Q_EMIT cacheInfoChanged(value);
                 });
 
+            p.statsObserver = ftk::ValueObserver<timeline::PlayerStats>::create(
+                p.player->observeStats(),
+                [this](const timeline::PlayerStats& value)
+                {
+                    Q_EMIT statsChanged(value);
+                });
+
             p.timer.reset(new QTimer);
             p.timer->setTimerType(Qt::PreciseTimer);
             connect(p.timer.get(), &QTimer::timeout, this, &PlayerObject::_timerCallback);
@@ -358,6 +366,11 @@ namespace tl
             return _p->player->observeCacheInfo()->get();
         }
 
+        const timeline::PlayerStats& PlayerObject::stats() const
+        {
+            return _p->player->observeStats()->get();
+        }
+
         void PlayerObject::setSpeed(double value)
         {
             _p->player->setSpeed(value);
@@ -506,6 +519,11 @@ namespace tl
             _p->player->setCacheOptions(value);
         }
 
+        void PlayerObject::resetStats()
+        {
+            _p->player->resetStats();
+        }
+
         void PlayerObject::_timerCallback()
         {
             if (_p && _p->player)
@@ -115,6 +115,10 @@ namespace tl
                 tl::timeline::PlayerCacheInfo cacheInfo
                 READ cacheInfo
                 NOTIFY cacheInfoChanged)
+            Q_PROPERTY(
+                tl::timeline::PlayerStats stats
+                READ stats
+                NOTIFY statsChanged)
 
             void _init(
                 const std::shared_ptr<ftk::Context>&,
@@ -264,6 +268,14 @@ namespace tl
 
             ///@}
 
+            //! \name Statistics
+            ///@{
+
+            //! Get the playback statistics.
+            const timeline::PlayerStats& stats() const;
+
+            ///@}
+
         public Q_SLOTS:
             //! \name Playback
             ///@{
@@ -392,6 +404,14 @@ namespace tl
 
             ///@}
 
+            //! \name Statistics
+            ///@{
+
+            //! Reset the playback statistics.
+            void resetStats();
+
+            ///@}
+
         Q_SIGNALS:
             //! \name Playback
             ///@{
@@ -480,6 +500,15 @@ namespace tl
 
             ///@}
 
+            //! \name Statistics
+            ///@{
+
+            //! This signal is emitted when the playback statistics have
+            //! changed.
+            void statsChanged(const tl::timeline::PlayerStats&);
+
+            ///@}
+
         private:
             void _timerCallback();
 
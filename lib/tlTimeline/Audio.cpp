@@ -3,6 +3,8 @@
 
 #include <tlTimeline/Audio.h>
 
+#include <cstring>
+
 namespace tl
 {
     namespace timeline
@@ -32,5 +34,20 @@ namespace tl
         {
             return a.seconds == b.seconds;
         }
+
+        void audioCallback(
+            const std::shared_ptr<audio::AudioRingBuffer>& ringBuffer,
+            uint8_t* out,
+            size_t byteCount)
+        {
+            if (ringBuffer)
+            {
+                ringBuffer->readBytes(out, byteCount);
+            }
+            else
+            {
+                std::memset(out, 0, byteCount);
+            }
+        }
     }
 }
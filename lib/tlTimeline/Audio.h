@@ -5,6 +5,8 @@
 
 #include <tlIO/IO.h>
 
+#include <tlCore/AudioRingBuffer.h>
+
 namespace tl
 {
     namespace timeline
@@ -30,5 +32,14 @@ namespace tl
 
         //! Compare the time values of audio data.
         bool isTimeEqual(const AudioData&, const AudioData&);
+
+        //! Copy audio from the ring buffer for the audio device callback,
+        //! silence is output when there is no ring buffer. This is called
+        //! from the audio device thread so it must not lock or allocate
+        //! memory.
+        void audioCallback(
+            const std::shared_ptr<audio::AudioRingBuffer>&,
+            uint8_t*,
+            size_t byteCount);
     }
 }
@@ -4,6 +4,7 @@
 #include <tlTimeline/Init.h>
 
 #include <tlTimeline/MemoryReference.h>
+#include <tlTimeline/PlayerCache.h>
 
 #include <tlIO/Init.h>
 
@@ -20,6 +21,7 @@ namespace tl
         {
             io::init(context);
             System::create(context);
+            PlayerCacheSystem::create(context);
         }
 
         System::System(const std::shared_ptr<ftk::Context>& context) :
@@ -50,6 +52,14 @@ namespace tl
                 {
                     "ZipMemorySequenceReference",
                     OTIO_NS::TypeRegistry::instance().register_type<tl::timeline::ZipMemorySequenceReference>()
+                },
+                {
+                    "MappedMemoryReference",
+                    OTIO_NS::TypeRegistry::instance().register_type<tl::timeline::MappedMemoryReference>()
+                },
+                {
+                    "MappedMemorySequenceReference",
+                    OTIO_NS::TypeRegistry::instance().register_type<tl::timeline::MappedMemorySequenceReference>()
                 }
             };
             for (const auto& t : registerTypes)
@@ -205,5 +205,62 @@ namespace tl
         {
             _file_io = file_io;
         }
+
+        MappedMemoryReference::MappedMemoryReference(
+            const std::shared_ptr<ftk::FileIO>& file_io,
+            const std::string& target_url,
+            const std::optional<OTIO_NS::TimeRange>& available_range,
+            const OTIO_NS::AnyDictionary& metadata) :
+            RawMemoryReference(target_url, nullptr, 0, available_range, metadata)
+        {
+            set_file_io(file_io);
+        }
+
+        MappedMemoryReference::~MappedMemoryReference()
+        {}
+
+        const std::shared_ptr<ftk::FileIO>& MappedMemoryReference::file_io() const noexcept
+        {
+            return _file_io;
+        }
+
+        void MappedMemoryReference::set_file_io(const std::shared_ptr<ftk::FileIO>& file_io)
+        {
+            _file_io = file_io;
+            set_memory(
+                _file_io ? _file_io->getMemoryStart() : nullptr,
+                _file_io ? _file_io->getSize() : 0);
+        }
+
+        MappedMemorySequenceReference::MappedMemorySequenceReference(
+            const std::vector<std::shared_ptr<ftk::FileIO> >& file_io,
+            const std::string& target_url,
+            const std::optional<OTIO_NS::TimeRange>& available_range,
+            const OTIO_NS::AnyDictionary& metadata) :
+            RawMemorySequenceReference(target_url, {}, {}, available_range, metadata)
+        {
+            set_file_io(file_io);
+        }
+
+        MappedMemorySequenceReference::~MappedMemorySequenceReference()
+        {}
+
+        const std::vector<std::shared_ptr<ftk::FileIO> >& MappedMemorySequenceReference::file_io() const noexcept
+        {
+            return _file_io;
+        }
+
+        void MappedMemorySequenceReference::set_file_io(const std::vector<std::shared_ptr<ftk::FileIO> >& file_io)
+        {
+            _file_io = file_io;
+            std::vector<const uint8_t*> memory;
+            std::vector<size_t> memory_sizes;
+            for (const auto& i : _file_io)
+            {
+                memory.push_back(i ? i->getMemoryStart() : nullptr);
+                memory_sizes.push_back(i ? i->getSize() : 0);
+            }
+            set_memory(memory, memory_sizes);
+        }
     }
 }
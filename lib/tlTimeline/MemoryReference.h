@@ -209,5 +209,57 @@ namespace tl
 
             std::shared_ptr<ftk::FileIO> _file_io;
         };
+
+        //! Memory mapped file reference.
+        class MappedMemoryReference : public RawMemoryReference
+        {
+        public:
+            struct Schema
+            {
+                static auto constexpr name = "MappedMemoryReference";
+                static int constexpr version = 1;
+            };
+
+            MappedMemoryReference(
+                const std::shared_ptr<ftk::FileIO>& file_io = nullptr,
+                const std::string& target_url = std::string(),
+                const std::optional<OTIO_NS::TimeRange>& available_range = std::nullopt,
+                const OTIO_NS::AnyDictionary& metadata = OTIO_NS::AnyDictionary());
+
+            const std::shared_ptr<ftk::FileIO>& file_io() const noexcept;
+
+            void set_file_io(const std::shared_ptr<ftk::FileIO>&);
+
+        protected:
+            virtual ~MappedMemoryReference();
+
+            std::shared_ptr<ftk::FileIO> _file_io;
+        };
+
+        //! Memory mapped file sequence reference.
+        class MappedMemorySequenceReference : public RawMemorySequenceReference
+        {
+        public:
+            struct Schema
+            {
+                static auto constexpr name = "MappedMemorySequenceReference";
+                static int constexpr version = 1;
+            };
+
+            MappedMemorySequenceReference(
+                const std::vector<std::shared_ptr<ftk::FileIO> >& file_io = {},
+                const std::string& target_url = std::string(),
+                const std::optional<OTIO_NS::TimeRange>& available_range = std::nullopt,
+                const OTIO_NS::AnyDictionary& metadata = OTIO_NS::AnyDictionary());
+
+            const std::vector<std::shared_ptr<ftk::FileIO> >& file_io() const noexcept;
+
+            void set_file_io(const std::vector<std::shared_ptr<ftk::FileIO> >&);
+
+        protected:
+            virtual ~MappedMemorySequenceReference();
+
+            std::vector<std::shared_ptr<ftk::FileIO> > _file_io;
+        };
     }
 }
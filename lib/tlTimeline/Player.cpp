@@ -11,6 +11,8 @@
 #include <ftk/Core/String.h>
 #include <ftk/Core/Time.h>
 
+#include <cmath>
+
 namespace tl
 {
     namespace timeline
@@ -19,9 +21,19 @@ namespace tl
         {
             return
                 videoPercentage == other.videoPercentage &&
+                videoCompressedPercentage == other.videoCompressedPercentage &&
+                videoCompressionRatio == other.videoCompressionRatio &&
                 audioPercentage == other.audioPercentage &&
                 video == other.video &&
-                audio == other.audio;
+                audio == other.audio &&
+                pinnedVideoPercentage == other.pinnedVideoPercentage &&
+                pinnedAudioPercentage == other.pinnedAudioPercentage &&
+                pinnedVideo == other.pinnedVideo &&
+                pinnedAudio == other.pinnedAudio &&
+                videoRequestMax == other.videoRequestMax &&
+                videoThroughput == other.videoThroughput &&
+                videoLatency == other.videoLatency &&
+                videoBufferAhead == other.videoBufferAhead;
         }
 
         bool PlayerCacheInfo::operator != (const PlayerCacheInfo& other) const
@@ -29,6 +41,39 @@ namespace tl
             return !(*this == other);
         }
 
+        bool PlayerLatencyStats::operator == (const PlayerLatencyStats& other) const
+        {
+            return
+                path == other.path &&
+                count == other.count &&
+                p50 == other.p50 &&
+                p95 == other.p95 &&
+                p99 == other.p99 &&
+                histogram == other.histogram;
+        }
+
+        bool PlayerLatencyStats::operator != (const PlayerLatencyStats& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool PlayerStats::operator == (const PlayerStats& other) const
+        {
+            return
+                framesPresented == other.framesPresented &&
+                framesLate == other.framesLate &&
+                framesSkipped == other.framesSkipped &&
+                cacheMisses == other.cacheMisses &&
+                latency == other.latency &&
+                videoRequestDepth == other.videoRequestDepth &&
+                audioRequestDepth == other.audioRequestDepth;
+        }
+
+        bool PlayerStats::operator != (const PlayerStats& other) const
+        {
+            return !(*this == other);
+        }
+
         FTK_ENUM_IMPL(
             Playback,
             "Stop",
@@ -72,8 +117,22 @@ namespace tl
                     arg(playerOptions.cache.audioGB));
                 lines.push_back(ftk::Format("    Cache read behind: {0}").
                     arg(playerOptions.cache.readBehind));
+                lines.push_back(ftk::Format("    Video requests: {0}, adaptive: {1}, limit: {2}").
+                    arg(playerOptions.videoRequestMax).
+                    arg(playerOptions.videoRequestAdaptive).
+                    arg(playerOptions.videoRequestLimit));
+                lines.push_back(ftk::Format("    Video buffer ahead: {0}").
+                    arg(playerOptions.videoBufferAhead));
+                lines.push_back(ftk::Format("    Display rate: {0}").
+                    arg(playerOptions.displayRate));
+                lines.push_back(ftk::Format("    Scrub timeout: {0}ms").
+                    arg(playerOptions.scrubTimeout.count()));
+                lines.push_back(ftk::Format("    Scrub proxy: {0}").
+                    arg(playerOptions.scrubProxy));
                 lines.push_back(ftk::Format("    Audio buffer frame count: {0}").
                     arg(playerOptions.audioBufferFrameCount));
+                lines.push_back(ftk::Format("    Audio ring buffer frame count: {0}").
+                    arg(playerOptions.audioRingBufferFrameCount));
                 lines.push_back(ftk::Format("    Mute timeout: {0}ms").
                     arg(playerOptions.muteTimeout.count()));
                 lines.push_back(ftk::Format("    Sleep timeout: {0}ms").
@@ -87,6 +146,18 @@ namespace tl
             p.timeline = timeline;
             p.timeRange = timeline->getTimeRange();
             p.ioInfo = timeline->getIOInfo();
+            p.mutex.timeRange = p.timeRange;
+            p.mutex.ioInfo = p.ioInfo;
+            p.thread.timeRange = p.timeRange;
+            p.thread.ioInfo = p.ioInfo;
+            p.thread.videoCache.setTimeRange(p.timeRange);
+            p.thread.videoPinned.setTimeRange(p.timeRange);
+            p.thread.videoCompressed.setTimeRange(p.timeRange);
+            p.thread.videoRequestMax = std::max(playerOptions.videoRequestMax, size_t(1));
+            if (playerOptions.videoRequestAdaptive)
+            {
+                timeline->setVideoRequestMax(p.thread.videoRequestMax);
+            }
 
             // Create observers.
             p.speed = ftk::ObservableValue<double>::create(p.timeRange.duration().rate());
@@ -111,7 +182,11 @@ namespace tl
             p.audioOffset = ftk::ObservableValue<double>::create(0.0);
             p.currentAudioData = ftk::ObservableList<AudioData>::create();
             p.cacheOptions = ftk::ObservableValue<PlayerCacheOptions>::create(playerOptions.cache);
+            p.cachePriority = ftk::ObservableValue<PlayerCachePriority>::create(PlayerCachePriority::Normal);
+            p.pinnedRanges = ftk::ObservableList<OTIO_NS::TimeRange>::create();
             p.cacheInfo = ftk::ObservableValue<PlayerCacheInfo>::create();
+            p.stats = ftk::ObservableValue<PlayerStats>::create();
+            p.scrub = ftk::ObservableValue<bool>::create(false);
             auto audioSystem = context->getSystem<audio::System>();
             auto weak = std::weak_ptr<Player>(shared_from_this());
             p.audioDevicesObserver = ftk::ListObserver<audio::DeviceInfo>::create(
@@ -142,16 +217,35 @@ namespace tl
                     }
                 });
 
+            p.editObserver = ftk::ValueObserver<TimelineEdit>::create(
+                timeline->observeEdit(),
+                [weak](const TimelineEdit& value)
+                {
+                    if (auto player = weak.lock())
+                    {
+                        player->_edit(value);
+                    }
+                });
+
+            // Add the player to the cache system.
+            if (auto cacheSystem = context->getSystem<PlayerCacheSystem>())
+            {
+                cacheSystem->addPlayer(this, p.cachePriority->get());
+                p.cacheSystem = cacheSystem;
+            }
+
             // Initialize the audio.
             p.audioInit(context);
 
             // Create a new thread.
+            p.mutex.state.speed = p.speed->get();
             p.mutex.state.currentTime = p.currentTime->get();
             p.mutex.state.inOutRange = p.inOutRange->get();
             p.mutex.state.audioOffset = p.audioOffset->get();
             p.mutex.state.cacheOptions = p.cacheOptions->get();
             p.audioMutex.state.speed = p.speed->get();
             p.log(context);
+            p.compressInit();
             p.running = true;
             p.thread.thread = std::thread(
                 [this]
@@ -172,6 +266,11 @@ namespace tl
             {
                 p.thread.thread.join();
             }
+            p.compressStop();
+            if (auto cacheSystem = p.cacheSystem.lock())
+            {
+                cacheSystem->removePlayer(this);
+            }
 #if defined(TLRENDER_SDL2)
             if (p.sdlID > 0)
             {
@@ -257,6 +356,10 @@ namespace tl
             FTK_P();
             if (p.speed->setIfChanged(value))
             {
+                {
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.state.speed = value;
+                }
                 {
                     std::unique_lock<std::mutex> lock(p.audioMutex.mutex);
                     p.audioMutex.state.speed = value;
@@ -442,6 +545,26 @@ namespace tl
             }
         }
 
+        bool Player::isScrub() const
+        {
+            return _p->scrub->get();
+        }
+
+        std::shared_ptr<ftk::IObservableValue<bool> > Player::observeScrub() const
+        {
+            return _p->scrub;
+        }
+
+        void Player::setScrub(bool value)
+        {
+            FTK_P();
+            if (p.scrub->setIfChanged(value))
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.state.scrub = value;
+            }
+        }
+
         void Player::timeAction(TimeAction time)
         {
             FTK_P();
@@ -713,6 +836,48 @@ namespace tl
             }
         }
 
+        PlayerCachePriority Player::getCachePriority() const
+        {
+            return _p->cachePriority->get();
+        }
+
+        std::shared_ptr<ftk::IObservableValue<PlayerCachePriority> > Player::observeCachePriority() const
+        {
+            return _p->cachePriority;
+        }
+
+        void Player::setCachePriority(PlayerCachePriority value)
+        {
+            FTK_P();
+            if (p.cachePriority->setIfChanged(value))
+            {
+                if (auto cacheSystem = p.cacheSystem.lock())
+                {
+                    cacheSystem->setPriority(this, value);
+                }
+            }
+        }
+
+        const std::vector<OTIO_NS::TimeRange>& Player::getPinnedRanges() const
+        {
+            return _p->pinnedRanges->get();
+        }
+
+        std::shared_ptr<ftk::IObservableList<OTIO_NS::TimeRange> > Player::observePinnedRanges() const
+        {
+            return _p->pinnedRanges;
+        }
+
+        void Player::setPinnedRanges(const std::vector<OTIO_NS::TimeRange>& value)
+        {
+            FTK_P();
+            if (p.pinnedRanges->setIfChanged(value))
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.state.pinnedRanges = value;
+            }
+        }
+
         std::shared_ptr<ftk::IObservableValue<PlayerCacheInfo> > Player::observeCacheInfo() const
         {
             return _p->cacheInfo;
@@ -726,6 +891,18 @@ namespace tl
             p.mutex.clearCache = true;
         }
 
+        std::shared_ptr<ftk::IObservableValue<PlayerStats> > Player::observeStats() const
+        {
+            return _p->stats;
+        }
+
+        void Player::resetStats()
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            p.mutex.resetStats = true;
+        }
+
         void Player::tick()
         {
             FTK_P();
@@ -739,9 +916,17 @@ namespace tl
                 double t = 0.0;
                 if (p.hasAudio())
                 {
+                    // Use the number of samples that the audio device has
+                    // played since the last reset.
                     std::unique_lock<std::mutex> lock(p.audioMutex.mutex);
                     start = p.audioMutex.start;
-                    t = OTIO_NS::RationalTime(p.audioMutex.frame, p.ioInfo.audio.sampleRate).rescaled_to(1.0).value();
+                    if (!p.audioMutex.reset && p.audioRingBuffer)
+                    {
+                        t = OTIO_NS::RationalTime(
+                            p.audioRingBuffer->getReadCount(),
+                            p.audioRingBuffer->getInfo().sampleRate).rescaled_to(1.0).value() *
+                            p.speed->get() / timelineSpeed;
+                    }
                 }
                 else
                 {
@@ -770,27 +955,90 @@ namespace tl
                 }
             }
 
+            // Update the I/O information after an edit.
+            if (p.ioInfoPending && !p.timeline->isIOInfoPending())
+            {
+                p.ioInfoPending = false;
+                const io::Info ioInfo = p.timeline->getIOInfo();
+                if (ioInfo != p.ioInfo)
+                {
+                    p.ioInfo = ioInfo;
+                    std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                    p.mutex.timelineChanged = true;
+                    p.mutex.timeRange = p.timeRange;
+                    p.mutex.ioInfo = p.ioInfo;
+                }
+            }
+
             // Sync with the thread.
             std::vector<VideoData> currentVideoData;
             std::vector<AudioData> currentAudioData;
             PlayerCacheInfo cacheInfo;
+            PlayerStats stats;
             {
                 std::unique_lock<std::mutex> lock(p.mutex.mutex);
                 p.mutex.state.currentTime = p.currentTime->get();
                 currentVideoData = p.mutex.currentVideoData;
                 currentAudioData = p.mutex.currentAudioData;
                 cacheInfo = p.mutex.cacheInfo;
+                stats = p.mutex.stats;
             }
             p.currentVideoData->setIfChanged(currentVideoData);
             p.currentAudioData->setIfChanged(currentAudioData);
             p.cacheInfo->setIfChanged(cacheInfo);
+            p.stats->setIfChanged(stats);
+        }
+
+        void Player::_edit(const TimelineEdit& value)
+        {
+            FTK_P();
+
+            // Update the time range, for example when a clip is trimmed.
+            // The I/O information is read by the timeline thread and updated
+            // in tick().
+            bool timelineChanged = false;
+            const OTIO_NS::TimeRange prevTimeRange = p.timeRange;
+            if (value.timeRange != time::invalidTimeRange &&
+                value.timeRange != p.timeRange)
+            {
+                p.timeRange = value.timeRange;
+                timelineChanged = true;
+            }
+            p.ioInfoPending = true;
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                if (timelineChanged)
+                {
+                    p.mutex.timelineChanged = true;
+                    p.mutex.timeRange = p.timeRange;
+                    p.mutex.ioInfo = p.ioInfo;
+                }
+                if (!value.video.empty() || !value.audio.empty())
+                {
+                    p.mutex.edits.push_back(value);
+                }
+            }
+
+            // Keep the in/out range and current time inside of the new time
+            // range. An in/out range that covered the whole timeline is
+            // reset to the new time range.
+            if (p.timeRange != prevTimeRange)
+            {
+                const OTIO_NS::TimeRange inOutRange = p.inOutRange->get();
+                setInOutRange(inOutRange == prevTimeRange ?
+                    p.timeRange :
+                    p.timeRange.clamped(inOutRange));
+                seek(p.currentTime->get());
+            }
         }
 
         void Player::_thread()
         {
             FTK_P();
             p.thread.cacheTimer = std::chrono::steady_clock::now();
+            p.thread.videoRequestTimer = std::chrono::steady_clock::now();
             p.thread.logTimer = std::chrono::steady_clock::now();
+            p.statsReset(true);
             while (p.running)
             {
                 const auto t0 = std::chrono::steady_clock::now();
@@ -799,6 +1047,11 @@ namespace tl
                 Private::PlaybackState state;
                 bool clearRequests = false;
                 bool clearCache = false;
+                bool resetStats = false;
+                std::vector<TimelineEdit> edits;
+                bool timelineChanged = false;
+                OTIO_NS::TimeRange timeRange = time::invalidTimeRange;
+                io::Info ioInfo;
                 CacheDirection cacheDirection = CacheDirection::First;
                 PlayerCacheOptions cacheOptions;
                 {
@@ -808,8 +1061,29 @@ namespace tl
                     p.mutex.clearRequests = false;
                     clearCache = p.mutex.clearCache;
                     p.mutex.clearCache = false;
+                    resetStats = p.mutex.resetStats;
+                    p.mutex.resetStats = false;
+                    edits = std::move(p.mutex.edits);
+                    p.mutex.edits.clear();
+                    timelineChanged = p.mutex.timelineChanged;
+                    p.mutex.timelineChanged = false;
+                    if (timelineChanged)
+                    {
+                        timeRange = p.mutex.timeRange;
+                        ioInfo = p.mutex.ioInfo;
+                    }
                     cacheDirection = p.mutex.cacheDirection;
                 }
+                if (auto cacheSystem = p.cacheSystem.lock())
+                {
+                    // Apply the player's share of the cache budget.
+                    state.cacheOptions = cacheSystem->getCacheOptions(this, state.cacheOptions);
+                }
+                const bool compareChanged = state.compare != p.thread.state.compare;
+                if (state.currentTime != p.thread.state.currentTime)
+                {
+                    p.thread.scrubTimer = t0;
+                }
                 if (state != p.thread.state ||
                     clearRequests ||
                     clearCache ||
@@ -819,10 +1093,41 @@ namespace tl
                     p.thread.cacheDirection = cacheDirection;
                 }
 
-                // Clear requests.
+                // Update the time range and I/O information after an edit.
+                if (timelineChanged)
+                {
+                    p.timelineUpdate(timeRange, ioInfo);
+                }
+
+                // Reset the statistics.
+                if (compareChanged || resetStats)
+                {
+                    p.statsReset(resetStats);
+                }
+
+                // Apply the adaptive number of video requests to new
+                // timelines that are being compared.
+                if (compareChanged && p.playerOptions.videoRequestAdaptive)
+                {
+                    for (const auto& compare : p.thread.state.compare)
+                    {
+                        compare->setVideoRequestMax(p.thread.videoRequestMax);
+                    }
+                }
+
+                // Clear requests. Unless the cache is also cleared, the
+                // requests inside of the new cache window are kept.
                 if (clearRequests)
                 {
-                    p.clearRequests();
+                    p.thread.presentedTime = time::invalidTime;
+                    if (clearCache)
+                    {
+                        p.clearRequests();
+                    }
+                    else
+                    {
+                        p.cancelRequests();
+                    }
                 }
 
                 // Clear the cache.
@@ -830,22 +1135,41 @@ namespace tl
                 {
                     p.clearCache();
                 }
+                else
+                {
+                    for (const auto& edit : edits)
+                    {
+                        p.clearCache(edit);
+                    }
+                }
 
                 // Update the cache.
                 p.cacheUpdate();
 
-                // Update the current video data.
-                if (!p.ioInfo.video.empty())
+                // Fill the audio ring buffer.
+                p.audioUpdate();
+
+                // Update the current video data. When frames are skipped the
+                // last requested frame is used.
+                if (!p.thread.ioInfo.video.empty())
                 {
-                    const auto i = p.thread.videoCache.find(p.thread.state.currentTime);
-                    if (i != p.thread.videoCache.end())
+                    auto videoData = p.getVideo(p.thread.state.currentTime);
+                    if (!videoData && p.thread.videoStride > 1)
                     {
+                        videoData = p.getVideo(p.getVideoStrideTime(p.thread.state.currentTime));
+                    }
+                    if (videoData)
+                    {
+                        p.statsPresent(videoData->empty() ?
+                            p.thread.state.currentTime :
+                            videoData->front().time);
                         std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                        p.mutex.currentVideoData = i->second;
+                        p.mutex.currentVideoData = *videoData;
                     }
                     else if (p.thread.state.playback != Playback::Stop)
                     {
-                        if (!p.timeRange.contains(p.thread.state.currentTime))
+                        p.statsMiss(p.thread.state.currentTime);
+                        if (!p.thread.timeRange.contains(p.thread.state.currentTime))
                         {
                             std::unique_lock<std::mutex> lock(p.mutex.mutex);
                             p.mutex.currentVideoData.clear();
@@ -864,10 +1188,41 @@ namespace tl
                             }
                         }
                     }
+                    else if (p.thread.state.scrub)
+                    {
+                        // Show the proxy frame, or the nearest cached frame,
+                        // until the current frame is read.
+                        std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                        if (!p.thread.timeRange.contains(p.thread.state.currentTime))
+                        {
+                            p.mutex.currentVideoData.clear();
+                        }
+                        else if (!p.thread.scrubProxyVideoData.empty() &&
+                            p.thread.scrubProxyVideoData.front().time == p.thread.state.currentTime)
+                        {
+                            p.mutex.currentVideoData = p.thread.scrubProxyVideoData;
+                        }
+                        else
+                        {
+                            auto nearest = p.thread.videoCache.getNearest(p.thread.state.currentTime);
+                            auto pinned = p.thread.videoPinned.getNearest(p.thread.state.currentTime);
+                            if (pinned && !pinned->empty() &&
+                                (!nearest || nearest->empty() ||
+                                std::fabs((pinned->front().time - p.thread.state.currentTime).value()) <
+                                std::fabs((nearest->front().time - p.thread.state.currentTime).value())))
+                            {
+                                nearest = pinned;
+                            }
+                            if (nearest)
+                            {
+                                p.mutex.currentVideoData = *nearest;
+                            }
+                        }
+                    }
                     else
                     {
                         std::unique_lock<std::mutex> lock(p.mutex.mutex);
-                        if (!p.timeRange.contains(p.thread.state.currentTime))
+                        if (!p.thread.timeRange.contains(p.thread.state.currentTime))
                         {
                             p.mutex.currentVideoData.clear();
                         }
@@ -875,7 +1230,7 @@ namespace tl
                 }
 
                 // Update the current audio data.
-                if (p.ioInfo.audio.isValid())
+                if (p.thread.ioInfo.audio.isValid())
                 {
                     std::vector<AudioData> audioDataList;
                     {
@@ -918,5 +1273,26 @@ namespace tl
             // Finished.
             p.clearRequests();
         }
+
+        void to_json(nlohmann::json& json, const PlayerLatencyStats& value)
+        {
+            json["Path"] = value.path;
+            json["Count"] = value.count;
+            json["P50"] = value.p50;
+            json["P95"] = value.p95;
+            json["P99"] = value.p99;
+            json["Histogram"] = value.histogram;
+        }
+
+        void to_json(nlohmann::json& json, const PlayerStats& value)
+        {
+            json["FramesPresented"] = value.framesPresented;
+            json["FramesLate"] = value.framesLate;
+            json["FramesSkipped"] = value.framesSkipped;
+            json["CacheMisses"] = value.cacheMisses;
+            json["Latency"] = value.latency;
+            json["VideoRequestDepth"] = value.videoRequestDepth;
+            json["AudioRequestDepth"] = value.audioRequestDepth;
+        }
     }
 }
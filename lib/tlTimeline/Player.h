@@ -19,6 +19,14 @@ namespace tl
             //! Percentage used of the video cache.
             float videoPercentage = 0.F;
 
+            //! Percentage used of the compressed video cache.
+            float videoCompressedPercentage = 0.F;
+
+            //! Compression ratio of the compressed video cache, the size of
+            //! the uncompressed images divided by the size of the compressed
+            //! images.
+            float videoCompressionRatio = 0.F;
+
             //! Percentage used of the audio cache.
             float audioPercentage = 0.F;
 
@@ -28,10 +36,91 @@ namespace tl
             //! Cached audio.
             std::vector<OTIO_NS::TimeRange> audio;
 
+            //! Percentage used of the pinned video cache.
+            float pinnedVideoPercentage = 0.F;
+
+            //! Percentage used of the pinned audio cache.
+            float pinnedAudioPercentage = 0.F;
+
+            //! Cached video in the pinned ranges.
+            std::vector<OTIO_NS::TimeRange> pinnedVideo;
+
+            //! Cached audio in the pinned ranges.
+            std::vector<OTIO_NS::TimeRange> pinnedAudio;
+
+            //! Maximum number of video requests.
+            size_t videoRequestMax = 0;
+
+            //! Measured video throughput in frames per second.
+            float videoThroughput = 0.F;
+
+            //! Measured video request latency in seconds.
+            float videoLatency = 0.F;
+
+            //! Number of seconds of video buffered ahead of the current time.
+            float videoBufferAhead = 0.F;
+
             bool operator == (const PlayerCacheInfo&) const;
             bool operator != (const PlayerCacheInfo&) const;
         };
 
+        //! Timeline player video request latency statistics.
+        struct PlayerLatencyStats
+        {
+            //! Timeline path.
+            std::string path;
+
+            //! Number of requests.
+            size_t count = 0;
+
+            //! Latency percentiles in milliseconds, computed from the most
+            //! recent requests.
+            float p50 = 0.F;
+            float p95 = 0.F;
+            float p99 = 0.F;
+
+            //! Latency histogram. Bucket N counts the requests that took
+            //! less than 2^N milliseconds, and the last bucket counts the
+            //! rest.
+            std::vector<size_t> histogram;
+
+            bool operator == (const PlayerLatencyStats&) const;
+            bool operator != (const PlayerLatencyStats&) const;
+        };
+
+        //! Timeline player statistics.
+        struct PlayerStats
+        {
+            //! Number of frames presented.
+            size_t framesPresented = 0;
+
+            //! Number of frames presented after their time, because they
+            //! were not in the cache when the current time reached them.
+            size_t framesLate = 0;
+
+            //! Number of frames skipped during playback.
+            size_t framesSkipped = 0;
+
+            //! Number of frames that were not in the cache when the current
+            //! time reached them.
+            size_t cacheMisses = 0;
+
+            //! Video request latency for the timeline and the timelines
+            //! being compared.
+            std::vector<PlayerLatencyStats> latency;
+
+            //! Number of video requests in progress, sampled twice a second
+            //! for the last minute.
+            std::vector<size_t> videoRequestDepth;
+
+            //! Number of audio requests in progress, sampled twice a second
+            //! for the last minute.
+            std::vector<size_t> audioRequestDepth;
+
+            bool operator == (const PlayerStats&) const;
+            bool operator != (const PlayerStats&) const;
+        };
+
         //! Playback modes.
         enum class Playback
         {
@@ -206,6 +295,21 @@ namespace tl
             //! Go to the next frame.
             void frameNext();
 
+            //! Get whether scrubbing is enabled.
+            bool isScrub() const;
+
+            //! Observe whether scrubbing is enabled.
+            std::shared_ptr<ftk::IObservableValue<bool> > observeScrub() const;
+
+            //! Set whether scrubbing is enabled. While scrubbing, the current
+            //! frame is requested at the PlayerOptions::scrubProxy resolution
+            //! and then at full resolution. The proxy frame, or the nearest
+            //! cached frame, is shown until the full resolution frame is
+            //! read. The frames around the current time are requested once
+            //! the current time has been stable for
+            //! PlayerOptions::scrubTimeout.
+            void setScrub(bool);
+
             ///@}
 
             //! \name In/Out Points
@@ -368,6 +472,30 @@ namespace tl
             //! Set the cache options.
             void setCacheOptions(const PlayerCacheOptions&);
 
+            //! Get the cache priority.
+            PlayerCachePriority getCachePriority() const;
+
+            //! Observe the cache priority.
+            std::shared_ptr<ftk::IObservableValue<PlayerCachePriority> > observeCachePriority() const;
+
+            //! Set the cache priority. This sets the player's share of the
+            //! process-wide cache budget, see PlayerCacheSystem.
+            void setCachePriority(PlayerCachePriority);
+
+            //! Get the pinned cache ranges.
+            const std::vector<OTIO_NS::TimeRange>& getPinnedRanges() const;
+
+            //! Observe the pinned cache ranges.
+            std::shared_ptr<ftk::IObservableList<OTIO_NS::TimeRange> > observePinnedRanges() const;
+
+            //! Set the pinned cache ranges. The frames inside of the pinned
+            //! ranges are kept in a separate cache that is not affected by
+            //! the current time, so switching between the ranges does not
+            //! need to read them again. The pinned cache sizes are set with
+            //! the cache options, the ranges are cached in order until the
+            //! pinned cache is full.
+            void setPinnedRanges(const std::vector<OTIO_NS::TimeRange>&);
+
             //! Observe the cache information.
             std::shared_ptr<ftk::IObservableValue<PlayerCacheInfo> > observeCacheInfo() const;
 
@@ -376,13 +504,33 @@ namespace tl
 
             ///@}
 
+            //! \name Statistics
+            ///@{
+
+            //! Observe the playback statistics.
+            std::shared_ptr<ftk::IObservableValue<PlayerStats> > observeStats() const;
+
+            //! Reset the playback statistics.
+            void resetStats();
+
+            ///@}
+
             //! Tick the timeline player.
             void tick();
 
         private:
+            void _edit(const TimelineEdit&);
             void _thread();
 
             FTK_PRIVATE();
         };
+
+        //! \name Serialize
+        ///@{
+
+        void to_json(nlohmann::json&, const PlayerLatencyStats&);
+        void to_json(nlohmann::json&, const PlayerStats&);
+
+        ///@}
     }
 }
@@ -8,6 +8,9 @@
 #include <ftk/Core/Context.h>
 #include <ftk/Core/Format.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace tl
 {
     namespace timeline
@@ -222,6 +225,11 @@ namespace tl
                 sdlStream = nullptr;
             }
 #endif // TLRENDER_SDL2
+            audioRingBuffer.reset();
+            {
+                std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                audioMutex.ringBuffer.reset();
+            }
 
             audio::DeviceID id = audioDevice->get();
             auto audioSystem = context->getSystem<audio::System>();
@@ -247,13 +255,6 @@ namespace tl
                     context->log("tl::timeline::Player", ss.str());
                 }
 
-                // These are OK to modify since the audio thread is stopped.
-                audioMutex.reset = true;
-                audioMutex.start = currentTime->get();
-                audioMutex.frame = 0;
-                audioThread.info = audioInfo;
-                audioThread.resample.reset();
-
                 SDL_AudioSpec spec;
                 spec.freq = audioInfo.sampleRate;
                 spec.format = toSDL(audioInfo.dataType);
@@ -293,6 +294,22 @@ namespace tl
                         context->log("tl::timeline::Player", ss.str());
                     }
 
+                    // Create the ring buffer. The ring buffer is filled by
+                    // the player thread and read by the audio callback.
+                    audioRingBuffer = audio::AudioRingBuffer::create(
+                        audioInfo,
+                        std::max(
+                            playerOptions.audioRingBufferFrameCount,
+                            playerOptions.audioBufferFrameCount * 2));
+#if defined(TLRENDER_SDL3)
+                    sdlBuffer.resize(audioRingBuffer->getSampleCount() * audioInfo.getByteCount());
+#endif // TLRENDER_SDL3
+                    {
+                        std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                        audioMutex.ringBuffer = audioRingBuffer;
+                        audioReset(currentTime->get());
+                    }
+
 #if defined(TLRENDER_SDL2)
                     SDL_PauseAudioDevice(sdlID, 0);
 #elif defined(TLRENDER_SDL3)
@@ -313,15 +330,13 @@ namespace tl
         {
             audioMutex.reset = true;
             audioMutex.start = time;
-            audioMutex.frame = 0;
         }
 
-#if defined(TLRENDER_SDL2) || defined(TLRENDER_SDL3)
-        void Player::Private::sdlCallback(
-            uint8_t* outputBuffer,
-            int len)
+        void Player::Private::audioUpdate()
         {
-            // Get mutex protected values.
+            // Get mutex protected values. The ring buffer is flushed while
+            // the mutex is locked, so the number of samples played always
+            // matches the start time.
             AudioState state;
             bool reset = false;
             OTIO_NS::RationalTime start = time::invalidTime;
@@ -331,142 +346,163 @@ namespace tl
                 reset = audioMutex.reset;
                 audioMutex.reset = false;
                 start = audioMutex.start;
-                if (reset)
+                thread.audioRingBuffer = audioMutex.ringBuffer;
+                if (thread.audioRingBuffer &&
+                    (reset || (Playback::Stop == state.playback && thread.audioPlayback != Playback::Stop)))
                 {
-                    audioMutex.frame = 0;
+                    thread.audioRingBuffer->flush();
                 }
             }
-            //std::cout << "playback: " << playback << std::endl;
-            //std::cout << "reset: " << reset << std::endl;
-            //std::cout << "start: " << start << std::endl;
-
-            // Zero output audio data.
-            const audio::Info& outputInfo = audioThread.info;
-            const size_t outputSamples = len / outputInfo.getByteCount();
-            std::memset(outputBuffer, 0, outputSamples * outputInfo.getByteCount());
+            thread.audioPlayback = state.playback;
 
-            const audio::Info& inputInfo = ioInfo.audio;
-            if (state.playback != Playback::Stop && inputInfo.sampleRate > 0)
+            // Initialize on reset.
+            if (reset)
             {
-                // Initialize on reset.
-                if (reset)
+                thread.audioInputFrame = 0;
+                if (thread.audioResample)
                 {
-                    audioThread.inputFrame = 0;
-                    audioThread.outputFrame = 0;
-                    if (audioThread.resample)
-                    {
-                        audioThread.resample->flush();
-                    }
-                    audioThread.buffer.clear();
+                    thread.audioResample->flush();
                 }
+                thread.audioBuffer.clear();
+            }
 
-                // Create the audio resampler.
-                if (!audioThread.resample ||
-                    (audioThread.resample && audioThread.resample->getInputInfo() != inputInfo))
+            const audio::Info& inputInfo = thread.ioInfo.audio;
+            if (!thread.audioRingBuffer ||
+                Playback::Stop == state.playback ||
+                0 == inputInfo.sampleRate)
+            {
+                return;
+            }
+            const audio::Info& outputInfo = thread.audioRingBuffer->getInfo();
+
+            // Create the audio resampler.
+            if (!thread.audioResample ||
+                thread.audioResample->getInputInfo() != inputInfo ||
+                thread.audioResample->getOutputInfo() != outputInfo)
+            {
+                thread.audioResample = audio::AudioResample::create(inputInfo, outputInfo);
+            }
+
+            // Fill the audio buffer.
+            const double timelineRate = thread.timeRange.duration().rate();
+            const double speedMult = timelineRate > 0.0 && state.speed > 0.0 ?
+                (state.speed / timelineRate) :
+                1.0;
+            const size_t writeAvailable = thread.audioRingBuffer->getWriteAvailable();
+            size_t bufferSampleCount = audio::getSampleCount(thread.audioBuffer);
+            while (bufferSampleCount < writeAvailable)
+            {
+                // Get audio from the cache.
+                int64_t t =
+                    start.rescaled_to(inputInfo.sampleRate).value() -
+                    OTIO_NS::RationalTime(state.audioOffset, 1.0).rescaled_to(inputInfo.sampleRate).value();
+                if (Playback::Forward == state.playback)
                 {
-                    audioThread.resample = audio::AudioResample::create(inputInfo, outputInfo);
+                    t += thread.audioInputFrame;
                 }
-
-                // Fill the audio buffer.
-                int64_t copySize = 0;
-                const double speedMult = std::max(timeRange.duration().rate() > 0.0 ? (state.speed / timeRange.duration().rate()) : 1.0, 1.0);
-                if (getSampleCount(audioThread.buffer) < outputSamples * 2 * speedMult)
+                else
                 {
-                    // Get audio from the cache.
-                    int64_t t =
-                        start.rescaled_to(inputInfo.sampleRate).value() -
-                        OTIO_NS::RationalTime(state.audioOffset, 1.0).rescaled_to(inputInfo.sampleRate).value();
-                    if (Playback::Forward == state.playback)
-                    {
-                        t += audioThread.inputFrame;
-                    }
-                    else
-                    {
-                        t -= audioThread.inputFrame;
-                    }
-                    std::vector<AudioData> audioDataList;
+                    t -= thread.audioInputFrame;
+                }
+                std::vector<AudioData> audioDataList;
+                {
+                    const int64_t seconds = std::floor(t / static_cast<double>(inputInfo.sampleRate));
+                    std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                    for (int64_t i = seconds - 1; i < seconds + 1; ++i)
                     {
-                        const int64_t seconds = std::floor(t / static_cast<double>(inputInfo.sampleRate));
-                        std::unique_lock<std::mutex> lock(audioMutex.mutex);
-                        for (int64_t i = seconds - 1; i < seconds + 1; ++i)
+                        const auto j = audioMutex.cache.find(i);
+                        if (j != audioMutex.cache.end())
                         {
-                            const auto j = audioMutex.cache.find(i);
-                            if (j != audioMutex.cache.end())
-                            {
-                                audioDataList.push_back(j->second);
-                            }
+                            audioDataList.push_back(j->second);
                         }
                     }
-                    copySize = OTIO_NS::RationalTime(
-                        outputSamples * 2 * speedMult - static_cast<double>(getSampleCount(audioThread.buffer)),
-                        outputInfo.sampleRate).
-                        rescaled_to(inputInfo.sampleRate).value();
-                    std::vector<std::shared_ptr<audio::Audio> > audioLayers;
-                    if (copySize > 0)
+                }
+                const int64_t copySize = OTIO_NS::RationalTime(
+                    (writeAvailable - bufferSampleCount) * speedMult,
+                    outputInfo.sampleRate).
+                    rescaled_to(inputInfo.sampleRate).value();
+                if (copySize <= 0)
+                {
+                    break;
+                }
+                const auto audioLayers = audioCopy(
+                    inputInfo,
+                    audioDataList,
+                    state.playback,
+                    t,
+                    copySize);
+                if (!audioLayers.empty())
+                {
+                    // Mix the audio layers.
+                    const auto now = std::chrono::steady_clock::now();
+                    if (state.mute || now < state.muteTimeout)
                     {
-                        audioLayers = audioCopy(
-                            inputInfo,
-                            audioDataList,
-                            state.playback,
-                            t,
-                            copySize);
+                        state.volume = 0.F;
                     }
-                    if (!audioLayers.empty())
-                    {
-                        // Mix the audio layers.
-                        const auto now = std::chrono::steady_clock::now();
-                        if (state.mute || now < state.muteTimeout)
-                        {
-                            state.volume = 0.F;
-                        }
-                        auto audio = audio::mix(audioLayers, state.volume, state.channelMute);
+                    auto audio = audio::mix(audioLayers, state.volume, state.channelMute);
 
-                        // Reverse the audio.
-                        if (Playback::Reverse == state.playback)
-                        {
-                            audio = audio::reverse(audio);
-                        }
-
-                        // Change the audio speed.
-                        if (state.speed != timeRange.duration().rate() && state.speed > 0.0)
-                        {
-                            audio = audio::changeSpeed(audio, timeRange.duration().rate() / state.speed);
-                        }
-
-                        // Resample the audio and add it to the buffer.
-                        audioThread.buffer.push_back(audioThread.resample->process(audio));
+                    // Reverse the audio.
+                    if (Playback::Reverse == state.playback)
+                    {
+                        audio = audio::reverse(audio);
+                    }
 
-                        // Update the frame counters.
-                        audioThread.inputFrame += audioLayers[0]->getSampleCount();
-                        audioThread.outputFrame += audio->getSampleCount();
+                    // Change the audio speed.
+                    if (state.speed != timelineRate && state.speed > 0.0)
+                    {
+                        audio = audio::changeSpeed(audio, timelineRate / state.speed);
                     }
-                    else
+
+                    // Resample the audio and add it to the buffer.
+                    if (auto resampled = thread.audioResample->process(audio))
                     {
-                        const int64_t frames = OTIO_NS::RationalTime(outputSamples, outputInfo.sampleRate).
-                            rescaled_to(inputInfo.sampleRate).value();
-                        audioThread.inputFrame += frames;
-                        audioThread.outputFrame += frames;
+                        thread.audioBuffer.push_back(resampled);
+                        bufferSampleCount += resampled->getSampleCount();
                     }
+                    thread.audioInputFrame += audioLayers[0]->getSampleCount();
                 }
-
-                // Send the audio data to the device.
-                const size_t bufferSampleCount = getSampleCount(audioThread.buffer);
-                if (outputSamples <= bufferSampleCount)
+                else
                 {
-                    audio::move(audioThread.buffer, outputBuffer, outputSamples);
+                    // Add silence when the audio is not cached so that
+                    // playback continues. The silence is limited to the
+                    // audio buffer size so the audio is not delayed when it
+                    // is cached.
+                    const size_t sampleCount = std::min(
+                        writeAvailable - bufferSampleCount,
+                        playerOptions.audioBufferFrameCount);
+                    auto audio = audio::Audio::create(outputInfo, sampleCount);
+                    audio->zero();
+                    thread.audioBuffer.push_back(audio);
+                    thread.audioInputFrame += OTIO_NS::RationalTime(
+                        sampleCount * speedMult,
+                        outputInfo.sampleRate).
+                        rescaled_to(inputInfo.sampleRate).value();
+                    break;
                 }
+            }
 
-                // Update the frame counter.
-                {
-                    const double speedMult = timeRange.duration().rate() > 0.0 ?
-                        (state.speed / timeRange.duration().rate()) :
-                        0.0;
-                    std::unique_lock<std::mutex> lock(audioMutex.mutex);
-                    audioMutex.frame = audioThread.outputFrame * speedMult;
-                }
+            // Write the audio buffer to the ring buffer.
+            const size_t sampleCount = std::min(
+                audio::getSampleCount(thread.audioBuffer),
+                thread.audioRingBuffer->getWriteAvailable());
+            if (sampleCount > 0)
+            {
+                thread.audioData.resize(sampleCount * outputInfo.getByteCount());
+                audio::move(thread.audioBuffer, thread.audioData.data(), sampleCount);
+                thread.audioRingBuffer->write(thread.audioData.data(), sampleCount);
             }
         }
 
+#if defined(TLRENDER_SDL2) || defined(TLRENDER_SDL3)
+        void Player::Private::sdlCallback(
+            uint8_t* outputBuffer,
+            int len)
+        {
+            // The audio is mixed and resampled into the ring buffer by the
+            // player thread.
+            audioCallback(audioRingBuffer, outputBuffer, len);
+        }
+
 #if defined(TLRENDER_SDL2)
         void Player::Private::sdl2Callback(
             void* userData,
@@ -486,12 +522,16 @@ namespace tl
             int additional_amount,
             int total_amount)
         {
+            // The amount is in bytes. The buffer is allocated when the
+            // audio device is opened.
             auto p = reinterpret_cast<Player::Private*>(userData);
-            if (additional_amount > 0)
+            const int bufferSize = static_cast<int>(p->sdlBuffer.size());
+            while (additional_amount > 0 && bufferSize > 0)
             {
-                std::vector<uint8_t> buf(additional_amount * p->audioThread.info.getByteCount());
-                p->sdlCallback(buf.data(), buf.size());
-                SDL_PutAudioStreamData(stream, buf.data(), buf.size());
+                const int size = std::min(additional_amount, bufferSize);
+                p->sdlCallback(p->sdlBuffer.data(), size);
+                SDL_PutAudioStreamData(stream, p->sdlBuffer.data(), size);
+                additional_amount -= size;
             }
         }
 #endif // TLRENDER_SDL2
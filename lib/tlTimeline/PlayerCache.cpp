@@ -0,0 +1,494 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlTimeline/PlayerCache.h>
+
+#include <tlCore/MemorySystem.h>
+
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <mutex>
+
+namespace tl
+{
+    namespace timeline
+    {
+        namespace
+        {
+            float getWeight(PlayerCachePriority value)
+            {
+                const std::array<float, static_cast<size_t>(PlayerCachePriority::Count)> data =
+                {
+                    0.F,
+                    1.F,
+                    4.F,
+                    16.F
+                };
+                return data[static_cast<size_t>(value)];
+            }
+        }
+
+        PlayerVideoCache::PlayerVideoCache()
+        {}
+
+        PlayerVideoCache::~PlayerVideoCache()
+        {}
+
+        const OTIO_NS::TimeRange& PlayerVideoCache::getTimeRange() const
+        {
+            return _pages.getTimeRange();
+        }
+
+        void PlayerVideoCache::setTimeRange(const OTIO_NS::TimeRange& value)
+        {
+            _pages.setTimeRange(value);
+            _images.clear();
+            _byteCount = 0;
+        }
+
+        size_t PlayerVideoCache::getSize() const
+        {
+            return _pages.getSize();
+        }
+
+        size_t PlayerVideoCache::getByteCount() const
+        {
+            return _byteCount;
+        }
+
+        std::vector<OTIO_NS::TimeRange> PlayerVideoCache::getRanges() const
+        {
+            return _pages.getRanges();
+        }
+
+        bool PlayerVideoCache::contains(const OTIO_NS::RationalTime& time) const
+        {
+            return _pages.get(time) != nullptr;
+        }
+
+        const std::vector<VideoData>* PlayerVideoCache::get(const OTIO_NS::RationalTime& time) const
+        {
+            return _pages.get(time);
+        }
+
+        const std::vector<VideoData>* PlayerVideoCache::getNearest(const OTIO_NS::RationalTime& time) const
+        {
+            return _pages.getNearest(time);
+        }
+
+        void PlayerVideoCache::add(
+            const OTIO_NS::RationalTime& time,
+            const std::vector<VideoData>& videoData)
+        {
+            if (_pages.add(
+                time,
+                videoData,
+                [this](const OTIO_NS::RationalTime&, std::vector<VideoData>&& value)
+                {
+                    _removeImages(value);
+                }))
+            {
+                _addImages(videoData);
+            }
+        }
+
+        bool PlayerVideoCache::remove(const std::vector<OTIO_NS::TimeRange>& ranges)
+        {
+            return _pages.remove(
+                ranges,
+                [this](const OTIO_NS::RationalTime&, std::vector<VideoData>&& value)
+                {
+                    _removeImages(value);
+                });
+        }
+
+        bool PlayerVideoCache::keep(
+            const std::vector<OTIO_NS::TimeRange>& ranges,
+            std::vector<std::pair<OTIO_NS::RationalTime, std::vector<VideoData> > >* removed)
+        {
+            return _pages.keep(
+                ranges,
+                [this, removed](const OTIO_NS::RationalTime& time, std::vector<VideoData>&& value)
+                {
+                    _removeImages(value);
+                    if (removed)
+                    {
+                        removed->push_back(std::make_pair(time, std::move(value)));
+                    }
+                });
+        }
+
+        void PlayerVideoCache::clear()
+        {
+            _pages.clear();
+            _images.clear();
+            _byteCount = 0;
+        }
+
+        void PlayerVideoCache::_addImages(const std::vector<VideoData>& videoData)
+        {
+            for (const auto& i : videoData)
+            {
+                for (const auto& layer : i.layers)
+                {
+                    for (const auto& image : { layer.image, layer.imageB })
+                    {
+                        if (image && 0 == _images[image.get()]++)
+                        {
+                            _byteCount += image->getInfo().getByteCount();
+                        }
+                    }
+                }
+            }
+        }
+
+        void PlayerVideoCache::_removeImages(const std::vector<VideoData>& videoData)
+        {
+            for (const auto& i : videoData)
+            {
+                for (const auto& layer : i.layers)
+                {
+                    for (const auto& image : { layer.image, layer.imageB })
+                    {
+                        if (image)
+                        {
+                            const auto j = _images.find(image.get());
+                            if (j != _images.end() && 0 == --j->second)
+                            {
+                                _byteCount -= image->getInfo().getByteCount();
+                                _images.erase(j);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        std::shared_ptr<PlayerCompressedVideo> compressVideo(const std::vector<VideoData>& videoData)
+        {
+            auto out = std::make_shared<PlayerCompressedVideo>();
+            out->videoData = videoData;
+
+            // Images that are shared between layers are only compressed
+            // once.
+            std::map<const ftk::Image*, int> indexes;
+            for (auto& i : out->videoData)
+            {
+                for (auto& layer : i.layers)
+                {
+                    for (auto image : { &layer.image, &layer.imageB })
+                    {
+                        int index = -1;
+                        if (*image)
+                        {
+                            const auto j = indexes.find(image->get());
+                            if (j != indexes.end())
+                            {
+                                index = j->second;
+                            }
+                            else
+                            {
+                                index = static_cast<int>(out->images.size());
+                                indexes[image->get()] = index;
+                                out->images.push_back(io::compressImage(*image));
+                                out->byteCount += out->images.back().data.size();
+                                out->rawByteCount += (*image)->getInfo().getByteCount();
+                            }
+                            image->reset();
+                        }
+                        out->imageIndexes.push_back(index);
+                    }
+                }
+            }
+            return out;
+        }
+
+        std::vector<VideoData> decompressVideo(const PlayerCompressedVideo& value)
+        {
+            std::vector<std::shared_ptr<ftk::Image> > images;
+            for (const auto& image : value.images)
+            {
+                images.push_back(io::decompressImage(image));
+            }
+            std::vector<VideoData> out = value.videoData;
+            size_t i = 0;
+            for (auto& videoData : out)
+            {
+                for (auto& layer : videoData.layers)
+                {
+                    for (auto image : { &layer.image, &layer.imageB })
+                    {
+                        if (i < value.imageIndexes.size() && value.imageIndexes[i] >= 0)
+                        {
+                            *image = images[value.imageIndexes[i]];
+                        }
+                        ++i;
+                    }
+                }
+            }
+            return out;
+        }
+
+        PlayerCompressedVideoCache::PlayerCompressedVideoCache()
+        {}
+
+        PlayerCompressedVideoCache::~PlayerCompressedVideoCache()
+        {}
+
+        const OTIO_NS::TimeRange& PlayerCompressedVideoCache::getTimeRange() const
+        {
+            return _pages.getTimeRange();
+        }
+
+        void PlayerCompressedVideoCache::setTimeRange(const OTIO_NS::TimeRange& value)
+        {
+            _pages.setTimeRange(value);
+            _byteCount = 0;
+            _rawByteCount = 0;
+        }
+
+        size_t PlayerCompressedVideoCache::getSize() const
+        {
+            return _pages.getSize();
+        }
+
+        size_t PlayerCompressedVideoCache::getByteCount() const
+        {
+            return _byteCount;
+        }
+
+        float PlayerCompressedVideoCache::getRatio() const
+        {
+            return _byteCount > 0 ?
+                (_rawByteCount / static_cast<float>(_byteCount)) :
+                0.F;
+        }
+
+        bool PlayerCompressedVideoCache::contains(const OTIO_NS::RationalTime& time) const
+        {
+            return _pages.get(time) != nullptr;
+        }
+
+        std::shared_ptr<PlayerCompressedVideo> PlayerCompressedVideoCache::get(const OTIO_NS::RationalTime& time) const
+        {
+            const auto out = _pages.get(time);
+            return out ? *out : nullptr;
+        }
+
+        void PlayerCompressedVideoCache::add(
+            const OTIO_NS::RationalTime& time,
+            const std::shared_ptr<PlayerCompressedVideo>& value)
+        {
+            if (value && _pages.add(
+                time,
+                value,
+                [this](const OTIO_NS::RationalTime&, std::shared_ptr<PlayerCompressedVideo>&& value)
+                {
+                    _remove(value);
+                }))
+            {
+                _byteCount += value->byteCount;
+                _rawByteCount += value->rawByteCount;
+            }
+        }
+
+        bool PlayerCompressedVideoCache::remove(const std::vector<OTIO_NS::TimeRange>& ranges)
+        {
+            return _pages.remove(
+                ranges,
+                [this](const OTIO_NS::RationalTime&, std::shared_ptr<PlayerCompressedVideo>&& value)
+                {
+                    _remove(value);
+                });
+        }
+
+        bool PlayerCompressedVideoCache::keep(
+            const std::vector<OTIO_NS::TimeRange>& ranges,
+            std::vector<std::pair<OTIO_NS::RationalTime, std::shared_ptr<PlayerCompressedVideo> > >* removed)
+        {
+            return _pages.keep(
+                ranges,
+                [this, removed](const OTIO_NS::RationalTime& time, std::shared_ptr<PlayerCompressedVideo>&& value)
+                {
+                    _remove(value);
+                    if (removed)
+                    {
+                        removed->push_back(std::make_pair(time, std::move(value)));
+                    }
+                });
+        }
+
+        void PlayerCompressedVideoCache::clear()
+        {
+            _pages.clear();
+            _byteCount = 0;
+            _rawByteCount = 0;
+        }
+
+        void PlayerCompressedVideoCache::_remove(const std::shared_ptr<PlayerCompressedVideo>& value)
+        {
+            _byteCount -= value->byteCount;
+            _rawByteCount -= value->rawByteCount;
+        }
+
+        struct PlayerCacheSystem::Private
+        {
+            std::weak_ptr<memory::System> memorySystem;
+            int memoryCache = 0;
+            PlayerCacheBudget budget;
+            float scale = 1.F;
+            std::map<const Player*, PlayerCachePriority> players;
+            mutable std::mutex mutex;
+        };
+
+        PlayerCacheSystem::PlayerCacheSystem(const std::shared_ptr<ftk::Context>& context) :
+            ISystem(context, "tl::timeline::PlayerCacheSystem"),
+            _p(new Private)
+        {
+            FTK_P();
+
+            // Shrink the caches when the memory pressure is high.
+            if (auto memorySystem = context->getSystem<memory::System>())
+            {
+                p.memorySystem = memorySystem;
+                p.memoryCache = memorySystem->addCache(
+                    [this](float value)
+                    {
+                        std::unique_lock<std::mutex> lock(_p->mutex);
+                        _p->scale = value;
+                    });
+            }
+        }
+
+        PlayerCacheSystem::~PlayerCacheSystem()
+        {
+            FTK_P();
+            if (auto memorySystem = p.memorySystem.lock())
+            {
+                memorySystem->removeCache(p.memoryCache);
+            }
+        }
+
+        std::shared_ptr<PlayerCacheSystem> PlayerCacheSystem::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            auto out = context->getSystem<PlayerCacheSystem>();
+            if (!out)
+            {
+                out = std::shared_ptr<PlayerCacheSystem>(new PlayerCacheSystem(context));
+                context->addSystem(out);
+            }
+            return out;
+        }
+
+        PlayerCacheBudget PlayerCacheSystem::getBudget() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.budget;
+        }
+
+        void PlayerCacheSystem::setBudget(const PlayerCacheBudget& value)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex);
+                p.budget = value;
+            }
+            _log(ftk::Format("Budget: {0}GB video, {1}GB audio").
+                arg(value.videoGB).
+                arg(value.audioGB));
+        }
+
+        size_t PlayerCacheSystem::getPlayerCount() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            return p.players.size();
+        }
+
+        void PlayerCacheSystem::addPlayer(const Player* player, PlayerCachePriority priority)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.players[player] = priority;
+        }
+
+        void PlayerCacheSystem::removePlayer(const Player* player)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            p.players.erase(player);
+        }
+
+        void PlayerCacheSystem::setPriority(const Player* player, PlayerCachePriority priority)
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.players.find(player);
+            if (i != p.players.end())
+            {
+                i->second = priority;
+            }
+        }
+
+        PlayerCacheOptions PlayerCacheSystem::getCacheOptions(
+            const Player* player,
+            const PlayerCacheOptions& options) const
+        {
+            FTK_P();
+            PlayerCacheOptions out = options;
+            std::unique_lock<std::mutex> lock(p.mutex);
+            const auto i = p.players.find(player);
+            if (i != p.players.end() && PlayerCachePriority::Preload == i->second)
+            {
+                // Preloading players share the preload budget evenly and
+                // only cache the first frames ahead of the current time.
+                if (p.budget.preloadVideoGB > 0.F)
+                {
+                    const size_t count = std::count_if(
+                        p.players.begin(),
+                        p.players.end(),
+                        [](const auto& value)
+                        {
+                            return PlayerCachePriority::Preload == value.second;
+                        });
+                    out.videoGB = p.budget.preloadVideoGB / count;
+                }
+                out.readBehind = 0.F;
+                out.videoCompressedGB = 0.F;
+                out.videoFrames = p.budget.preloadFrames;
+            }
+            else if (i != p.players.end())
+            {
+                float weightSum = 0.F;
+                for (const auto& j : p.players)
+                {
+                    weightSum += getWeight(j.second);
+                }
+                const float share = getWeight(i->second) / weightSum;
+                if (p.budget.videoGB > 0.F)
+                {
+                    out.videoGB = p.budget.videoGB * share;
+                }
+                if (p.budget.audioGB > 0.F)
+                {
+                    out.audioGB = p.budget.audioGB * share;
+                }
+                if (p.budget.videoCompressedGB > 0.F)
+                {
+                    out.videoCompressedGB = p.budget.videoCompressedGB * share;
+                }
+            }
+            out.videoGB *= p.scale;
+            out.videoCompressedGB *= p.scale;
+            out.audioGB *= p.scale;
+            out.pinnedVideoGB *= p.scale;
+            out.pinnedAudioGB *= p.scale;
+            return out;
+        }
+    }
+}
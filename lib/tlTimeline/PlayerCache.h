@@ -0,0 +1,294 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlTimeline/PlayerOptions.h>
+#include <tlTimeline/Video.h>
+
+#include <tlIO/Compress.h>
+
+#include <tlCore/ISystem.h>
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace tl
+{
+    namespace timeline
+    {
+        class Player;
+
+        //! Paged frame storage for the timeline player caches.
+        //!
+        //! Frames are stored in pages indexed by the frame number relative
+        //! to the start of the time range, so lookup, insertion, and removal
+        //! are constant time. The cached frames are also kept as a set of
+        //! intervals, so getting the cached ranges and removing frames
+        //! outside of the cache ranges depend on the number of intervals
+        //! instead of the number of frames. The functions that remove
+        //! frames pass them to a callback, so the caches can update their
+        //! byte counts.
+        template<typename T>
+        class PlayerCachePages
+        {
+        public:
+            //! Get the time range.
+            const OTIO_NS::TimeRange& getTimeRange() const;
+
+            //! Set the time range. This also clears the pages.
+            void setTimeRange(const OTIO_NS::TimeRange&);
+
+            //! Get the number of frames.
+            size_t getSize() const;
+
+            //! Get the ranges of the frames.
+            std::vector<OTIO_NS::TimeRange> getRanges() const;
+
+            //! Get a frame, or nullptr if there is no frame.
+            const T* get(const OTIO_NS::RationalTime&) const;
+
+            //! Get the frame nearest to the given time, or nullptr if there
+            //! are no frames.
+            const T* getNearest(const OTIO_NS::RationalTime&) const;
+
+            //! Add a frame. A replaced frame is passed to the callback.
+            //! Returns false if the frame is outside of the time range.
+            template<typename F>
+            bool add(const OTIO_NS::RationalTime&, const T&, F&& removed);
+
+            //! Remove the frames inside of the given ranges. Returns whether
+            //! any frames were removed.
+            template<typename F>
+            bool remove(const std::vector<OTIO_NS::TimeRange>&, F&& removed);
+
+            //! Remove the frames outside of the given ranges. Returns
+            //! whether any frames were removed.
+            template<typename F>
+            bool keep(const std::vector<OTIO_NS::TimeRange>&, F&& removed);
+
+            //! Clear the frames.
+            void clear();
+
+        private:
+            int64_t _toFrame(const OTIO_NS::RationalTime&) const;
+            int64_t _getIndex(const OTIO_NS::RationalTime&) const;
+            std::vector<std::pair<int64_t, int64_t> > _getIndexRanges(
+                const std::vector<OTIO_NS::TimeRange>&) const;
+            template<typename F>
+            bool _removeRange(int64_t min, int64_t max, F& removed);
+
+            static constexpr int64_t pageSize = 1024;
+
+            struct Page
+            {
+                std::vector<T> frames;
+                std::vector<bool> valid;
+                size_t count = 0;
+            };
+
+            OTIO_NS::TimeRange _timeRange = time::invalidTimeRange;
+            double _rate = 0.0;
+            int64_t _start = 0;
+            int64_t _frameCount = 0;
+            std::vector<std::unique_ptr<Page> > _pages;
+            std::map<int64_t, int64_t> _intervals;
+            size_t _size = 0;
+        };
+
+        //! Timeline player video cache.
+        //!
+        //! The frames are stored in PlayerCachePages.
+        class PlayerVideoCache
+        {
+        public:
+            PlayerVideoCache();
+            ~PlayerVideoCache();
+
+            //! Get the time range.
+            const OTIO_NS::TimeRange& getTimeRange() const;
+
+            //! Set the time range. This also clears the cache.
+            void setTimeRange(const OTIO_NS::TimeRange&);
+
+            //! Get the number of cached frames.
+            size_t getSize() const;
+
+            //! Get the number of bytes used by the cached images. Images
+            //! that are shared between frames are only counted once.
+            size_t getByteCount() const;
+
+            //! Get the cached ranges.
+            std::vector<OTIO_NS::TimeRange> getRanges() const;
+
+            //! Get whether a frame is cached.
+            bool contains(const OTIO_NS::RationalTime&) const;
+
+            //! Get a cached frame, or nullptr if the frame is not cached.
+            const std::vector<VideoData>* get(const OTIO_NS::RationalTime&) const;
+
+            //! Get the cached frame nearest to the given time, or nullptr if
+            //! the cache is empty.
+            const std::vector<VideoData>* getNearest(const OTIO_NS::RationalTime&) const;
+
+            //! Add a frame. Frames outside of the time range are ignored.
+            void add(const OTIO_NS::RationalTime&, const std::vector<VideoData>&);
+
+            //! Remove the frames inside of the given ranges. Returns whether
+            //! any frames were removed.
+            bool remove(const std::vector<OTIO_NS::TimeRange>&);
+
+            //! Remove the frames outside of the given ranges. The removed
+            //! frames are optionally returned. Returns whether any frames
+            //! were removed.
+            bool keep(
+                const std::vector<OTIO_NS::TimeRange>&,
+                std::vector<std::pair<OTIO_NS::RationalTime, std::vector<VideoData> > >* removed = nullptr);
+
+            //! Clear the cache.
+            void clear();
+
+        private:
+            void _addImages(const std::vector<VideoData>&);
+            void _removeImages(const std::vector<VideoData>&);
+
+            PlayerCachePages<std::vector<VideoData> > _pages;
+            std::unordered_map<const ftk::Image*, size_t> _images;
+            size_t _byteCount = 0;
+        };
+
+        //! Losslessly compressed video frame.
+        struct PlayerCompressedVideo
+        {
+            //! Video data with the images removed.
+            std::vector<VideoData> videoData;
+
+            //! Compressed images.
+            std::vector<io::CompressedImage> images;
+
+            //! Index of the image for each layer of the video data, first
+            //! the image and then image B. The index is -1 for layers
+            //! without an image.
+            std::vector<int> imageIndexes;
+
+            //! Size of the compressed images in bytes.
+            size_t byteCount = 0;
+
+            //! Size of the uncompressed images in bytes.
+            size_t rawByteCount = 0;
+        };
+
+        //! Compress video.
+        std::shared_ptr<PlayerCompressedVideo> compressVideo(const std::vector<VideoData>&);
+
+        //! Decompress video.
+        std::vector<VideoData> decompressVideo(const PlayerCompressedVideo&);
+
+        //! Timeline player compressed video cache.
+        //!
+        //! The frames are stored in PlayerCachePages.
+        class PlayerCompressedVideoCache
+        {
+        public:
+            PlayerCompressedVideoCache();
+            ~PlayerCompressedVideoCache();
+
+            //! Get the time range.
+            const OTIO_NS::TimeRange& getTimeRange() const;
+
+            //! Set the time range. This also clears the cache.
+            void setTimeRange(const OTIO_NS::TimeRange&);
+
+            //! Get the number of cached frames.
+            size_t getSize() const;
+
+            //! Get the number of bytes used by the compressed images.
+            size_t getByteCount() const;
+
+            //! Get the compression ratio, the size of the uncompressed
+            //! images divided by the size of the compressed images. Zero
+            //! if the cache is empty.
+            float getRatio() const;
+
+            //! Get whether a frame is cached.
+            bool contains(const OTIO_NS::RationalTime&) const;
+
+            //! Get a cached frame, or nullptr if the frame is not cached.
+            std::shared_ptr<PlayerCompressedVideo> get(const OTIO_NS::RationalTime&) const;
+
+            //! Add a frame. Frames outside of the time range are ignored.
+            void add(const OTIO_NS::RationalTime&, const std::shared_ptr<PlayerCompressedVideo>&);
+
+            //! Remove the frames inside of the given ranges. Returns whether
+            //! any frames were removed.
+            bool remove(const std::vector<OTIO_NS::TimeRange>&);
+
+            //! Remove the frames outside of the given ranges. The removed
+            //! frames are optionally returned. Returns whether any frames
+            //! were removed.
+            bool keep(
+                const std::vector<OTIO_NS::TimeRange>&,
+                std::vector<std::pair<OTIO_NS::RationalTime, std::shared_ptr<PlayerCompressedVideo> > >* removed = nullptr);
+
+            //! Clear the cache.
+            void clear();
+
+        private:
+            void _remove(const std::shared_ptr<PlayerCompressedVideo>&);
+
+            PlayerCachePages<std::shared_ptr<PlayerCompressedVideo> > _pages;
+            size_t _byteCount = 0;
+            size_t _rawByteCount = 0;
+        };
+
+        //! Timeline player cache system.
+        //!
+        //! The system splits a process-wide cache budget across the players
+        //! that are alive, weighted by their priority. Players are added
+        //! and removed automatically when they are created and destroyed.
+        //! The caches are also scaled by the memory system when the memory
+        //! pressure is high. The pinned caches are not shared since each
+        //! player pins its own ranges, they are only scaled.
+        class PlayerCacheSystem : public system::ISystem
+        {
+            FTK_NON_COPYABLE(PlayerCacheSystem);
+
+        protected:
+            PlayerCacheSystem(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            virtual ~PlayerCacheSystem();
+
+            //! Create a new system.
+            static std::shared_ptr<PlayerCacheSystem> create(const std::shared_ptr<ftk::Context>&);
+
+            //! Get the cache budget.
+            PlayerCacheBudget getBudget() const;
+
+            //! Set the cache budget.
+            void setBudget(const PlayerCacheBudget&);
+
+            //! Get the number of players.
+            size_t getPlayerCount() const;
+
+            //! Add a player.
+            void addPlayer(const Player*, PlayerCachePriority = PlayerCachePriority::Normal);
+
+            //! Remove a player.
+            void removePlayer(const Player*);
+
+            //! Set a player's priority.
+            void setPriority(const Player*, PlayerCachePriority);
+
+            //! Get the cache options for a player with its share of the
+            //! budget applied.
+            PlayerCacheOptions getCacheOptions(const Player*, const PlayerCacheOptions&) const;
+
+        private:
+            FTK_PRIVATE();
+        };
+    }
+}
+
+#include <tlTimeline/PlayerCacheInline.h>
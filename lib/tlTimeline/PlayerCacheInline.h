@@ -0,0 +1,320 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <algorithm>
+#include <iterator>
+
+namespace tl
+{
+    namespace timeline
+    {
+        template<typename T>
+        inline const OTIO_NS::TimeRange& PlayerCachePages<T>::getTimeRange() const
+        {
+            return _timeRange;
+        }
+
+        template<typename T>
+        inline void PlayerCachePages<T>::setTimeRange(const OTIO_NS::TimeRange& value)
+        {
+            clear();
+            _timeRange = value;
+            _rate = value.duration().rate();
+            _start = 0;
+            _frameCount = 0;
+            if (_rate > 0.0)
+            {
+                _start = static_cast<int64_t>(value.start_time().rescaled_to(_rate).round().value());
+                _frameCount = static_cast<int64_t>(value.duration().rescaled_to(_rate).round().value());
+            }
+            _pages.clear();
+            _pages.resize((std::max(_frameCount, int64_t(0)) + pageSize - 1) / pageSize);
+        }
+
+        template<typename T>
+        inline size_t PlayerCachePages<T>::getSize() const
+        {
+            return _size;
+        }
+
+        template<typename T>
+        inline std::vector<OTIO_NS::TimeRange> PlayerCachePages<T>::getRanges() const
+        {
+            std::vector<OTIO_NS::TimeRange> out;
+            for (const auto& i : _intervals)
+            {
+                out.push_back(OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(_start + i.first, _rate),
+                    OTIO_NS::RationalTime(i.second - i.first + 1, _rate)));
+            }
+            return out;
+        }
+
+        template<typename T>
+        inline const T* PlayerCachePages<T>::get(const OTIO_NS::RationalTime& time) const
+        {
+            const T* out = nullptr;
+            const int64_t index = _getIndex(time);
+            if (index >= 0)
+            {
+                const auto& page = _pages[index / pageSize];
+                const int64_t slot = index % pageSize;
+                if (page && page->valid[slot])
+                {
+                    out = &page->frames[slot];
+                }
+            }
+            return out;
+        }
+
+        template<typename T>
+        inline const T* PlayerCachePages<T>::getNearest(const OTIO_NS::RationalTime& time) const
+        {
+            const T* out = nullptr;
+            if (_rate > 0.0 && !_intervals.empty())
+            {
+                const int64_t index = std::min(
+                    std::max(_toFrame(time) - _start, int64_t(0)),
+                    _frameCount - 1);
+                int64_t nearest = -1;
+                const auto next = _intervals.upper_bound(index);
+                if (next != _intervals.begin())
+                {
+                    const auto prev = std::prev(next);
+                    nearest = prev->second >= index ? index : prev->second;
+                }
+                if (next != _intervals.end() &&
+                    (nearest < 0 || next->first - index < index - nearest))
+                {
+                    nearest = next->first;
+                }
+                if (nearest >= 0)
+                {
+                    out = &_pages[nearest / pageSize]->frames[nearest % pageSize];
+                }
+            }
+            return out;
+        }
+
+        template<typename T>
+        template<typename F>
+        inline bool PlayerCachePages<T>::add(
+            const OTIO_NS::RationalTime& time,
+            const T& value,
+            F&& removed)
+        {
+            const int64_t index = _getIndex(time);
+            if (index < 0)
+            {
+                return false;
+            }
+
+            auto& page = _pages[index / pageSize];
+            if (!page)
+            {
+                page.reset(new Page);
+                page->frames.resize(pageSize);
+                page->valid.resize(pageSize, false);
+            }
+            const int64_t slot = index % pageSize;
+            if (page->valid[slot])
+            {
+                removed(time, std::move(page->frames[slot]));
+                page->frames[slot] = value;
+                return true;
+            }
+            page->frames[slot] = value;
+            page->valid[slot] = true;
+            ++page->count;
+            ++_size;
+
+            // Merge the frame with the neighboring intervals.
+            auto next = _intervals.upper_bound(index);
+            auto prev = _intervals.end();
+            if (next != _intervals.begin())
+            {
+                auto i = std::prev(next);
+                if (i->second + 1 == index)
+                {
+                    i->second = index;
+                    prev = i;
+                }
+            }
+            if (next != _intervals.end() && next->first == index + 1)
+            {
+                if (prev != _intervals.end())
+                {
+                    prev->second = next->second;
+                }
+                else
+                {
+                    _intervals[index] = next->second;
+                }
+                _intervals.erase(next);
+            }
+            else if (prev == _intervals.end())
+            {
+                _intervals[index] = index;
+            }
+            return true;
+        }
+
+        template<typename T>
+        template<typename F>
+        inline bool PlayerCachePages<T>::remove(
+            const std::vector<OTIO_NS::TimeRange>& ranges,
+            F&& removed)
+        {
+            bool out = false;
+            for (const auto& range : _getIndexRanges(ranges))
+            {
+                out |= _removeRange(range.first, range.second, removed);
+            }
+            return out;
+        }
+
+        template<typename T>
+        template<typename F>
+        inline bool PlayerCachePages<T>::keep(
+            const std::vector<OTIO_NS::TimeRange>& ranges,
+            F&& removed)
+        {
+            bool out = false;
+            int64_t min = 0;
+            for (const auto& range : _getIndexRanges(ranges))
+            {
+                if (range.first > min)
+                {
+                    out |= _removeRange(min, range.first - 1, removed);
+                }
+                min = range.second + 1;
+            }
+            if (min < _frameCount)
+            {
+                out |= _removeRange(min, _frameCount - 1, removed);
+            }
+            return out;
+        }
+
+        template<typename T>
+        inline void PlayerCachePages<T>::clear()
+        {
+            for (auto& page : _pages)
+            {
+                page.reset();
+            }
+            _intervals.clear();
+            _size = 0;
+        }
+
+        template<typename T>
+        inline int64_t PlayerCachePages<T>::_toFrame(const OTIO_NS::RationalTime& time) const
+        {
+            return static_cast<int64_t>(time.rescaled_to(_rate).round().value());
+        }
+
+        template<typename T>
+        inline int64_t PlayerCachePages<T>::_getIndex(const OTIO_NS::RationalTime& time) const
+        {
+            int64_t out = -1;
+            if (_rate > 0.0)
+            {
+                const int64_t index = _toFrame(time) - _start;
+                if (index >= 0 && index < _frameCount)
+                {
+                    out = index;
+                }
+            }
+            return out;
+        }
+
+        template<typename T>
+        inline std::vector<std::pair<int64_t, int64_t> > PlayerCachePages<T>::_getIndexRanges(
+            const std::vector<OTIO_NS::TimeRange>& ranges) const
+        {
+            std::vector<std::pair<int64_t, int64_t> > out;
+            if (_rate > 0.0)
+            {
+                std::vector<std::pair<int64_t, int64_t> > tmp;
+                for (const auto& range : ranges)
+                {
+                    const int64_t min = std::max(
+                        _toFrame(range.start_time()) - _start,
+                        int64_t(0));
+                    const int64_t max = std::min(
+                        _toFrame(range.end_time_exclusive()) - 1 - _start,
+                        _frameCount - 1);
+                    if (min <= max)
+                    {
+                        tmp.push_back(std::make_pair(min, max));
+                    }
+                }
+                std::sort(tmp.begin(), tmp.end());
+                for (const auto& range : tmp)
+                {
+                    if (!out.empty() && range.first <= out.back().second + 1)
+                    {
+                        out.back().second = std::max(out.back().second, range.second);
+                    }
+                    else
+                    {
+                        out.push_back(range);
+                    }
+                }
+            }
+            return out;
+        }
+
+        template<typename T>
+        template<typename F>
+        inline bool PlayerCachePages<T>::_removeRange(int64_t min, int64_t max, F& removed)
+        {
+            bool out = false;
+            auto i = _intervals.upper_bound(min);
+            if (i != _intervals.begin())
+            {
+                auto j = std::prev(i);
+                if (j->second >= min)
+                {
+                    i = j;
+                }
+            }
+            while (i != _intervals.end() && i->first <= max)
+            {
+                const int64_t first = i->first;
+                const int64_t last = i->second;
+                const int64_t removeFirst = std::max(first, min);
+                const int64_t removeLast = std::min(last, max);
+                for (int64_t index = removeFirst; index <= removeLast; ++index)
+                {
+                    auto& page = _pages[index / pageSize];
+                    const int64_t slot = index % pageSize;
+                    if (page && page->valid[slot])
+                    {
+                        removed(
+                            OTIO_NS::RationalTime(_start + index, _rate),
+                            std::move(page->frames[slot]));
+                        page->frames[slot] = T();
+                        page->valid[slot] = false;
+                        --_size;
+                        if (0 == --page->count)
+                        {
+                            page.reset();
+                        }
+                    }
+                }
+                out = true;
+                i = _intervals.erase(i);
+                if (first < removeFirst)
+                {
+                    _intervals[first] = removeFirst - 1;
+                }
+                if (last > removeLast)
+                {
+                    _intervals[removeLast + 1] = last;
+                }
+            }
+            return out;
+        }
+    }
+}
@@ -3,6 +3,9 @@
 
 #include <tlTimeline/PlayerOptions.h>
 
+#include <ftk/Core/Error.h>
+#include <ftk/Core/String.h>
+
 namespace tl
 {
     namespace timeline
@@ -12,7 +15,11 @@ namespace tl
             return
                 videoGB == other.videoGB &&
                 audioGB == other.audioGB &&
-                readBehind == other.readBehind;;
+                readBehind == other.readBehind &&
+                videoFrames == other.videoFrames &&
+                videoCompressedGB == other.videoCompressedGB &&
+                pinnedVideoGB == other.pinnedVideoGB &&
+                pinnedAudioGB == other.pinnedAudioGB;
         }
 
         bool PlayerCacheOptions::operator != (const PlayerCacheOptions& other) const
@@ -20,14 +27,43 @@ namespace tl
             return !(*this == other);
         }
 
+        FTK_ENUM_IMPL(
+            PlayerCachePriority,
+            "Preload",
+            "Background",
+            "Normal",
+            "Focused");
+
+        bool PlayerCacheBudget::operator == (const PlayerCacheBudget& other) const
+        {
+            return
+                videoGB == other.videoGB &&
+                audioGB == other.audioGB &&
+                videoCompressedGB == other.videoCompressedGB &&
+                preloadVideoGB == other.preloadVideoGB &&
+                preloadFrames == other.preloadFrames;
+        }
+
+        bool PlayerCacheBudget::operator != (const PlayerCacheBudget& other) const
+        {
+            return !(*this == other);
+        }
+
         bool PlayerOptions::operator == (const PlayerOptions& other) const
         {
             return
                 audioDevice == other.audioDevice &&
                 cache == other.cache &&
                 videoRequestMax == other.videoRequestMax &&
+                videoRequestAdaptive == other.videoRequestAdaptive &&
+                videoRequestLimit == other.videoRequestLimit &&
+                videoBufferAhead == other.videoBufferAhead &&
+                displayRate == other.displayRate &&
+                scrubTimeout == other.scrubTimeout &&
+                scrubProxy == other.scrubProxy &&
                 audioRequestMax == other.audioRequestMax &&
                 audioBufferFrameCount == other.audioBufferFrameCount &&
+                audioRingBufferFrameCount == other.audioRingBufferFrameCount &&
                 muteTimeout == other.muteTimeout &&
                 sleepTimeout == other.sleepTimeout &&
                 currentTime == other.currentTime;
@@ -43,6 +79,10 @@ namespace tl
             json["VideoGB"] = value.videoGB;
             json["AudioGB"] = value.audioGB;
             json["ReadBehind"] = value.readBehind;
+            json["VideoFrames"] = value.videoFrames;
+            json["VideoCompressedGB"] = value.videoCompressedGB;
+            json["PinnedVideoGB"] = value.pinnedVideoGB;
+            json["PinnedAudioGB"] = value.pinnedAudioGB;
         }
 
         void from_json(const nlohmann::json& json, PlayerCacheOptions& value)
@@ -50,6 +90,26 @@ namespace tl
             json.at("VideoGB").get_to(value.videoGB);
             json.at("AudioGB").get_to(value.audioGB);
             json.at("ReadBehind").get_to(value.readBehind);
+            auto i = json.find("VideoFrames");
+            if (i != json.end())
+            {
+                i->get_to(value.videoFrames);
+            }
+            i = json.find("VideoCompressedGB");
+            if (i != json.end())
+            {
+                i->get_to(value.videoCompressedGB);
+            }
+            i = json.find("PinnedVideoGB");
+            if (i != json.end())
+            {
+                i->get_to(value.pinnedVideoGB);
+            }
+            i = json.find("PinnedAudioGB");
+            if (i != json.end())
+            {
+                i->get_to(value.pinnedAudioGB);
+            }
         }
     }
 }
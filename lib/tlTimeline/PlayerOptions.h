@@ -24,10 +24,69 @@ namespace tl
             //! Number of seconds to read behind the current frame.
             float readBehind = .5F;
 
+            //! Maximum number of video frames to cache. Zero uses the video
+            //! cache size.
+            size_t videoFrames = 0;
+
+            //! Compressed video cache size in gigabytes. The frames that are
+            //! removed from the video cache, and the frames after the video
+            //! cache, are kept losslessly compressed and decompressed before
+            //! they are needed. Zero disables the compressed video cache.
+            float videoCompressedGB = 0.F;
+
+            //! Video cache size for the pinned ranges in gigabytes.
+            float pinnedVideoGB = 1.F;
+
+            //! Audio cache size for the pinned ranges in gigabytes.
+            float pinnedAudioGB = .1F;
+
             bool operator == (const PlayerCacheOptions&) const;
             bool operator != (const PlayerCacheOptions&) const;
         };
 
+        //! Timeline player cache priorities. When a process-wide cache
+        //! budget is set, players with a higher priority get a larger share.
+        //! Preloading players only cache the first frames from the current
+        //! time, using the separate preload budget.
+        enum class PlayerCachePriority
+        {
+            Preload,
+            Background,
+            Normal,
+            Focused,
+
+            Count,
+            First = Preload
+        };
+        FTK_ENUM(PlayerCachePriority);
+
+        //! Process-wide timeline player cache budget.
+        struct PlayerCacheBudget
+        {
+            //! Video cache budget in gigabytes. Zero lets each player use
+            //! its own cache options.
+            float videoGB = 0.F;
+
+            //! Audio cache budget in gigabytes. Zero lets each player use
+            //! its own cache options.
+            float audioGB = 0.F;
+
+            //! Compressed video cache budget in gigabytes. Zero lets each
+            //! player use its own cache options.
+            float videoCompressedGB = 0.F;
+
+            //! Video cache budget for the preloading players in gigabytes,
+            //! split evenly between them. Zero lets each preloading player
+            //! use its own cache options.
+            float preloadVideoGB = 0.F;
+
+            //! Number of video frames cached by the preloading players.
+            size_t preloadFrames = 24;
+
+            bool operator == (const PlayerCacheBudget&) const;
+            bool operator != (const PlayerCacheBudget&) const;
+        };
+
         //! Timeline player options.
         struct PlayerOptions
         {
@@ -37,15 +96,50 @@ namespace tl
             //! Cache options.
             PlayerCacheOptions cache;
 
-            //! Maximum number of video requests.
+            //! Maximum number of video requests. When adaptive video requests
+            //! are enabled this is the starting value.
             size_t videoRequestMax = 16;
 
+            //! Adjust the number of video requests from the measured video
+            //! throughput.
+            bool videoRequestAdaptive = true;
+
+            //! Upper limit for the adaptive number of video requests.
+            size_t videoRequestLimit = 128;
+
+            //! Number of seconds of video to buffer ahead of the current
+            //! time. These frames are requested before the rest of the
+            //! cache.
+            float videoBufferAhead = 2.F;
+
+            //! Display rate in frames per second. When playing faster than
+            //! the display rate only the frames that can be displayed are
+            //! requested, the skipped frames are requested when playback
+            //! stops. Zero uses the timeline rate.
+            double displayRate = 0.0;
+
+            //! Time that the current time must be stable while scrubbing
+            //! before the frame is requested.
+            std::chrono::milliseconds scrubTimeout = std::chrono::milliseconds(100);
+
+            //! Proxy scale of the frames that are requested while scrubbing
+            //! (see io::getProxyScale()). Proxy frames are only requested for
+            //! media that supports them (see io::Info::videoProxy), and are
+            //! shown until the full resolution frame is read. A value of one
+            //! disables the proxy requests.
+            int scrubProxy = 4;
+
             //! Maximum number of audio requests.
             size_t audioRequestMax = 16;
 
             //! Audio buffer frame count.
             size_t audioBufferFrameCount = 500;
 
+            //! Number of audio frames that the player thread prepares ahead
+            //! of the audio device. This should be larger than the audio
+            //! buffer frame count and cover the sleep timeout.
+            size_t audioRingBufferFrameCount = 4000;
+
             //! Timeout for muting the audio when playback stutters.
             std::chrono::milliseconds muteTimeout = std::chrono::milliseconds(500);
 
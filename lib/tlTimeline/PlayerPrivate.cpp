@@ -9,10 +9,54 @@
 #include <ftk/Core/Format.h>
 #include <ftk/Core/String.h>
 
+#include <algorithm>
+#include <cmath>
+
 namespace tl
 {
     namespace timeline
     {
+        namespace
+        {
+            const size_t videoRequestAdaptiveMin = 2;
+            const float videoRequestAdaptiveTimeout = .5F;
+            const size_t statsLatencySamples = 1000;
+            const size_t statsLatencyBuckets = 12;
+            const size_t statsDepthSamples = 120;
+            const float videoCompressionRatioDefault = 2.F;
+
+            size_t getVideoCompressJobMax()
+            {
+                return std::max(std::thread::hardware_concurrency() / 2, 2U);
+            }
+
+            size_t getByteCount(const AudioData& value)
+            {
+                size_t out = 0;
+                for (const auto& layer : value.layers)
+                {
+                    if (layer.audio)
+                    {
+                        out += layer.audio->getByteCount();
+                    }
+                }
+                return out;
+            }
+
+            bool contains(
+                const std::vector<OTIO_NS::TimeRange>& ranges,
+                const OTIO_NS::RationalTime& time)
+            {
+                return std::any_of(
+                    ranges.begin(),
+                    ranges.end(),
+                    [&time](const OTIO_NS::TimeRange& range)
+                    {
+                        return range.contains(time);
+                    });
+            }
+        }
+
         OTIO_NS::RationalTime Player::Private::loopPlayback(const OTIO_NS::RationalTime& time, bool& looped)
         {
             OTIO_NS::RationalTime out = time;
@@ -128,9 +172,9 @@ namespace tl
             std::vector<std::vector<uint64_t> > ids(1 + thread.state.compare.size());
             for (const auto& i : thread.videoDataRequests)
             {
-                for (size_t j = 0; j < i.second.size() && j < ids.size(); ++j)
+                for (size_t j = 0; j < i.second.requests.size() && j < ids.size(); ++j)
                 {
-                    ids[j].push_back(i.second[j].id);
+                    ids[j].push_back(i.second.requests[j].id);
                 }
             }
             for (const auto& i : thread.audioDataRequests)
@@ -144,11 +188,114 @@ namespace tl
             }
             thread.videoDataRequests.clear();
             thread.audioDataRequests.clear();
+            scrubCancel();
+            thread.scrubProxyVideoData.clear();
+        }
+
+        void Player::Private::cancelRequests()
+        {
+            // Cancel the requests outside of the new cache window and the
+            // pinned ranges. The requests inside of the window are kept so
+            // that frames that are already being read are not requested
+            // again, for example after a short seek or when playback loops.
+            thread.videoStride = getVideoStride();
+            auto videoRanges = timeline::loop(
+                getVideoCacheRange((getVideoCacheMax() + getVideoCompressedMax()) * thread.videoStride),
+                thread.state.inOutRange);
+            if (isScrubbing(std::chrono::steady_clock::now()))
+            {
+                // While scrubbing only the request for the current frame
+                // is kept, the others are stale.
+                videoRanges = {
+                    OTIO_NS::TimeRange(
+                        thread.state.currentTime,
+                        OTIO_NS::RationalTime(1.0, thread.state.currentTime.rate())) };
+            }
+            else
+            {
+                const auto videoPinnedRanges = getVideoPinnedRanges();
+                videoRanges.insert(videoRanges.end(), videoPinnedRanges.begin(), videoPinnedRanges.end());
+            }
+            auto audioRanges = timeline::loop(
+                getAudioCacheRange(getAudioCacheMax()),
+                ftk::Range<int64_t>(
+                    thread.state.inOutRange.start_time().rescaled_to(1.0).value(),
+                    thread.state.inOutRange.end_time_inclusive().rescaled_to(1.0).value()));
+            const auto audioPinnedRanges = getAudioPinnedRanges();
+            audioRanges.insert(audioRanges.end(), audioPinnedRanges.begin(), audioPinnedRanges.end());
+
+            std::vector<std::vector<uint64_t> > ids(1 + thread.state.compare.size());
+            auto videoRequestIt = thread.videoDataRequests.begin();
+            while (videoRequestIt != thread.videoDataRequests.end())
+            {
+                bool found = false;
+                for (const auto& range : videoRanges)
+                {
+                    if (range.contains(videoRequestIt->first))
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found)
+                {
+                    const auto& requests = videoRequestIt->second.requests;
+                    for (size_t i = 0; i < requests.size() && i < ids.size(); ++i)
+                    {
+                        ids[i].push_back(requests[i].id);
+                    }
+                    videoRequestIt = thread.videoDataRequests.erase(videoRequestIt);
+                }
+                else
+                {
+                    ++videoRequestIt;
+                }
+            }
+            auto audioRequestIt = thread.audioDataRequests.begin();
+            while (audioRequestIt != thread.audioDataRequests.end())
+            {
+                bool found = false;
+                for (const auto& range : audioRanges)
+                {
+                    if (audioRequestIt->first >= range.min() && audioRequestIt->first <= range.max())
+                    {
+                        found = true;
+                        break;
+                    }
+                }
+                if (!found)
+                {
+                    ids[0].push_back(audioRequestIt->second.id);
+                    audioRequestIt = thread.audioDataRequests.erase(audioRequestIt);
+                }
+                else
+                {
+                    ++audioRequestIt;
+                }
+            }
+
+            if (!ids[0].empty())
+            {
+                timeline->cancelRequests(ids[0]);
+            }
+            for (size_t i = 0; i < thread.state.compare.size(); ++i)
+            {
+                if (!ids[i + 1].empty())
+                {
+                    thread.state.compare[i]->cancelRequests(ids[i + 1]);
+                }
+            }
         }
 
         void Player::Private::clearCache()
         {
             thread.videoCache.clear();
+            thread.videoPinned.clear();
+            thread.videoCompressed.clear();
+            thread.videoCompressRequests.clear();
+            thread.videoDecompressRequests.clear();
+            compressCancel();
+            thread.scrubProxyVideoData.clear();
             {
                 std::unique_lock<std::mutex> lock(mutex.mutex);
                 mutex.cacheInfo = PlayerCacheInfo();
@@ -157,18 +304,175 @@ namespace tl
                 std::unique_lock<std::mutex> lock(audioMutex.mutex);
                 audioMutex.cache.clear();
             }
+            thread.audioCacheSize = 0;
+            thread.audioCacheByteCount = 0;
         }
 
-        size_t Player::Private::getVideoCacheMax() const
+        void Player::Private::clearCache(const TimelineEdit& edit)
         {
-            // This function returns the approximate number of video frames
-            // that can fit in the cache. Note that this doesn't take into
-            // account clips with different sizes or multiple tracks.
+            // Remove the video frames and requests in the edited ranges.
+            auto isVideoEdited = [&edit](const OTIO_NS::RationalTime& time)
+                {
+                    for (const auto& range : edit.video)
+                    {
+                        if (range.contains(time))
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+            std::vector<std::vector<uint64_t> > ids(1 + thread.state.compare.size());
+            auto videoRequestIt = thread.videoDataRequests.begin();
+            while (videoRequestIt != thread.videoDataRequests.end())
+            {
+                if (isVideoEdited(videoRequestIt->first))
+                {
+                    const auto& requests = videoRequestIt->second.requests;
+                    for (size_t j = 0; j < requests.size() && j < ids.size(); ++j)
+                    {
+                        ids[j].push_back(requests[j].id);
+                    }
+                    videoRequestIt = thread.videoDataRequests.erase(videoRequestIt);
+                }
+                else
+                {
+                    ++videoRequestIt;
+                }
+            }
+            if (time::isValid(thread.scrubProxyTime) &&
+                isVideoEdited(thread.scrubProxyTime))
+            {
+                scrubCancel();
+                thread.scrubProxyVideoData.clear();
+            }
+            thread.videoCache.remove(edit.video);
+            thread.videoPinned.remove(edit.video);
+            thread.videoCompressed.remove(edit.video);
+            auto videoCompressIt = thread.videoCompressRequests.begin();
+            while (videoCompressIt != thread.videoCompressRequests.end())
+            {
+                videoCompressIt = isVideoEdited(videoCompressIt->first) ?
+                    thread.videoCompressRequests.erase(videoCompressIt) :
+                    std::next(videoCompressIt);
+            }
+            auto videoDecompressIt = thread.videoDecompressRequests.begin();
+            while (videoDecompressIt != thread.videoDecompressRequests.end())
+            {
+                videoDecompressIt = isVideoEdited(videoDecompressIt->first) ?
+                    thread.videoDecompressRequests.erase(videoDecompressIt) :
+                    std::next(videoDecompressIt);
+            }
+
+            // Remove the seconds of audio and requests that overlap the
+            // edited ranges.
+            auto isAudioEdited = [&edit](int64_t seconds)
+                {
+                    const OTIO_NS::TimeRange secondsRange(
+                        OTIO_NS::RationalTime(seconds, 1.0),
+                        OTIO_NS::RationalTime(1.0, 1.0));
+                    for (const auto& range : edit.audio)
+                    {
+                        if (range.intersects(secondsRange))
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+                };
+            auto audioRequestIt = thread.audioDataRequests.begin();
+            while (audioRequestIt != thread.audioDataRequests.end())
+            {
+                if (isAudioEdited(audioRequestIt->first))
+                {
+                    ids[0].push_back(audioRequestIt->second.id);
+                    audioRequestIt = thread.audioDataRequests.erase(audioRequestIt);
+                }
+                else
+                {
+                    ++audioRequestIt;
+                }
+            }
+            {
+                std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                auto audioCacheIt = audioMutex.cache.begin();
+                while (audioCacheIt != audioMutex.cache.end())
+                {
+                    if (isAudioEdited(audioCacheIt->first))
+                    {
+                        --thread.audioCacheSize;
+                        thread.audioCacheByteCount -= getByteCount(audioCacheIt->second);
+                        audioCacheIt = audioMutex.cache.erase(audioCacheIt);
+                    }
+                    else
+                    {
+                        ++audioCacheIt;
+                    }
+                }
+            }
+
+            timeline->cancelRequests(ids[0]);
+            for (size_t i = 0; i < thread.state.compare.size(); ++i)
+            {
+                thread.state.compare[i]->cancelRequests(ids[i + 1]);
+            }
+        }
+
+        void Player::Private::timelineUpdate(
+            const OTIO_NS::TimeRange& timeRange,
+            const io::Info& ioInfo)
+        {
+            // Update the time range and I/O information after an edit, for
+            // example when a clip is trimmed. The cached frames that are
+            // still inside of the time range are kept, the frames that were
+            // changed by the edit are removed by clearCache().
+            thread.ioInfo = ioInfo;
+            if (timeRange != thread.timeRange)
+            {
+                thread.timeRange = timeRange;
+                for (auto cache : { &thread.videoCache, &thread.videoPinned })
+                {
+                    std::vector<std::pair<OTIO_NS::RationalTime, std::vector<VideoData> > > frames;
+                    cache->keep({}, &frames);
+                    cache->setTimeRange(timeRange);
+                    for (const auto& i : frames)
+                    {
+                        cache->add(i.first, i.second);
+                    }
+                }
+                std::vector<std::pair<OTIO_NS::RationalTime, std::shared_ptr<PlayerCompressedVideo> > > compressed;
+                thread.videoCompressed.keep({}, &compressed);
+                thread.videoCompressed.setTimeRange(timeRange);
+                for (const auto& i : compressed)
+                {
+                    thread.videoCompressed.add(i.first, i.second);
+                }
+            }
+        }
+
+        size_t Player::Private::getVideoFrameByteCount() const
+        {
+            // This function returns the approximate size of a video frame.
+            // Once there are frames in the cache the average size of the
+            // cached frames is used, which accounts for clips with
+            // different sizes, multiple tracks, and transitions. Until then
+            // the size is estimated from the first clip.
             size_t byteCount = 0;
-            if (thread.state.videoLayer >= 0 &&
-                thread.state.videoLayer < ioInfo.video.size())
+            const size_t cacheSize = thread.videoCache.getSize();
+            const size_t pinnedSize = thread.videoPinned.getSize();
+            if (cacheSize > 0)
+            {
+                byteCount = thread.videoCache.getByteCount() / cacheSize;
+            }
+            else if (pinnedSize > 0)
+            {
+                byteCount = thread.videoPinned.getByteCount() / pinnedSize;
+            }
+            if (0 == byteCount &&
+                thread.state.videoLayer >= 0 &&
+                thread.state.videoLayer < thread.ioInfo.video.size())
             {
-                byteCount += ioInfo.video[thread.state.videoLayer].getByteCount();
+                byteCount += thread.ioInfo.video[thread.state.videoLayer].getByteCount();
 
                 // Add byte counts from timelines that are being compared.
                 for (size_t i = 0; i < thread.state.compare.size(); ++i)
@@ -176,7 +480,7 @@ namespace tl
                     const int compareLayer = i < thread.state.compareVideoLayers.size() ?
                         thread.state.compareVideoLayers[i] :
                         thread.state.videoLayer;
-                    const io::Info& compareInfo = thread.state.compare[i]->getIOInfo();
+                    const io::Info compareInfo = thread.state.compare[i]->getIOInfo();
                     if (compareLayer >= 0 &&
                         compareLayer < compareInfo.video.size())
                     {
@@ -184,16 +488,174 @@ namespace tl
                     }
                 }
             }
-            return (thread.state.cacheOptions.videoGB * ftk::gigabyte) / byteCount;
+            return byteCount;
+        }
+
+        size_t Player::Private::getVideoCacheMax() const
+        {
+            // This function returns the approximate number of video frames
+            // that can fit in the cache.
+            const size_t byteCount = getVideoFrameByteCount();
+            size_t out = byteCount > 0 ? (getVideoCacheByteMax() / byteCount) : 0;
+            if (thread.state.cacheOptions.videoFrames > 0)
+            {
+                // The cache range includes the current frame.
+                out = std::min(out, thread.state.cacheOptions.videoFrames - 1);
+            }
+            return out;
+        }
+
+        size_t Player::Private::getVideoCacheByteMax() const
+        {
+            return thread.state.cacheOptions.videoGB * ftk::gigabyte;
+        }
+
+        size_t Player::Private::getVideoCompressedMax() const
+        {
+            // This function returns the approximate number of video frames
+            // that can fit in the compressed cache. The compression ratio
+            // of the cached frames is used, until then it is estimated.
+            size_t out = 0;
+            const size_t byteCount = getVideoFrameByteCount();
+            if (byteCount > 0)
+            {
+                const float ratio = thread.videoCompressed.getSize() > 0 ?
+                    std::max(thread.videoCompressed.getRatio(), 1.F) :
+                    videoCompressionRatioDefault;
+                out = static_cast<size_t>(
+                    getVideoCompressedByteMax() / static_cast<float>(byteCount) * ratio);
+            }
+            return out;
+        }
+
+        size_t Player::Private::getVideoCompressedByteMax() const
+        {
+            return thread.state.cacheOptions.videoCompressedGB * ftk::gigabyte;
+        }
+
+        size_t Player::Private::getAudioSecondByteCount() const
+        {
+            // This function returns the approximate size of a second of
+            // audio. Once there is audio in the cache the average size of
+            // the cached seconds is used, which accounts for multiple
+            // tracks. Until then the size is estimated from the audio
+            // information.
+            size_t out = 0;
+            if (thread.audioCacheSize > 0)
+            {
+                out = thread.audioCacheByteCount / thread.audioCacheSize;
+            }
+            if (0 == out)
+            {
+                out = thread.ioInfo.audio.sampleRate * thread.ioInfo.audio.getByteCount();
+            }
+            return out;
         }
 
         size_t Player::Private::getAudioCacheMax() const
         {
-            // This function returns the approximate number seconds of audio
-            // that can fit in the cache. Note that this doesn't take into
-            // account clips with different sizes or multiple tracks.
-            return (thread.state.cacheOptions.audioGB * ftk::gigabyte) /
-                (ioInfo.audio.sampleRate * ioInfo.audio.getByteCount());
+            // This function returns the number of seconds of audio that fit
+            // in the cache.
+            const size_t byteCount = getAudioSecondByteCount();
+            size_t out = byteCount > 0 ?
+                ((thread.state.cacheOptions.audioGB * ftk::gigabyte) / byteCount) :
+                0;
+            const double rate = thread.timeRange.duration().rate();
+            if (thread.state.cacheOptions.videoFrames > 0 && rate > 0.0)
+            {
+                // Only cache the audio for the video frames.
+                out = std::min(
+                    out,
+                    static_cast<size_t>(std::ceil(thread.state.cacheOptions.videoFrames / rate)));
+            }
+            return out;
+        }
+
+        size_t Player::Private::getVideoPinnedByteMax() const
+        {
+            return thread.state.cacheOptions.pinnedVideoGB * ftk::gigabyte;
+        }
+
+        size_t Player::Private::getAudioPinnedMax() const
+        {
+            // This function returns the number of seconds of audio that fit
+            // in the pinned audio cache.
+            size_t out = 0;
+            const size_t byteCount = getAudioSecondByteCount();
+            if (byteCount > 0)
+            {
+                out = (thread.state.cacheOptions.pinnedAudioGB * ftk::gigabyte) / byteCount;
+            }
+            return out;
+        }
+
+        std::vector<OTIO_NS::TimeRange> Player::Private::getVideoPinnedRanges() const
+        {
+            // The pinned ranges are cached in order until the pinned cache
+            // is full, so the ranges are trimmed to the number of frames
+            // that fit.
+            std::vector<OTIO_NS::TimeRange> out;
+            const size_t byteCount = getVideoFrameByteCount();
+            int64_t max = byteCount > 0 ? (getVideoPinnedByteMax() / byteCount) : 0;
+            const double rate = thread.timeRange.duration().rate();
+            for (const auto& range : thread.state.pinnedRanges)
+            {
+                if (max <= 0)
+                    break;
+                const int64_t start = std::max(
+                    range.start_time().rescaled_to(rate).round().value(),
+                    thread.timeRange.start_time().rescaled_to(rate).round().value());
+                const int64_t end = std::min(
+                    range.end_time_inclusive().rescaled_to(rate).round().value(),
+                    thread.timeRange.end_time_inclusive().rescaled_to(rate).round().value());
+                if (end >= start)
+                {
+                    const int64_t count = std::min(end - start + 1, max);
+                    out.push_back(OTIO_NS::TimeRange(
+                        OTIO_NS::RationalTime(start, rate),
+                        OTIO_NS::RationalTime(count, rate)));
+                    max -= count;
+                }
+            }
+            return out;
+        }
+
+        std::vector<ftk::Range<int64_t> > Player::Private::getAudioPinnedRanges() const
+        {
+            // The seconds of audio are trimmed like the video frames, see
+            // getVideoPinnedRanges().
+            std::vector<ftk::Range<int64_t> > out;
+            int64_t max = getAudioPinnedMax();
+            for (const auto& range : thread.state.pinnedRanges)
+            {
+                if (max <= 0)
+                    break;
+                const int64_t start = std::max(
+                    std::floor(range.start_time().rescaled_to(1.0).value()),
+                    std::floor(thread.timeRange.start_time().rescaled_to(1.0).value()));
+                const int64_t end = std::min(
+                    std::floor(range.end_time_inclusive().rescaled_to(1.0).value()),
+                    std::floor(thread.timeRange.end_time_inclusive().rescaled_to(1.0).value()));
+                if (end >= start)
+                {
+                    const int64_t count = std::min(end - start + 1, max);
+                    out.push_back(ftk::Range<int64_t>(
+                        static_cast<int64_t>(start + thread.state.audioOffset),
+                        static_cast<int64_t>(start + count - 1 + thread.state.audioOffset)));
+                    max -= count;
+                }
+            }
+            return out;
+        }
+
+        const std::vector<VideoData>* Player::Private::getVideo(const OTIO_NS::RationalTime& time) const
+        {
+            auto out = thread.videoCache.get(time);
+            if (!out)
+            {
+                out = thread.videoPinned.get(time);
+            }
+            return out;
         }
 
         OTIO_NS::TimeRange Player::Private::getVideoCacheRange(size_t max) const
@@ -225,6 +687,95 @@ namespace tl
             return out;
         }
 
+        int64_t Player::Private::getVideoStride() const
+        {
+            // When playing faster than the frames can be displayed only
+            // every Nth frame is requested.
+            int64_t out = 1;
+            if (thread.state.playback != Playback::Stop)
+            {
+                const double displayRate = playerOptions.displayRate > 0.0 ?
+                    playerOptions.displayRate :
+                    thread.timeRange.duration().rate();
+                if (displayRate > 0.0)
+                {
+                    out = std::max(
+                        static_cast<int64_t>(std::fabs(thread.state.speed) / displayRate),
+                        int64_t(1));
+                }
+            }
+            return out;
+        }
+
+        OTIO_NS::RationalTime Player::Private::getVideoStrideTime(const OTIO_NS::RationalTime& time) const
+        {
+            // Get the frame on the stride that was most recently reached in
+            // the cache direction.
+            OTIO_NS::RationalTime out = time.round();
+            const int64_t stride = thread.videoStride;
+            if (stride > 1)
+            {
+                const double rate = time.rate();
+                const int64_t start = thread.state.inOutRange.start_time().rescaled_to(rate).round().value();
+                const int64_t end = thread.state.inOutRange.end_time_inclusive().rescaled_to(rate).round().value();
+                const int64_t frame = out.value() - start;
+                int64_t aligned = (frame >= 0 ? frame : (frame - stride + 1)) / stride * stride;
+                if (CacheDirection::Reverse == thread.cacheDirection &&
+                    aligned != frame &&
+                    start + aligned + stride <= end)
+                {
+                    aligned += stride;
+                }
+                out = OTIO_NS::RationalTime(start + aligned, rate);
+            }
+            return out;
+        }
+
+        void Player::Private::getVideoCacheTimes(
+            const OTIO_NS::TimeRange& range,
+            std::vector<OTIO_NS::RationalTime>& out) const
+        {
+            // The frames are ordered by priority: first the frames ahead of
+            // the current time up to the buffer target, then the frames
+            // behind the current time, and then the rest of the frames
+            // ahead of the current time. The frames between the strides
+            // are skipped.
+            out.clear();
+            const double rate = thread.state.currentTime.rate();
+            const int64_t stride = thread.videoStride;
+            const int64_t current = getVideoStrideTime(thread.state.currentTime).value();
+            const int64_t first = range.start_time().round().value();
+            const int64_t last = range.end_time_inclusive().round().value();
+            const double bufferAheadRate = thread.state.playback != Playback::Stop ?
+                std::fabs(thread.state.speed) :
+                rate;
+            const int64_t bufferAhead = std::max(
+                static_cast<int64_t>(playerOptions.videoBufferAhead * bufferAheadRate) / stride,
+                int64_t(1));
+            const bool forward = CacheDirection::Forward == thread.cacheDirection;
+            const int64_t aheadFirst = forward ? std::max(current, first) : std::min(current, last);
+            const int64_t aheadLast = forward ? last : first;
+            const int64_t aheadInc = forward ? stride : -stride;
+            const int64_t aheadDiff = (aheadLast - aheadFirst) * (forward ? 1 : -1);
+            const int64_t aheadCount = aheadDiff >= 0 ? (aheadDiff / stride + 1) : 0;
+            const int64_t behindFirst = current - aheadInc;
+            const int64_t behindLast = forward ? first : last;
+            const int64_t behindDiff = (behindFirst - behindLast) * (forward ? 1 : -1);
+            const int64_t behindCount = behindDiff >= 0 ? (behindDiff / stride + 1) : 0;
+            for (int64_t i = 0; i < std::min(aheadCount, bufferAhead); ++i)
+            {
+                out.push_back(OTIO_NS::RationalTime(aheadFirst + i * aheadInc, rate));
+            }
+            for (int64_t i = 0; i < behindCount; ++i)
+            {
+                out.push_back(OTIO_NS::RationalTime(behindFirst - i * aheadInc, rate));
+            }
+            for (int64_t i = bufferAhead; i < aheadCount; ++i)
+            {
+                out.push_back(OTIO_NS::RationalTime(aheadFirst + i * aheadInc, rate));
+            }
+        }
+
         ftk::Range<int64_t> Player::Private::getAudioCacheRange(size_t max) const
         {
             ftk::Range<int64_t> out;
@@ -249,46 +800,250 @@ namespace tl
             return out;
         }
 
-        void Player::Private::cacheUpdate()
+        void Player::Private::videoRequest(
+            const OTIO_NS::RationalTime& time,
+            const std::chrono::steady_clock::time_point& now)
         {
-            //std::cout << "current time: " << currentTime->get() << std::endl;
+            //std::cout << this << " video request: " << time << std::endl;
+            videoRequest(time, thread.state.ioOptions, now, thread.videoDataRequests[time]);
+        }
 
-            const size_t videoCacheMax = getVideoCacheMax();
-            const size_t audioCacheMax = getAudioCacheMax();
-            const OTIO_NS::TimeRange videoCacheRange = getVideoCacheRange(videoCacheMax);
-            const ftk::Range<int64_t> audioCacheRange = getAudioCacheRange(audioCacheMax);
+        void Player::Private::videoRequest(
+            const OTIO_NS::RationalTime& time,
+            const io::Options& ioOptions,
+            const std::chrono::steady_clock::time_point& now,
+            VideoRequests& videoRequests)
+        {
+            videoRequests.time = now;
+            auto& requests = videoRequests.requests;
+            io::Options ioOptions2 = ioOptions;
+            ioOptions2["Layer"] = ftk::Format("{0}").arg(thread.state.videoLayer);
+            requests.clear();
+            requests.push_back(timeline->getVideo(time, ioOptions2));
 
-            // Remove frames from the video cache.
-            bool videoCacheChanged = false;
+            for (size_t k = 0; k < thread.state.compare.size(); ++k)
             {
-                const auto looped = timeline::loop(
-                    videoCacheRange,
-                    thread.state.inOutRange);
-                auto i = thread.videoCache.begin();
-                while (i != thread.videoCache.end())
+                const OTIO_NS::RationalTime t2 = timeline::getCompareTime(
+                    time,
+                    thread.timeRange,
+                    thread.state.compare[k]->getTimeRange(),
+                    thread.state.compareTime);
+                ioOptions2["Layer"] = ftk::Format("{0}").
+                    arg(k < thread.state.compareVideoLayers.size() ?
+                        thread.state.compareVideoLayers[k] :
+                        thread.state.videoLayer);
+                requests.push_back(thread.state.compare[k]->getVideo(t2, ioOptions2));
+            }
+            videoRequests.ready = std::vector<bool>(requests.size(), false);
+        }
+
+        void Player::Private::scrubRequest(
+            const OTIO_NS::RationalTime& time,
+            const std::chrono::steady_clock::time_point& now)
+        {
+            // Request the frame at a proxy resolution. The previous proxy
+            // request is stale once the current time has moved.
+            if (time != thread.scrubProxyTime)
+            {
+                scrubCancel();
+                thread.scrubProxyTime = time;
+                io::Options ioOptions = thread.state.ioOptions;
+                ioOptions["Proxy"] = ftk::Format("{0}").arg(playerOptions.scrubProxy);
+                videoRequest(time, ioOptions, now, thread.scrubProxyRequests);
+            }
+        }
+
+        void Player::Private::scrubCancel()
+        {
+            const auto& requests = thread.scrubProxyRequests.requests;
+            if (!requests.empty())
+            {
+                timeline->cancelRequests({ requests[0].id });
+                for (size_t i = 1; i < requests.size() && i - 1 < thread.state.compare.size(); ++i)
                 {
-                    const OTIO_NS::RationalTime& t = i->first;
-                    bool found = false;
-                    for (const auto& range : looped)
+                    thread.state.compare[i - 1]->cancelRequests({ requests[i].id });
+                }
+            }
+            thread.scrubProxyTime = time::invalidTime;
+            thread.scrubProxyRequests = VideoRequests();
+        }
+
+        void Player::Private::compressInit()
+        {
+            // The video is compressed and decompressed by a fixed number of
+            // worker threads, so filling the compressed cache does not
+            // create a thread for each frame.
+            const size_t threadCount = getVideoCompressJobMax();
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                compressThread.threads.push_back(std::thread(
+                    [this]
                     {
-                        if (range.contains(t))
+                        while (true)
                         {
-                            found = true;
-                            break;
+                            std::function<void()> job;
+                            {
+                                std::unique_lock<std::mutex> lock(compressMutex.mutex);
+                                compressThread.cv.wait(
+                                    lock,
+                                    [this]
+                                    {
+                                        return compressMutex.stopped || !compressMutex.jobs.empty();
+                                    });
+                                if (compressMutex.stopped)
+                                {
+                                    break;
+                                }
+                                job = std::move(compressMutex.jobs.front());
+                                compressMutex.jobs.pop_front();
+                            }
+                            job();
                         }
-                    }
-                    if (!found)
+                    }));
+            }
+        }
+
+        void Player::Private::compressStop()
+        {
+            {
+                std::unique_lock<std::mutex> lock(compressMutex.mutex);
+                compressMutex.stopped = true;
+            }
+            compressThread.cv.notify_all();
+            for (auto& i : compressThread.threads)
+            {
+                if (i.joinable())
+                {
+                    i.join();
+                }
+            }
+            compressThread.threads.clear();
+            compressCancel();
+        }
+
+        void Player::Private::compressCancel()
+        {
+            // Jobs that have not started are discarded, the futures of the
+            // requests have already been released.
+            std::list<std::function<void()> > jobs;
+            {
+                std::unique_lock<std::mutex> lock(compressMutex.mutex);
+                jobs = std::move(compressMutex.jobs);
+                compressMutex.jobs.clear();
+            }
+        }
+
+        std::future<std::shared_ptr<PlayerCompressedVideo> > Player::Private::compressRequest(
+            std::vector<VideoData> videoData)
+        {
+            auto promise = std::make_shared<std::promise<std::shared_ptr<PlayerCompressedVideo> > >();
+            auto out = promise->get_future();
+            {
+                std::unique_lock<std::mutex> lock(compressMutex.mutex);
+                compressMutex.jobs.push_back(
+                    [promise, videoData = std::move(videoData)]
                     {
-                        i = thread.videoCache.erase(i);
-                        videoCacheChanged = true;
-                    }
-                    else
+                        try
+                        {
+                            promise->set_value(compressVideo(videoData));
+                        }
+                        catch (...)
+                        {
+                            promise->set_exception(std::current_exception());
+                        }
+                    });
+            }
+            compressThread.cv.notify_one();
+            return out;
+        }
+
+        std::future<std::vector<VideoData> > Player::Private::decompressRequest(
+            const std::shared_ptr<PlayerCompressedVideo>& compressed)
+        {
+            auto promise = std::make_shared<std::promise<std::vector<VideoData> > >();
+            auto out = promise->get_future();
+            {
+                std::unique_lock<std::mutex> lock(compressMutex.mutex);
+                compressMutex.jobs.push_back(
+                    [promise, compressed]
                     {
-                        ++i;
-                    }
+                        try
+                        {
+                            promise->set_value(decompressVideo(*compressed));
+                        }
+                        catch (...)
+                        {
+                            promise->set_exception(std::current_exception());
+                        }
+                    });
+            }
+            compressThread.cv.notify_one();
+            return out;
+        }
+
+        void Player::Private::cacheUpdate()
+        {
+            //std::cout << "current time: " << currentTime->get() << std::endl;
+
+            const auto now = std::chrono::steady_clock::now();
+            const bool scrubbing = isScrubbing(now);
+            thread.videoStride = getVideoStride();
+            const size_t videoCacheMax = getVideoCacheMax();
+            const size_t videoCompressedMax = getVideoCompressedMax();
+            const size_t audioCacheMax = getAudioCacheMax();
+            const OTIO_NS::TimeRange videoCacheRange = getVideoCacheRange(videoCacheMax * thread.videoStride);
+            const OTIO_NS::TimeRange videoCompressedRange = getVideoCacheRange(
+                (videoCacheMax + videoCompressedMax) * thread.videoStride);
+            const ftk::Range<int64_t> audioCacheRange = getAudioCacheRange(audioCacheMax);
+            const auto videoCacheRanges = timeline::loop(videoCacheRange, thread.state.inOutRange);
+            const auto videoCompressedRanges = timeline::loop(videoCompressedRange, thread.state.inOutRange);
+            const auto videoPinnedRanges = getVideoPinnedRanges();
+            const auto audioPinnedRanges = getAudioPinnedRanges();
+            const size_t videoPinnedByteMax = getVideoPinnedByteMax();
+
+            // Remove frames from the pinned video cache.
+            bool videoCacheChanged = thread.videoPinned.keep(videoPinnedRanges);
+
+            // Remove frames from the video cache. While scrubbing the
+            // frames are kept to be shown in place of the current frame.
+            // The removed frames that are inside of the pinned ranges are
+            // moved to the pinned cache. The removed frames that are still
+            // inside of the compressed cache range are compressed, for
+            // example the start of the in/out range when playback is
+            // looping.
+            std::vector<std::pair<OTIO_NS::RationalTime, std::vector<VideoData> > > videoRemoved;
+            videoCacheChanged |= !scrubbing && thread.videoCache.keep(
+                videoCacheRanges,
+                (videoCompressedMax > 0 || !videoPinnedRanges.empty()) ? &videoRemoved : nullptr);
+            const size_t videoCompressJobMax = getVideoCompressJobMax();
+            for (auto& i : videoRemoved)
+            {
+                if (contains(videoPinnedRanges, i.first) &&
+                    !thread.videoPinned.contains(i.first) &&
+                    thread.videoPinned.getByteCount() < videoPinnedByteMax)
+                {
+                    thread.videoPinned.add(i.first, i.second);
+                }
+                else if (videoCompressedMax > 0 &&
+                    thread.videoCompressRequests.size() < videoCompressJobMax &&
+                    contains(videoCompressedRanges, i.first) &&
+                    !thread.videoCompressed.contains(i.first) &&
+                    thread.videoCompressRequests.find(i.first) == thread.videoCompressRequests.end())
+                {
+                    thread.videoCompressRequests[i.first] = compressRequest(std::move(i.second));
                 }
             }
 
+            // Remove frames from the compressed video cache.
+            if (0 == videoCompressedMax)
+            {
+                thread.videoCompressed.clear();
+            }
+            else if (!scrubbing)
+            {
+                thread.videoCompressed.keep(videoCompressedRanges);
+            }
+
             // Remove frames from the audio cache.
             bool audioCacheChanged = false;
             {
@@ -311,8 +1066,18 @@ namespace tl
                             break;
                         }
                     }
+                    for (const auto& range : audioPinnedRanges)
+                    {
+                        if (seconds >= range.min() && seconds <= range.max())
+                        {
+                            found = true;
+                            break;
+                        }
+                    }
                     if (!found)
                     {
+                        --thread.audioCacheSize;
+                        thread.audioCacheByteCount -= getByteCount(i->second);
                         i = audioMutex.cache.erase(i);
                         audioCacheChanged = true;
                     }
@@ -323,42 +1088,115 @@ namespace tl
                 }
             }
 
-            // Fill the video cache.
-            if (!ioInfo.video.empty())
+            // Fill the video cache. No more frames are requested once the
+            // images in the cache reach the budget. Frames in the
+            // compressed cache are decompressed instead of being read.
+            const size_t videoCacheByteMax = getVideoCacheByteMax();
+            const size_t videoCompressedByteMax = getVideoCompressedByteMax();
+            if (!thread.ioInfo.video.empty() && scrubbing)
             {
-                const OTIO_NS::RationalTime inc(1.0, thread.state.currentTime.rate());
-                for (OTIO_NS::RationalTime time = videoCacheRange.start_time();
-                    time <= videoCacheRange.end_time_inclusive() &&
-                    thread.videoDataRequests.size() < playerOptions.videoRequestMax;
-                    time += inc)
+                // While scrubbing the current frame is requested at a proxy
+                // resolution if the media supports it, otherwise the nearest
+                // cached frame is shown. The full resolution frames are
+                // requested once the current time has been stable for the
+                // scrub timeout.
+                const OTIO_NS::RationalTime& time = thread.state.currentTime;
+                if (playerOptions.scrubProxy > 1 &&
+                    thread.ioInfo.videoProxy &&
+                    !thread.videoCache.contains(time) &&
+                    !thread.videoPinned.contains(time))
+                {
+                    scrubRequest(time, now);
+                }
+            }
+            else if (!thread.ioInfo.video.empty())
+            {
+                bool videoRequestsFull = false;
+                getVideoCacheTimes(videoCacheRange, thread.videoCacheTimes);
+                for (size_t i = 0;
+                    i < thread.videoCacheTimes.size() &&
+                    thread.videoCache.getByteCount() < videoCacheByteMax;
+                    ++i)
                 {
-                    const OTIO_NS::RationalTime timeLooped = timeline::loop(time, thread.state.inOutRange);
-                    const auto j = thread.videoCache.find(timeLooped);
-                    if (j == thread.videoCache.end())
+                    const OTIO_NS::RationalTime timeLooped = timeline::loop(
+                        thread.videoCacheTimes[i],
+                        thread.state.inOutRange);
+                    if (!thread.videoCache.contains(timeLooped) &&
+                        !thread.videoPinned.contains(timeLooped) &&
+                        thread.videoDataRequests.find(timeLooped) == thread.videoDataRequests.end() &&
+                        thread.videoDecompressRequests.find(timeLooped) == thread.videoDecompressRequests.end())
                     {
-                        const auto k = thread.videoDataRequests.find(timeLooped);
-                        if (k == thread.videoDataRequests.end())
+                        if (auto compressed = thread.videoCompressed.get(timeLooped))
                         {
-                            //std::cout << this << " video request: " << timeLooped << std::endl;
-                            auto& requests = thread.videoDataRequests[timeLooped];
-                            io::Options ioOptions2 = thread.state.ioOptions;
-                            ioOptions2["Layer"] = ftk::Format("{0}").arg(thread.state.videoLayer);
-                            requests.clear();
-                            requests.push_back(timeline->getVideo(timeLooped, ioOptions2));
-
-                            for (size_t k = 0; k < thread.state.compare.size(); ++k)
+                            if (thread.videoDecompressRequests.size() < videoCompressJobMax)
                             {
-                                const OTIO_NS::RationalTime t2 = timeline::getCompareTime(
-                                    timeLooped,
-                                    timeRange,
-                                    thread.state.compare[k]->getTimeRange(),
-                                    thread.state.compareTime);
-                                ioOptions2["Layer"] = ftk::Format("{0}").
-                                    arg(k < thread.state.compareVideoLayers.size() ?
-                                        thread.state.compareVideoLayers[k] :
-                                        thread.state.videoLayer);
-                                requests.push_back(thread.state.compare[k]->getVideo(t2, ioOptions2));
+                                thread.videoDecompressRequests[timeLooped] = decompressRequest(compressed);
                             }
+                            continue;
+                        }
+
+                        // The number of requests only limits the
+                        // throughput when there are more frames to
+                        // request.
+                        if (thread.videoDataRequests.size() >= thread.videoRequestMax)
+                        {
+                            thread.videoRequestSaturated = true;
+                            videoRequestsFull = true;
+                            break;
+                        }
+                        videoRequest(timeLooped, now);
+                    }
+                }
+
+                // Fill the pinned video cache with the requests that are
+                // left over.
+                for (size_t i = 0;
+                    i < videoPinnedRanges.size() &&
+                    !videoRequestsFull &&
+                    thread.videoPinned.getByteCount() < videoPinnedByteMax;
+                    ++i)
+                {
+                    const OTIO_NS::TimeRange& range = videoPinnedRanges[i];
+                    const int64_t start = range.start_time().value();
+                    const int64_t end = range.end_time_exclusive().value();
+                    for (int64_t frame = start; frame < end; ++frame)
+                    {
+                        const OTIO_NS::RationalTime time(frame, range.start_time().rate());
+                        if (!thread.videoCache.contains(time) &&
+                            !thread.videoPinned.contains(time) &&
+                            thread.videoDataRequests.find(time) == thread.videoDataRequests.end())
+                        {
+                            if (thread.videoDataRequests.size() >= thread.videoRequestMax)
+                            {
+                                videoRequestsFull = true;
+                                break;
+                            }
+                            videoRequest(time, now);
+                        }
+                    }
+                }
+
+                // Read ahead into the compressed video cache with the
+                // requests that are left over.
+                if (!videoRequestsFull && videoCompressedMax > 0)
+                {
+                    getVideoCacheTimes(videoCompressedRange, thread.videoCompressedTimes);
+                    for (size_t i = 0;
+                        i < thread.videoCompressedTimes.size() &&
+                        thread.videoDataRequests.size() < thread.videoRequestMax &&
+                        thread.videoCompressRequests.size() < videoCompressJobMax &&
+                        thread.videoCompressed.getByteCount() < videoCompressedByteMax;
+                        ++i)
+                    {
+                        const OTIO_NS::RationalTime timeLooped = timeline::loop(
+                            thread.videoCompressedTimes[i],
+                            thread.state.inOutRange);
+                        if (!contains(videoCacheRanges, timeLooped) &&
+                            !thread.videoCompressed.contains(timeLooped) &&
+                            thread.videoDataRequests.find(timeLooped) == thread.videoDataRequests.end() &&
+                            thread.videoCompressRequests.find(timeLooped) == thread.videoCompressRequests.end())
+                        {
+                            videoRequest(timeLooped, now);
                         }
                     }
                 }
@@ -366,7 +1204,7 @@ namespace tl
             }
 
             // Fill the audio cache.
-            if (ioInfo.audio.isValid())
+            if (thread.ioInfo.audio.isValid())
             {
                 for (int64_t seconds = audioCacheRange.min();
                     seconds <= audioCacheRange.max() &&
@@ -390,6 +1228,26 @@ namespace tl
                         }
                     }
                 }
+
+                // Fill the pinned audio cache.
+                for (const auto& range : audioPinnedRanges)
+                {
+                    for (int64_t seconds = range.min();
+                        seconds <= range.max() &&
+                        thread.audioDataRequests.size() < playerOptions.audioRequestMax;
+                        ++seconds)
+                    {
+                        bool found = false;
+                        {
+                            std::unique_lock<std::mutex> lock(audioMutex.mutex);
+                            found = audioMutex.cache.find(seconds) != audioMutex.cache.end();
+                        }
+                        if (!found && thread.audioDataRequests.find(seconds) == thread.audioDataRequests.end())
+                        {
+                            thread.audioDataRequests[seconds] = timeline->getAudio(seconds, thread.state.ioOptions);
+                        }
+                    }
+                }
                 //std::cout << this << " audio requests: " << thread.audioDataRequests.size() << std::endl;
             }
 
@@ -397,28 +1255,60 @@ namespace tl
             auto videoDataRequestsIt = thread.videoDataRequests.begin();
             while (videoDataRequestsIt != thread.videoDataRequests.end())
             {
+                auto& requests = videoDataRequestsIt->second.requests;
+                auto& requestsReady = videoDataRequestsIt->second.ready;
                 bool ready = true;
-                for (auto videoDataRequestIt = videoDataRequestsIt->second.begin();
-                    videoDataRequestIt != videoDataRequestsIt->second.end();
-                    ++videoDataRequestIt)
+                for (size_t i = 0; i < requests.size(); ++i)
                 {
-                    ready &= videoDataRequestIt->future.valid() &&
-                        videoDataRequestIt->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                    if (i < requestsReady.size() && requestsReady[i])
+                    {
+                        continue;
+                    }
+                    const bool requestReady = requests[i].future.valid() &&
+                        requests[i].future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                    if (requestReady && i < requestsReady.size())
+                    {
+                        requestsReady[i] = true;
+                        const std::chrono::duration<float> latency = now - videoDataRequestsIt->second.time;
+                        statsLatency(i, latency.count());
+                    }
+                    ready &= requestReady;
                 }
                 if (ready)
                 {
                     const OTIO_NS::RationalTime time = videoDataRequestsIt->first;
                     std::vector<VideoData> videoDataList;
-                    for (auto videoDataRequestIt = videoDataRequestsIt->second.begin();
-                        videoDataRequestIt != videoDataRequestsIt->second.end();
+                    for (auto videoDataRequestIt = requests.begin();
+                        videoDataRequestIt != requests.end();
                         ++videoDataRequestIt)
                     {
                         auto videoData = videoDataRequestIt->future.get();
                         videoData.time = time;
                         videoDataList.emplace_back(videoData);
                     }
-                    thread.videoCache[time] = videoDataList;
-                    videoCacheChanged = true;
+                    if (!scrubbing &&
+                        contains(videoPinnedRanges, time) &&
+                        thread.videoPinned.getByteCount() < videoPinnedByteMax)
+                    {
+                        thread.videoPinned.add(time, videoDataList);
+                        videoCacheChanged = true;
+                    }
+                    else if (scrubbing ||
+                        0 == videoCompressedMax ||
+                        contains(videoCacheRanges, time))
+                    {
+                        thread.videoCache.add(time, videoDataList);
+                        videoCacheChanged = true;
+                    }
+                    else if (thread.videoCompressRequests.find(time) == thread.videoCompressRequests.end())
+                    {
+                        // Frames that were read ahead of the video cache
+                        // go straight to the compressed cache.
+                        thread.videoCompressRequests[time] = compressRequest(std::move(videoDataList));
+                    }
+                    const std::chrono::duration<float> latency = now - videoDataRequestsIt->second.time;
+                    ++thread.videoFrames;
+                    thread.videoLatencySum += latency.count();
                     videoDataRequestsIt = thread.videoDataRequests.erase(videoDataRequestsIt);
                 }
                 else
@@ -427,6 +1317,74 @@ namespace tl
                 }
             }
 
+            // Check for the finished proxy request. The proxy frame is not
+            // added to the cache, it is only shown until the full
+            // resolution frame is read.
+            auto& scrubProxyRequests = thread.scrubProxyRequests.requests;
+            if (!scrubProxyRequests.empty())
+            {
+                bool ready = true;
+                for (auto& request : scrubProxyRequests)
+                {
+                    ready &= request.future.valid() &&
+                        request.future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+                }
+                if (ready)
+                {
+                    thread.scrubProxyVideoData.clear();
+                    for (auto& request : scrubProxyRequests)
+                    {
+                        auto videoData = request.future.get();
+                        videoData.time = thread.scrubProxyTime;
+                        thread.scrubProxyVideoData.emplace_back(videoData);
+                    }
+                    thread.scrubProxyRequests = VideoRequests();
+                }
+            }
+
+            // Check for finished video compression.
+            auto videoCompressIt = thread.videoCompressRequests.begin();
+            while (videoCompressIt != thread.videoCompressRequests.end())
+            {
+                if (videoCompressIt->second.valid() &&
+                    videoCompressIt->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    thread.videoCompressed.add(videoCompressIt->first, videoCompressIt->second.get());
+                    videoCompressIt = thread.videoCompressRequests.erase(videoCompressIt);
+                }
+                else
+                {
+                    ++videoCompressIt;
+                }
+            }
+
+            // Check for finished video decompression.
+            auto videoDecompressIt = thread.videoDecompressRequests.begin();
+            while (videoDecompressIt != thread.videoDecompressRequests.end())
+            {
+                if (videoDecompressIt->second.valid() &&
+                    videoDecompressIt->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    try
+                    {
+                        thread.videoCache.add(videoDecompressIt->first, videoDecompressIt->second.get());
+                        videoCacheChanged = true;
+                    }
+                    catch (const std::exception&)
+                    {
+                        // The frame is read again.
+                        thread.videoCompressed.remove({ OTIO_NS::TimeRange(
+                            videoDecompressIt->first,
+                            OTIO_NS::RationalTime(1.0, videoDecompressIt->first.rate())) });
+                    }
+                    videoDecompressIt = thread.videoDecompressRequests.erase(videoDecompressIt);
+                }
+                else
+                {
+                    ++videoDecompressIt;
+                }
+            }
+
             // Check for finished audio.
             auto audioDataRequestsIt = thread.audioDataRequests.begin();
             while (audioDataRequestsIt != thread.audioDataRequests.end())
@@ -439,8 +1397,16 @@ namespace tl
                     audioData.seconds = s;
                     {
                         std::unique_lock<std::mutex> lock(audioMutex.mutex);
-                        audioMutex.cache[audioDataRequestsIt->first] = audioData;
+                        const auto i = audioMutex.cache.find(s);
+                        if (i != audioMutex.cache.end())
+                        {
+                            --thread.audioCacheSize;
+                            thread.audioCacheByteCount -= getByteCount(i->second);
+                        }
+                        audioMutex.cache[s] = audioData;
                     }
+                    ++thread.audioCacheSize;
+                    thread.audioCacheByteCount += getByteCount(audioData);
                     audioDataRequestsIt = thread.audioDataRequests.erase(audioDataRequestsIt);
                     audioCacheChanged = true;
                 }
@@ -450,21 +1416,37 @@ namespace tl
                 }
             }
 
+            // Adjust the number of video requests.
+            videoRequestUpdate(now);
+
             // Update cache information.
-            const auto now = std::chrono::steady_clock::now();
             const std::chrono::duration<float> diff = now - thread.cacheTimer;
             if (diff.count() > .5F)
             {
                 thread.cacheTimer = now;
 
-                std::vector<OTIO_NS::RationalTime> videoCacheFrames;
-                for (const auto& i : thread.videoCache)
+                // Images that are shared between frames, for example with
+                // held frames or repeated clips, are only counted once.
+                const size_t videoCacheByteCount = thread.videoCache.getByteCount();
+                const float videoCachePercentage = videoCacheByteMax > 0 ?
+                    (videoCacheByteCount / static_cast<float>(videoCacheByteMax) * 100.F) :
+                    0.F;
+
+                // Count the frames cached ahead of the current time.
+                const double rate = thread.state.currentTime.rate();
+                const OTIO_NS::RationalTime inc(
+                    CacheDirection::Forward == thread.cacheDirection ?
+                        thread.videoStride :
+                        -thread.videoStride,
+                    rate);
+                size_t videoBufferAheadFrames = 0;
+                for (OTIO_NS::RationalTime time = getVideoStrideTime(thread.state.currentTime);
+                    videoBufferAheadFrames < videoCacheMax * thread.videoStride &&
+                    getVideo(timeline::loop(time, thread.state.inOutRange));
+                    time += inc)
                 {
-                    videoCacheFrames.push_back(i.first);
+                    videoBufferAheadFrames += thread.videoStride;
                 }
-                const float videoCachePercentage = videoCacheMax > 0 ?
-                    (videoCacheFrames.size() / static_cast<float>(videoCacheMax) * 100.F) :
-                    0.F;
 
                 std::vector<int64_t> audioCacheKeys;
                 {
@@ -474,33 +1456,256 @@ namespace tl
                         audioCacheKeys.push_back(i.first);
                     }
                 }
+                // The seconds of audio in the pinned ranges are shown
+                // separately.
                 std::vector<OTIO_NS::RationalTime> audioCacheFrames;
+                std::vector<OTIO_NS::RationalTime> audioPinnedFrames;
                 for (const auto& key : audioCacheKeys)
                 {
-                    audioCacheFrames.push_back(OTIO_NS::RationalTime(key, 1.0));
+                    const bool pinned = std::any_of(
+                        audioPinnedRanges.begin(),
+                        audioPinnedRanges.end(),
+                        [key](const ftk::Range<int64_t>& range)
+                        {
+                            return key >= range.min() && key <= range.max();
+                        });
+                    (pinned ? audioPinnedFrames : audioCacheFrames).push_back(OTIO_NS::RationalTime(key, 1.0));
                 }
                 const float audioCachePercentage = audioCacheMax > 0 ?
-                    (audioCacheKeys.size() / static_cast<float>(audioCacheMax) * 100.F) :
+                    (audioCacheFrames.size() / static_cast<float>(audioCacheMax) * 100.F) :
+                    0.F;
+                const size_t audioPinnedMax = getAudioPinnedMax();
+                const float audioPinnedPercentage = audioPinnedMax > 0 ?
+                    (audioPinnedFrames.size() / static_cast<float>(audioPinnedMax) * 100.F) :
+                    0.F;
+                const float videoPinnedPercentage = videoPinnedByteMax > 0 ?
+                    (thread.videoPinned.getByteCount() / static_cast<float>(videoPinnedByteMax) * 100.F) :
                     0.F;
 
-                auto videoCacheRanges = toRanges(videoCacheFrames);
+                const auto videoCacheRanges = thread.videoCache.getRanges();
+                const auto videoPinnedCacheRanges = thread.videoPinned.getRanges();
                 auto audioCacheRanges = toRanges(audioCacheFrames);
-                for (auto& i : audioCacheRanges)
+                auto audioPinnedCacheRanges = toRanges(audioPinnedFrames);
+                for (auto ranges : { &audioCacheRanges, &audioPinnedCacheRanges })
                 {
-                    i = OTIO_NS::TimeRange(
-                        i.start_time().rescaled_to(timeRange.duration().rate()).floor(),
-                        i.duration().rescaled_to(timeRange.duration().rate()).ceil());
+                    for (auto& i : *ranges)
+                    {
+                        i = OTIO_NS::TimeRange(
+                            i.start_time().rescaled_to(thread.timeRange.duration().rate()).floor(),
+                            i.duration().rescaled_to(thread.timeRange.duration().rate()).ceil());
+                    }
                 }
                 {
                     std::unique_lock<std::mutex> lock(mutex.mutex);
                     mutex.cacheInfo.videoPercentage = videoCachePercentage;
+                    mutex.cacheInfo.videoCompressedPercentage = videoCompressedByteMax > 0 ?
+                        (thread.videoCompressed.getByteCount() / static_cast<float>(videoCompressedByteMax) * 100.F) :
+                        0.F;
+                    mutex.cacheInfo.videoCompressionRatio = thread.videoCompressed.getRatio();
                     mutex.cacheInfo.audioPercentage = audioCachePercentage;
                     mutex.cacheInfo.video = videoCacheRanges;
                     mutex.cacheInfo.audio = audioCacheRanges;
+                    mutex.cacheInfo.pinnedVideoPercentage = videoPinnedPercentage;
+                    mutex.cacheInfo.pinnedAudioPercentage = audioPinnedPercentage;
+                    mutex.cacheInfo.pinnedVideo = videoPinnedCacheRanges;
+                    mutex.cacheInfo.pinnedAudio = audioPinnedCacheRanges;
+                    mutex.cacheInfo.videoRequestMax = thread.videoRequestMax;
+                    mutex.cacheInfo.videoThroughput = thread.videoThroughput;
+                    mutex.cacheInfo.videoLatency = thread.videoLatency;
+                    mutex.cacheInfo.videoBufferAhead = rate > 0.0 ?
+                        (videoBufferAheadFrames / rate) :
+                        0.F;
+                }
+
+                statsUpdate();
+            }
+        }
+
+        bool Player::Private::isScrubbing(const std::chrono::steady_clock::time_point& now) const
+        {
+            // Scrubbing is in progress until the current time has been
+            // stable for the timeout.
+            return thread.state.scrub && (now - thread.scrubTimer) < playerOptions.scrubTimeout;
+        }
+
+        void Player::Private::videoRequestUpdate(const std::chrono::steady_clock::time_point& now)
+        {
+            const std::chrono::duration<float> diff = now - thread.videoRequestTimer;
+            if (diff.count() < videoRequestAdaptiveTimeout)
+            {
+                return;
+            }
+            thread.videoRequestTimer = now;
+
+            thread.videoThroughput = thread.videoFrames / diff.count();
+            if (thread.videoFrames > 0)
+            {
+                thread.videoLatency = thread.videoLatencySum / thread.videoFrames;
+            }
+
+            // Climb towards the number of requests with the highest
+            // throughput. The throughput is only compared while the
+            // requests are the limit, otherwise the player is waiting for
+            // the cache to drain and not for the I/O. When more requests
+            // do not increase the throughput, for example with a reader
+            // that decodes sequentially, the number is reduced.
+            if (playerOptions.videoRequestAdaptive &&
+                thread.videoRequestSaturated &&
+                thread.videoFrames > 0)
+            {
+                if (thread.videoThroughput < thread.videoThroughputBase * .95F)
+                {
+                    thread.videoRequestStep = -thread.videoRequestStep;
+                }
+                else if (thread.videoThroughput < thread.videoThroughputBase * 1.05F)
+                {
+                    thread.videoRequestStep = -1;
+                }
+                thread.videoThroughputBase = thread.videoThroughput;
+
+                const size_t videoRequestLimit = std::max(playerOptions.videoRequestLimit, size_t(1));
+                const size_t videoRequestMax = ftk::clamp(
+                    thread.videoRequestStep > 0 ?
+                        (thread.videoRequestMax + std::max(thread.videoRequestMax / 2, size_t(1))) :
+                        (thread.videoRequestMax - thread.videoRequestMax / 3),
+                    std::min(videoRequestAdaptiveMin, videoRequestLimit),
+                    videoRequestLimit);
+                if (videoRequestMax != thread.videoRequestMax)
+                {
+                    thread.videoRequestMax = videoRequestMax;
+                    timeline->setVideoRequestMax(videoRequestMax);
+                    for (const auto& compare : thread.state.compare)
+                    {
+                        compare->setVideoRequestMax(videoRequestMax);
+                    }
+                }
+            }
+
+            thread.videoRequestSaturated = false;
+            thread.videoFrames = 0;
+            thread.videoLatencySum = 0.F;
+        }
+
+        void Player::Private::statsReset(bool counters)
+        {
+            if (counters)
+            {
+                thread.stats = PlayerStats();
+            }
+            thread.stats.latency.clear();
+            thread.latencySamples.clear();
+            for (size_t i = 0; i < 1 + thread.state.compare.size(); ++i)
+            {
+                PlayerLatencyStats latency;
+                latency.path = 0 == i ?
+                    timeline->getPath().get() :
+                    thread.state.compare[i - 1]->getPath().get();
+                latency.histogram = std::vector<size_t>(statsLatencyBuckets, 0);
+                thread.stats.latency.push_back(latency);
+                thread.latencySamples.push_back(std::vector<float>());
+            }
+            thread.presentedTime = time::invalidTime;
+            thread.missTime = time::invalidTime;
+        }
+
+        void Player::Private::statsPresent(const OTIO_NS::RationalTime& time)
+        {
+            if (time == thread.presentedTime)
+            {
+                return;
+            }
+            ++thread.stats.framesPresented;
+            if (time == thread.missTime)
+            {
+                ++thread.stats.framesLate;
+            }
+
+            // Count the frames between the presented frames that were not
+            // skipped on purpose by the stride. Frames are not counted
+            // when playback loops.
+            if (thread.state.playback != Playback::Stop && time::isValid(thread.presentedTime))
+            {
+                const int64_t diff = (time - thread.presentedTime).rescaled_to(time.rate()).round().value() *
+                    (Playback::Forward == thread.state.playback ? 1 : -1);
+                if (diff > thread.videoStride)
+                {
+                    thread.stats.framesSkipped += diff / thread.videoStride - 1;
+                }
+            }
+            thread.presentedTime = time;
+        }
+
+        void Player::Private::statsMiss(const OTIO_NS::RationalTime& time)
+        {
+            if (time != thread.missTime)
+            {
+                ++thread.stats.cacheMisses;
+                thread.missTime = time;
+            }
+        }
+
+        void Player::Private::statsLatency(size_t index, float seconds)
+        {
+            if (index < thread.stats.latency.size())
+            {
+                const float ms = seconds * 1000.F;
+                auto& latency = thread.stats.latency[index];
+                size_t bucket = 0;
+                while (bucket < statsLatencyBuckets - 1 && ms >= static_cast<float>(1 << bucket))
+                {
+                    ++bucket;
                 }
+                ++latency.histogram[bucket];
+
+                // Keep a ring of the most recent samples for the
+                // percentiles.
+                auto& samples = thread.latencySamples[index];
+                if (samples.size() < statsLatencySamples)
+                {
+                    samples.push_back(ms);
+                }
+                else
+                {
+                    samples[latency.count % statsLatencySamples] = ms;
+                }
+                ++latency.count;
             }
         }
 
+        void Player::Private::statsUpdate()
+        {
+            // Sample the request queue depths.
+            auto& videoDepth = thread.stats.videoRequestDepth;
+            videoDepth.push_back(thread.videoDataRequests.size());
+            if (videoDepth.size() > statsDepthSamples)
+            {
+                videoDepth.erase(videoDepth.begin());
+            }
+            auto& audioDepth = thread.stats.audioRequestDepth;
+            audioDepth.push_back(thread.audioDataRequests.size());
+            if (audioDepth.size() > statsDepthSamples)
+            {
+                audioDepth.erase(audioDepth.begin());
+            }
+
+            // Compute the latency percentiles.
+            for (size_t i = 0; i < thread.stats.latency.size(); ++i)
+            {
+                std::vector<float> samples = thread.latencySamples[i];
+                auto& latency = thread.stats.latency[i];
+                if (!samples.empty())
+                {
+                    std::sort(samples.begin(), samples.end());
+                    latency.p50 = samples[(samples.size() - 1) * 50 / 100];
+                    latency.p95 = samples[(samples.size() - 1) * 95 / 100];
+                    latency.p99 = samples[(samples.size() - 1) * 99 / 100];
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(mutex.mutex);
+            mutex.stats = thread.stats;
+        }
+
         void Player::Private::playbackReset(const OTIO_NS::RationalTime& time)
         {
             noAudio.playbackTimer = std::chrono::steady_clock::now();
@@ -524,7 +1729,7 @@ namespace tl
                 cacheInfo = mutex.cacheInfo;
             }
             const size_t videoCacheMax = getVideoCacheMax();
-            const size_t videoCacheSize = thread.videoCache.size();
+            const size_t videoCacheSize = thread.videoCache.getSize();
             size_t audioCacheMax = getAudioCacheMax();
             size_t audioCacheSize = 0;
             {
@@ -535,7 +1740,7 @@ namespace tl
             // Create an array of characters to draw the timeline.
             const size_t lineLength = 80;
             std::string currentTimeDisplay(lineLength, '.');
-            double n = (currentTime - timeRange.start_time()).value() / timeRange.duration().value();
+            double n = (currentTime - thread.timeRange.start_time()).value() / thread.timeRange.duration().value();
             size_t index = ftk::clamp(n, 0.0, 1.0) * (lineLength - 1);
             if (index < currentTimeDisplay.size())
             {
@@ -546,9 +1751,9 @@ namespace tl
             std::string cachedVideoFramesDisplay(lineLength, '.');
             for (const auto& i : cacheInfo.video)
             {
-                n = (i.start_time() - timeRange.start_time()).value() / timeRange.duration().value();
+                n = (i.start_time() - thread.timeRange.start_time()).value() / thread.timeRange.duration().value();
                 const size_t t0 = ftk::clamp(n, 0.0, 1.0) * (lineLength - 1);
-                n = (i.end_time_inclusive() - timeRange.start_time()).value() / timeRange.duration().value();
+                n = (i.end_time_inclusive() - thread.timeRange.start_time()).value() / thread.timeRange.duration().value();
                 const size_t t1 = ftk::clamp(n, 0.0, 1.0) * (lineLength - 1);
                 for (size_t j = t0; j <= t1; ++j)
                 {
@@ -559,13 +1764,28 @@ namespace tl
                 }
             }
 
+            for (const auto& i : cacheInfo.pinnedVideo)
+            {
+                n = (i.start_time() - thread.timeRange.start_time()).value() / thread.timeRange.duration().value();
+                const size_t t0 = ftk::clamp(n, 0.0, 1.0) * (lineLength - 1);
+                n = (i.end_time_inclusive() - thread.timeRange.start_time()).value() / thread.timeRange.duration().value();
+                const size_t t1 = ftk::clamp(n, 0.0, 1.0) * (lineLength - 1);
+                for (size_t j = t0; j <= t1; ++j)
+                {
+                    if (j < cachedVideoFramesDisplay.size())
+                    {
+                        cachedVideoFramesDisplay[j] = 'P';
+                    }
+                }
+            }
+
             // Create an array of characters to draw the cached audio frames.
             std::string cachedAudioFramesDisplay(lineLength, '.');
             for (const auto& i : cacheInfo.audio)
             {
-                double n = (i.start_time() - timeRange.start_time()).value() / timeRange.duration().value();
+                double n = (i.start_time() - thread.timeRange.start_time()).value() / thread.timeRange.duration().value();
                 const size_t t0 = ftk::clamp(n, 0.0, 1.0) * (lineLength - 1);
-                n = (i.end_time_inclusive() - timeRange.start_time()).value() / timeRange.duration().value();
+                n = (i.end_time_inclusive() - thread.timeRange.start_time()).value() / thread.timeRange.duration().value();
                 const size_t t1 = ftk::clamp(n, 0.0, 1.0) * (lineLength - 1);
                 for (size_t j = t0; j <= t1; ++j)
                 {
@@ -592,12 +1812,12 @@ namespace tl
                 "    Video cache: {4}% {5}GB\n"
                 "    Audio cache: {6}% {7}GB\n"
                 "    Read behind: {8}GB\n"
-                "    Video requests: {9}\n"
+                "    Video requests: {9}, {14} max, {15} frames/s, {16}s latency\n"
                 "    Audio requests: {10}\n"
                 "    {11}\n"
                 "    {12}\n"
                 "    {13}\n"
-                "    (T=current time, V=cached video, A=cached audio)").
+                "    (T=current time, V=cached video, P=pinned video, A=cached audio)").
                 arg(timeline->getPath().get()).
                 arg(currentTime).
                 arg(inOutRange).
@@ -611,13 +1831,17 @@ namespace tl
                 arg(thread.audioDataRequests.size()).
                 arg(currentTimeDisplay).
                 arg(cachedVideoFramesDisplay).
-                arg(cachedAudioFramesDisplay));
+                arg(cachedAudioFramesDisplay).
+                arg(cacheInfo.videoRequestMax).
+                arg(cacheInfo.videoThroughput).
+                arg(cacheInfo.videoLatency));
         }
 
         bool Player::Private::PlaybackState::operator == (const PlaybackState& other) const
         {
             return
                 playback == other.playback &&
+                speed == other.speed &&
                 currentTime == other.currentTime &&
                 inOutRange == other.inOutRange &&
                 compare == other.compare &&
@@ -626,7 +1850,9 @@ namespace tl
                 videoLayer == other.videoLayer &&
                 compareVideoLayers == other.compareVideoLayers &&
                 audioOffset == other.audioOffset &&
-                cacheOptions == other.cacheOptions;
+                cacheOptions == other.cacheOptions &&
+                pinnedRanges == other.pinnedRanges &&
+                scrub == other.scrub;
         }
 
         bool Player::Private::PlaybackState::operator != (const PlaybackState& other) const
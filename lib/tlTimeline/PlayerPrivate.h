@@ -5,9 +5,11 @@
 
 #include <tlTimeline/Player.h>
 
+#include <tlTimeline/PlayerCache.h>
 #include <tlTimeline/Util.h>
 
 #include <tlCore/AudioResample.h>
+#include <tlCore/AudioRingBuffer.h>
 
 #if defined(TLRENDER_SDL2)
 #include <SDL2/SDL.h>
@@ -17,6 +19,10 @@
 #endif // TLRENDER_SDL3
 
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <list>
 #include <mutex>
 #include <thread>
 
@@ -29,17 +35,50 @@ namespace tl
             OTIO_NS::RationalTime loopPlayback(const OTIO_NS::RationalTime&, bool& looped);
 
             void clearRequests();
+            void cancelRequests();
             void clearCache();
+            void clearCache(const TimelineEdit&);
+            void timelineUpdate(const OTIO_NS::TimeRange&, const io::Info&);
+            size_t getVideoFrameByteCount() const;
             size_t getVideoCacheMax() const;
+            size_t getVideoCacheByteMax() const;
+            size_t getVideoCompressedMax() const;
+            size_t getVideoCompressedByteMax() const;
+            size_t getAudioSecondByteCount() const;
             size_t getAudioCacheMax() const;
+            size_t getVideoPinnedByteMax() const;
+            size_t getAudioPinnedMax() const;
+            std::vector<OTIO_NS::TimeRange> getVideoPinnedRanges() const;
+            std::vector<ftk::Range<int64_t> > getAudioPinnedRanges() const;
+            const std::vector<VideoData>* getVideo(const OTIO_NS::RationalTime&) const;
             OTIO_NS::TimeRange getVideoCacheRange(size_t max) const;
+            int64_t getVideoStride() const;
+            OTIO_NS::RationalTime getVideoStrideTime(const OTIO_NS::RationalTime&) const;
+            void getVideoCacheTimes(const OTIO_NS::TimeRange&, std::vector<OTIO_NS::RationalTime>&) const;
             ftk::Range<int64_t> getAudioCacheRange(size_t max) const;
+            void videoRequest(const OTIO_NS::RationalTime&, const std::chrono::steady_clock::time_point&);
+            void scrubRequest(const OTIO_NS::RationalTime&, const std::chrono::steady_clock::time_point&);
+            void scrubCancel();
+            void compressInit();
+            void compressStop();
+            void compressCancel();
+            std::future<std::shared_ptr<PlayerCompressedVideo> > compressRequest(std::vector<VideoData>);
+            std::future<std::vector<VideoData> > decompressRequest(const std::shared_ptr<PlayerCompressedVideo>&);
             void cacheUpdate();
+            bool isScrubbing(const std::chrono::steady_clock::time_point&) const;
+            void videoRequestUpdate(const std::chrono::steady_clock::time_point&);
+
+            void statsReset(bool counters);
+            void statsPresent(const OTIO_NS::RationalTime&);
+            void statsMiss(const OTIO_NS::RationalTime&);
+            void statsLatency(size_t index, float seconds);
+            void statsUpdate();
 
             bool hasAudio() const;
             void playbackReset(const OTIO_NS::RationalTime&);
             void audioInit(const std::shared_ptr<ftk::Context>&);
             void audioReset(const OTIO_NS::RationalTime&);
+            void audioUpdate();
 #if defined(TLRENDER_SDL2) || defined(TLRENDER_SDL3)
             void sdlCallback(uint8_t* stream, int len);
 #if defined(TLRENDER_SDL2)
@@ -53,9 +92,16 @@ namespace tl
 
             PlayerOptions playerOptions;
             std::shared_ptr<Timeline> timeline;
+
+            // The time range and I/O information can be changed by an edit,
+            // the player thread uses the copies in Thread.
             OTIO_NS::TimeRange timeRange = time::invalidTimeRange;
             io::Info ioInfo;
 
+            // Whether the timeline is reading the I/O information after an
+            // edit. The information is checked again when it is done.
+            bool ioInfoPending = false;
+
             std::shared_ptr<ftk::ObservableValue<double> > speed;
             std::shared_ptr<ftk::ObservableValue<Playback> > playback;
             std::shared_ptr<ftk::ObservableValue<Loop> > loop;
@@ -75,16 +121,24 @@ namespace tl
             std::shared_ptr<ftk::ObservableValue<double> > audioOffset;
             std::shared_ptr<ftk::ObservableList<AudioData> > currentAudioData;
             std::shared_ptr<ftk::ObservableValue<PlayerCacheOptions> > cacheOptions;
+            std::shared_ptr<ftk::ObservableValue<PlayerCachePriority> > cachePriority;
+            std::shared_ptr<ftk::ObservableList<OTIO_NS::TimeRange> > pinnedRanges;
             std::shared_ptr<ftk::ObservableValue<PlayerCacheInfo> > cacheInfo;
+            std::shared_ptr<ftk::ObservableValue<PlayerStats> > stats;
+            std::shared_ptr<ftk::ObservableValue<bool> > scrub;
             std::shared_ptr<ftk::ListObserver<audio::DeviceInfo> > audioDevicesObserver;
             std::shared_ptr<ftk::ValueObserver<audio::DeviceInfo> > defaultAudioDeviceObserver;
+            std::shared_ptr<ftk::ValueObserver<TimelineEdit> > editObserver;
+            std::weak_ptr<PlayerCacheSystem> cacheSystem;
 
             bool audioDevices = false;
             audio::Info audioInfo;
+            std::shared_ptr<audio::AudioRingBuffer> audioRingBuffer;
 #if defined(TLRENDER_SDL2)
             int sdlID = 0;
 #elif defined(TLRENDER_SDL3)
             SDL_AudioStream* sdlStream = nullptr;
+            std::vector<uint8_t> sdlBuffer;
 #endif // TLRENDER_SDL2
 
             std::atomic<bool> running;
@@ -92,6 +146,7 @@ namespace tl
             struct PlaybackState
             {
                 Playback playback = Playback::Stop;
+                double speed = 0.0;
                 OTIO_NS::RationalTime currentTime = time::invalidTime;
                 OTIO_NS::TimeRange inOutRange = time::invalidTimeRange;
                 std::vector<std::shared_ptr<Timeline> > compare;
@@ -101,6 +156,8 @@ namespace tl
                 std::vector<int> compareVideoLayers;
                 double audioOffset = 0.0;
                 PlayerCacheOptions cacheOptions;
+                std::vector<OTIO_NS::TimeRange> pinnedRanges;
+                bool scrub = false;
 
                 bool operator == (const PlaybackState&) const;
                 bool operator != (const PlaybackState&) const;
@@ -111,27 +168,94 @@ namespace tl
                 PlaybackState state;
                 bool clearRequests = false;
                 bool clearCache = false;
+                bool resetStats = false;
+                std::vector<TimelineEdit> edits;
+                bool timelineChanged = false;
+                OTIO_NS::TimeRange timeRange = time::invalidTimeRange;
+                io::Info ioInfo;
                 CacheDirection cacheDirection = CacheDirection::Forward;
                 std::vector<VideoData> currentVideoData;
                 std::vector<AudioData> currentAudioData;
                 PlayerCacheInfo cacheInfo;
+                PlayerStats stats;
                 std::mutex mutex;
             };
             Mutex mutex;
 
+            struct VideoRequests
+            {
+                std::vector<VideoRequest> requests;
+                std::vector<bool> ready;
+                std::chrono::steady_clock::time_point time;
+            };
+            void videoRequest(
+                const OTIO_NS::RationalTime&,
+                const io::Options&,
+                const std::chrono::steady_clock::time_point&,
+                VideoRequests&);
+
             struct Thread
             {
+                OTIO_NS::TimeRange timeRange = time::invalidTimeRange;
+                io::Info ioInfo;
                 PlaybackState state;
                 CacheDirection cacheDirection = CacheDirection::Forward;
-                std::map<OTIO_NS::RationalTime, std::vector<VideoRequest> > videoDataRequests;
-                std::map<OTIO_NS::RationalTime, std::vector<VideoData> > videoCache;
+                std::map<OTIO_NS::RationalTime, VideoRequests> videoDataRequests;
+                std::vector<OTIO_NS::RationalTime> videoCacheTimes;
+                int64_t videoStride = 1;
+                size_t videoRequestMax = 0;
+                bool videoRequestSaturated = false;
+                int videoRequestStep = 1;
+                size_t videoFrames = 0;
+                float videoLatencySum = 0.F;
+                float videoThroughput = 0.F;
+                float videoThroughputBase = 0.F;
+                float videoLatency = 0.F;
+                std::chrono::steady_clock::time_point videoRequestTimer;
+                PlayerStats stats;
+                std::vector<std::vector<float> > latencySamples;
+                OTIO_NS::RationalTime presentedTime = time::invalidTime;
+                OTIO_NS::RationalTime missTime = time::invalidTime;
+                std::chrono::steady_clock::time_point scrubTimer;
+                OTIO_NS::RationalTime scrubProxyTime = time::invalidTime;
+                VideoRequests scrubProxyRequests;
+                std::vector<VideoData> scrubProxyVideoData;
+                PlayerVideoCache videoCache;
+                PlayerVideoCache videoPinned;
+                PlayerCompressedVideoCache videoCompressed;
+                std::vector<OTIO_NS::RationalTime> videoCompressedTimes;
+                std::map<OTIO_NS::RationalTime, std::future<std::shared_ptr<PlayerCompressedVideo> > > videoCompressRequests;
+                std::map<OTIO_NS::RationalTime, std::future<std::vector<VideoData> > > videoDecompressRequests;
                 std::map<int64_t, AudioRequest> audioDataRequests;
+                size_t audioCacheSize = 0;
+                size_t audioCacheByteCount = 0;
+                Playback audioPlayback = Playback::Stop;
+                int64_t audioInputFrame = 0;
+                std::shared_ptr<audio::AudioRingBuffer> audioRingBuffer;
+                std::shared_ptr<audio::AudioResample> audioResample;
+                std::list<std::shared_ptr<audio::Audio> > audioBuffer;
+                std::vector<uint8_t> audioData;
                 std::chrono::steady_clock::time_point cacheTimer;
                 std::chrono::steady_clock::time_point logTimer;
                 std::thread thread;
             };
             Thread thread;
 
+            struct CompressMutex
+            {
+                std::list<std::function<void()> > jobs;
+                bool stopped = false;
+                std::mutex mutex;
+            };
+            CompressMutex compressMutex;
+
+            struct CompressThread
+            {
+                std::condition_variable cv;
+                std::vector<std::thread> threads;
+            };
+            CompressThread compressThread;
+
             struct AudioState
             {
                 Playback playback = Playback::Stop;
@@ -150,24 +274,13 @@ namespace tl
             {
                 AudioState state;
                 std::map<int64_t, AudioData> cache;
+                std::shared_ptr<audio::AudioRingBuffer> ringBuffer;
                 bool reset = false;
                 OTIO_NS::RationalTime start = time::invalidTime;
-                int64_t frame = 0;
                 std::mutex mutex;
             };
             AudioMutex audioMutex;
 
-            struct AudioThread
-            {
-                audio::Info info;
-                int64_t inputFrame = 0;
-                int64_t outputFrame = 0;
-                std::shared_ptr<audio::AudioResample> resample;
-                std::list<std::shared_ptr<audio::Audio> > buffer;
-                std::shared_ptr<audio::Audio> silence;
-            };
-            AudioThread audioThread;
-
             struct NoAudio
             {
                 std::chrono::steady_clock::time_point playbackTimer;
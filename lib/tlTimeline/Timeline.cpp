@@ -12,13 +12,28 @@
 #include <ftk/Core/Format.h>
 #include <ftk/Core/LogSystem.h>
 
+#include <algorithm>
+
 namespace tl
 {
     namespace timeline
     {
         namespace
         {
-            const size_t readCacheMax = 10;
+            const size_t videoFrameCacheMax = 16;
+        }
+
+        bool TimelineEdit::operator == (const TimelineEdit& other) const
+        {
+            return
+                video == other.video &&
+                audio == other.audio &&
+                timeRange == other.timeRange;
+        }
+
+        bool TimelineEdit::operator != (const TimelineEdit& other) const
+        {
+            return !(*this == other);
         }
 
         void Timeline::_init(
@@ -82,55 +97,32 @@ namespace tl
                 {}
             }
             p.options = options;
-            p.readCache.setMax(readCacheMax);
+            p.userIOOptions = options.ioOptions;
+            p.ioOptions = options.ioOptions;
+            p.ioInfoPending = false;
+            p.mutex.videoRequestMax = options.videoRequestMax;
+            p.readSystem = context->getSystem<io::ReadSystem>();
+            p.diskCacheSystem = context->getSystem<io::DiskCacheSystem>();
+            p.edit = ftk::ObservableValue<TimelineEdit>::create();
+            p.videoFrameCache.setMax(videoFrameCacheMax);
 
             // Get information about the timeline.
             p.timeRange = timeline::getTimeRange(p.otioTimeline.value);
-            for (const auto& i : p.otioTimeline.value->tracks()->children())
+            p.updateReadOptions();
+
+            // The first audio and video clips define the information for the
+            // timeline.
+            p.ioInfo = p.getIOInfo(p.otioTimeline.value);
+            if (p.ioInfo.audio.isValid())
             {
-                if (auto otioTrack = dynamic_cast<const OTIO_NS::Track*>(i.value))
-                {
-                    if (OTIO_NS::Track::Kind::audio == otioTrack->kind())
-                    {
-                        if (p.getAudioInfo(otioTrack))
-                        {
-                            auto j = p.options.ioOptions.find("FFmpeg/AudioChannelCount");
-                            if (j == p.options.ioOptions.end())
-                            {
-                                p.options.ioOptions["FFmpeg/AudioChannelCount"] =
-                                    ftk::Format("{0}").arg(p.ioInfo.audio.channelCount);
-                            }
-                            j = p.options.ioOptions.find("FFmpeg/AudioDataType");
-                            if (j == p.options.ioOptions.end())
-                            {
-                                p.options.ioOptions["FFmpeg/AudioDataType"] =
-                                    ftk::Format("{0}").arg(p.ioInfo.audio.dataType);
-                            }
-                            j = p.options.ioOptions.find("FFmpeg/AudioSampleRate");
-                            if (j == p.options.ioOptions.end())
-                            {
-                                p.options.ioOptions["FFmpeg/AudioSampleRate"] =
-                                    ftk::Format("{0}").arg(p.ioInfo.audio.sampleRate);
-                            }
-                            break;
-                        }
-                    }
-                }
-            }
-            for (const auto& i : p.otioTimeline.value->tracks()->children())
-            {
-                if (auto otioTrack = dynamic_cast<const OTIO_NS::Track*>(i.value))
-                {
-                    if (OTIO_NS::Track::Kind::video == otioTrack->kind())
-                    {
-                        if (p.getVideoInfo(otioTrack))
-                        {
-                            break;
-                        }
-                    }
-                }
+                p.ioOptions = p.getIOOptions(p.ioInfo);
+                p.options.ioOptions = p.ioOptions;
+                p.updateReadOptions();
             }
 
+            // Compile the timeline for resolving requests.
+            p.compile(p.otioTimeline.value, p.videoTracks, p.audioTracks);
+
             logSystem->print(
                 ftk::Format("tl::timeline::Timeline {0}").arg(this),
                 ftk::Format(
@@ -179,9 +171,11 @@ namespace tl
             return _p->context.lock();
         }
         
-        const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>& Timeline::getTimeline() const
+        OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> Timeline::getTimeline() const
         {
-            return _p->otioTimeline;
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.editMutex);
+            return p.otioTimeline;
         }
 
         const file::Path& Timeline::getPath() const
@@ -199,14 +193,23 @@ namespace tl
             return _p->options;
         }
 
-        const OTIO_NS::TimeRange& Timeline::getTimeRange() const
+        OTIO_NS::TimeRange Timeline::getTimeRange() const
         {
-            return _p->timeRange;
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.editMutex);
+            return p.timeRange;
         }
 
-        const io::Info& Timeline::getIOInfo() const
+        io::Info Timeline::getIOInfo() const
         {
-            return _p->ioInfo;
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.editMutex);
+            return p.ioInfo;
+        }
+
+        bool Timeline::isIOInfoPending() const
+        {
+            return _p->ioInfoPending;
         }
 
         VideoRequest Timeline::getVideo(
@@ -242,6 +245,23 @@ namespace tl
             return out;
         }
 
+        size_t Timeline::getVideoRequestMax() const
+        {
+            FTK_P();
+            std::unique_lock<std::mutex> lock(p.mutex.mutex);
+            return p.mutex.videoRequestMax;
+        }
+
+        void Timeline::setVideoRequestMax(size_t value)
+        {
+            FTK_P();
+            {
+                std::unique_lock<std::mutex> lock(p.mutex.mutex);
+                p.mutex.videoRequestMax = std::max(value, size_t(1));
+            }
+            p.thread.cv.notify_one();
+        }
+
         AudioRequest Timeline::getAudio(
             double seconds,
             const io::Options& options)
@@ -310,5 +330,65 @@ namespace tl
                 }
             }
         }
+
+        TimelineEdit Timeline::setTimeline(const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>& otioTimeline)
+        {
+            FTK_P();
+            TimelineEdit out;
+
+            // Compile the new timeline.
+            std::vector<Private::CompiledTrack> videoTracks;
+            std::vector<Private::CompiledTrack> audioTracks;
+            p.compile(otioTimeline.value, videoTracks, audioTracks);
+            const OTIO_NS::TimeRange timeRange = timeline::getTimeRange(otioTimeline.value);
+            out.timeRange = timeRange;
+
+            {
+                std::unique_lock<std::mutex> lock(p.editMutex);
+
+                // Compare with the current timeline.
+                if (timeRange.start_time() != p.timeRange.start_time())
+                {
+                    const OTIO_NS::TimeRange range = OTIO_NS::TimeRange::range_from_start_end_time(
+                        std::min(timeRange.start_time(), p.timeRange.start_time()),
+                        std::max(timeRange.end_time_exclusive(), p.timeRange.end_time_exclusive()));
+                    out.video.push_back(range);
+                    out.audio.push_back(range);
+                }
+                else
+                {
+                    out.video = Private::getChangedRanges(p.videoTracks, videoTracks);
+                    out.audio = Private::getChangedRanges(p.audioTracks, audioTracks);
+                    for (auto& range : out.video)
+                    {
+                        range = OTIO_NS::TimeRange(range.start_time() + timeRange.start_time(), range.duration());
+                    }
+                    for (auto& range : out.audio)
+                    {
+                        range = OTIO_NS::TimeRange(range.start_time() + timeRange.start_time(), range.duration());
+                    }
+                }
+
+                // Swap in the new timeline.
+                p.otioTimeline = otioTimeline;
+                p.videoTracks = std::move(videoTracks);
+                p.audioTracks = std::move(audioTracks);
+                p.timeRange = timeRange;
+                p.updateReadOptions();
+
+                // The I/O information is requested here and updated by the
+                // timeline thread, so edits do not wait for the media.
+                p.ioInfoRequest = p.getIOInfoRequest(otioTimeline.value);
+                p.ioInfoPending = true;
+            }
+
+            p.edit->setAlways(out);
+            return out;
+        }
+
+        std::shared_ptr<ftk::IObservableValue<TimelineEdit> > Timeline::observeEdit() const
+        {
+            return _p->edit;
+        }
     }
 }
@@ -69,6 +69,20 @@ namespace tl
             std::future<AudioData> future;
         };
 
+        //! Timeline edit. The time ranges that were changed by the edit, in
+        //! timeline time.
+        struct TimelineEdit
+        {
+            std::vector<OTIO_NS::TimeRange> video;
+            std::vector<OTIO_NS::TimeRange> audio;
+
+            //! The time range of the timeline after the edit.
+            OTIO_NS::TimeRange timeRange = time::invalidTimeRange;
+
+            bool operator == (const TimelineEdit&) const;
+            bool operator != (const TimelineEdit&) const;
+        };
+
         //! Timeline.
         class Timeline : public std::enable_shared_from_this<Timeline>
         {
@@ -125,8 +139,13 @@ namespace tl
             //! Get the context.
             std::shared_ptr<ftk::Context> getContext() const;
 
-            //! Get the timeline.
-            const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>& getTimeline() const;
+            //! Get the timeline. This function is thread safe, a copy is
+            //! returned since the timeline can be replaced by an edit.
+            //!
+            //! \note getTimeline(), getTimeRange(), and getIOInfo() used to
+            //! return const references. Callers that held on to a reference
+            //! across an edit must keep the returned copy instead.
+            OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> getTimeline() const;
 
             //! Get the file path.
             const file::Path& getPath() const;
@@ -134,18 +153,28 @@ namespace tl
             //! Get the audio file path.
             const file::Path& getAudioPath() const;
 
-            //! Get the timeline options.
+            //! Get the timeline options. The I/O options are not updated
+            //! by edits.
             const Options& getOptions() const;
 
             //! \name Information
             ///@{
 
-            //! Get the time range.
-            const OTIO_NS::TimeRange& getTimeRange() const;
+            //! Get the time range. This function is thread safe, a copy is
+            //! returned since the time range can be changed by an edit.
+            OTIO_NS::TimeRange getTimeRange() const;
 
             //! Get the I/O information. This information is retrieved from
-            //! the first clip in the timeline.
-            const io::Info& getIOInfo() const;
+            //! the first clip in the timeline. This function is thread safe,
+            //! a copy is returned since the information can be changed by an
+            //! edit.
+            io::Info getIOInfo() const;
+
+            //! Get whether the I/O information is being read after an edit.
+            //! The information is read on the timeline thread and
+            //! getIOInfo() returns the previous information until it is
+            //! done. This function is thread safe.
+            bool isIOInfoPending() const;
 
             ///@}
 
@@ -153,6 +182,10 @@ namespace tl
             ///@{
 
             //! Get video data.
+            //!
+            //! Tracks that are hidden by an opaque, full frame clip are not
+            //! read. Set the I/O option "Timeline/OcclusionCulling" to "0"
+            //! to read all of the tracks.
             VideoRequest getVideo(
                 const OTIO_NS::RationalTime&,
                 const io::Options& = io::Options());
@@ -165,6 +198,32 @@ namespace tl
             //! Cancel requests.
             void cancelRequests(const std::vector<uint64_t>&);
 
+            //! Get the maximum number of video requests in progress.
+            size_t getVideoRequestMax() const;
+
+            //! Set the maximum number of video requests in progress. This
+            //! defaults to Options::videoRequestMax.
+            void setVideoRequestMax(size_t);
+
+            ///@}
+
+            //! \name Editing
+            ///@{
+
+            //! Apply an edit by replacing the OTIO timeline. The new timeline
+            //! is compared with the current one and the changed time ranges
+            //! are returned. The I/O information is read again from the first
+            //! clips of the new timeline without waiting, see
+            //! isIOInfoPending().
+            TimelineEdit setTimeline(const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>&);
+
+            //! Observe edits. The observers are called from the thread that
+            //! calls setTimeline(), which should be the same thread that
+            //! creates the observers. Observers that hand the edits to other
+            //! threads should copy them under their own mutex, as
+            //! timeline::Player does.
+            std::shared_ptr<ftk::IObservableValue<TimelineEdit> > observeEdit() const;
+
             ///@}
 
         private:
@@ -24,6 +24,7 @@
 #include <mz_zip_rw.h>
 
 #include <filesystem>
+#include <unordered_map>
 
 namespace tl
 {
@@ -142,6 +143,89 @@ namespace tl
             void* reader = nullptr;
         };
 
+        namespace
+        {
+            //! Zip entry.
+            struct ZipEntry
+            {
+                uint64_t offset = 0;
+                uint64_t size = 0;
+                uint16_t method = 0;
+            };
+
+            //! Read the zip central directory into a map of entries.
+            std::unordered_map<std::string, ZipEntry> readZipEntries(void* reader)
+            {
+                std::unordered_map<std::string, ZipEntry> out;
+                int32_t err = mz_zip_reader_goto_first_entry(reader);
+                while (MZ_OK == err)
+                {
+                    mz_zip_file* fileInfo = nullptr;
+                    err = mz_zip_reader_entry_get_info(reader, &fileInfo);
+                    if (err != MZ_OK)
+                    {
+                        throw std::runtime_error("Cannot get zip entry information");
+                    }
+                    ZipEntry entry;
+                    entry.offset = fileInfo->disk_offset;
+                    entry.size = fileInfo->uncompressed_size;
+                    entry.method = fileInfo->compression_method;
+                    out[fileInfo->filename] = entry;
+                    err = mz_zip_reader_goto_next_entry(reader);
+                }
+                if (err != MZ_END_OF_LIST)
+                {
+                    throw std::runtime_error("Cannot read the zip central directory");
+                }
+                return out;
+            }
+
+            //! Get a pointer to the data of an uncompressed zip entry in a memory
+            //! mapped file.
+            const uint8_t* getZipEntryData(
+                const std::unordered_map<std::string, ZipEntry>& entries,
+                const std::shared_ptr<ftk::FileIO>& fileIO,
+                const std::string& fileName,
+                size_t& size)
+            {
+                const auto i = entries.find(fileName);
+                if (i == entries.end())
+                {
+                    throw std::runtime_error(ftk::Format(
+                        "Cannot find zip entry: \"{0}\"").arg(fileName));
+                }
+                if (i->second.method != MZ_COMPRESS_METHOD_STORE)
+                {
+                    throw std::runtime_error(ftk::Format(
+                        "Compressed zip entries are not supported: \"{0}\"").arg(fileName));
+                }
+
+                // The data follows the local file header, which may have a
+                // different extra field than the central directory.
+                const uint8_t* start = fileIO->getMemoryStart();
+                const uint64_t fileSize = fileIO->getSize();
+                const size_t localHeaderSize = 30;
+                if (!start || i->second.offset + localHeaderSize > fileSize)
+                {
+                    throw std::runtime_error(ftk::Format(
+                        "Cannot map zip entry: \"{0}\"").arg(fileName));
+                }
+                const uint8_t* header = start + i->second.offset;
+                const uint64_t offset =
+                    i->second.offset +
+                    localHeaderSize +
+                    (header[26] | (header[27] << 8)) +
+                    (header[28] | (header[29] << 8));
+                if (offset + i->second.size > fileSize)
+                {
+                    throw std::runtime_error(ftk::Format(
+                        "Cannot map zip entry: \"{0}\"").arg(fileName));
+                }
+                size = i->second.size;
+                return start + offset;
+            }
+        }
+
         OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> readOTIO(
             const file::Path& path,
             OTIO_NS::ErrorStatus* errorStatus)
@@ -159,6 +243,10 @@ namespace tl
                 {
                     ZipReader zipReader(fileName);
 
+                    // Read the central directory once instead of searching
+                    // it for every entry.
+                    const auto entries = readZipEntries(zipReader.reader);
+
                     const std::string contentFileName = "content.otio";
                     int32_t err = mz_zip_reader_locate_entry(
                         zipReader.reader,
@@ -193,6 +281,7 @@ namespace tl
                     out = dynamic_cast<OTIO_NS::Timeline*>(
                         OTIO_NS::Timeline::from_json_string(buf.data(), errorStatus));
 
+                    // Map the media entries directly from the file.
                     auto fileIO = ftk::FileIO::create(fileName, ftk::FileMode::Read);
                     for (auto clip : out->find_children<OTIO_NS::Clip>())
                     {
@@ -201,31 +290,17 @@ namespace tl
                         {
                             const std::string mediaFileName = file::Path(
                                 url::decode(externalReference->target_url())).get();
-
-                            int32_t err = mz_zip_reader_locate_entry(zipReader.reader, mediaFileName.c_str(), 0);
-                            if (err != MZ_OK)
-                            {
-                                throw std::runtime_error(ftk::Format(
-                                    "Cannot find zip entry: \"{0}\"").arg(mediaFileName));
-                            }
-                            err = mz_zip_reader_entry_get_info(zipReader.reader, &fileInfo);
-                            if (err != MZ_OK)
-                            {
-                                throw std::runtime_error(ftk::Format(
-                                    "Cannot get zip entry information: \"{0}\"").arg(mediaFileName));
-                            }
-
-                            const size_t headerSize =
-                                30 +
-                                fileInfo->filename_size +
-                                fileInfo->extrafield_size;
+                            size_t size = 0;
+                            const uint8_t* memory = getZipEntryData(
+                                entries,
+                                fileIO,
+                                mediaFileName,
+                                size);
                             auto memoryReference = new ZipMemoryReference(
                                 fileIO,
                                 externalReference->target_url(),
-                                fileIO->getMemoryStart() +
-                                fileInfo->disk_offset +
-                                headerSize,
-                                fileInfo->uncompressed_size,
+                                memory,
+                                size,
                                 externalReference->available_range(),
                                 externalReference->metadata());
                             clip->set_media_reference(memoryReference);
@@ -241,29 +316,13 @@ namespace tl
                             {
                                 const std::string mediaFileName = file::Path(
                                     url::decode(imageSequenceReference->target_url_for_image_number(number))).get();
-
-                                int32_t err = mz_zip_reader_locate_entry(zipReader.reader, mediaFileName.c_str(), 0);
-                                if (err != MZ_OK)
-                                {
-                                    throw std::runtime_error(ftk::Format(
-                                        "Cannot find zip entry: \"{0}\"").arg(mediaFileName));
-                                }
-                                err = mz_zip_reader_entry_get_info(zipReader.reader, &fileInfo);
-                                if (err != MZ_OK)
-                                {
-                                    throw std::runtime_error(ftk::Format(
-                                        "Cannot get zip entry information: \"{0}\"").arg(mediaFileName));
-                                }
-
-                                const size_t headerSize =
-                                    30 +
-                                    fileInfo->filename_size +
-                                    fileInfo->extrafield_size;
-                                memory.push_back(
-                                    fileIO->getMemoryStart() +
-                                    fileInfo->disk_offset +
-                                    headerSize);
-                                memory_sizes.push_back(fileInfo->uncompressed_size);
+                                size_t size = 0;
+                                memory.push_back(getZipEntryData(
+                                    entries,
+                                    fileIO,
+                                    mediaFileName,
+                                    size));
+                                memory_sizes.push_back(size);
                             }
                             auto memoryReference = new ZipMemorySequenceReference(
                                 fileIO,
@@ -341,6 +400,19 @@ namespace tl
                     }
                 }
 
+                // Request the separate audio information concurrently with
+                // the input.
+                std::shared_ptr<io::IRead> audioRead;
+                std::future<io::Info> audioInfoFuture;
+                if (!audioPath.isEmpty())
+                {
+                    audioRead = ioSystem->read(audioPath, options.ioOptions);
+                    if (audioRead)
+                    {
+                        audioInfoFuture = audioRead->getInfo();
+                    }
+                }
+
                 // Is the input a video or audio file?
                 if (auto read = ioSystem->read(path, options.ioOptions))
                 {
@@ -387,9 +459,9 @@ namespace tl
                     // Read the separate audio if provided.
                     if (!audioPath.isEmpty())
                     {
-                        if (auto audioRead = ioSystem->read(audioPath, options.ioOptions))
+                        if (audioInfoFuture.valid())
                         {
-                            const auto audioInfo = audioRead->getInfo().get();
+                            const auto audioInfo = audioInfoFuture.get();
 
                             auto audioClip = new OTIO_NS::Clip;
                             audioClip->set_source_range(audioInfo.audioTime);
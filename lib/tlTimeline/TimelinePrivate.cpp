@@ -13,7 +13,9 @@
 #include <ftk/Core/String.h>
 #include <ftk/Core/Time.h>
 
-#include <opentimelineio/transition.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 
 namespace tl
 {
@@ -22,66 +24,486 @@ namespace tl
         namespace
         {
             const std::chrono::milliseconds timeout(5);
+            const float aspectEpsilon = .0001F;
+
+            std::string getKey(const file::Path& path)
+            {
+                std::vector<std::string> out;
+                out.push_back(path.get());
+                out.push_back(path.getNumber());
+                return ftk::join(out, ';');
+            }
+
+            bool isOcclusionCulling(const io::Options& options)
+            {
+                const auto i = options.find("Timeline/OcclusionCulling");
+                return i == options.end() || i->second != "0";
+            }
         }
 
-        bool Timeline::Private::getVideoInfo(const OTIO_NS::Composable* composable)
+        void Timeline::Private::compile(
+            const OTIO_NS::Timeline* otioTimeline,
+            std::vector<CompiledTrack>& videoTracks,
+            std::vector<CompiledTrack>& audioTracks) const
         {
-            if (auto clip = dynamic_cast<const OTIO_NS::Clip*>(composable))
+            videoTracks.clear();
+            audioTracks.clear();
+            for (const auto& i : otioTimeline->tracks()->children())
             {
-                if (auto context = this->context.lock())
+                auto otioTrack = dynamic_cast<const OTIO_NS::Track*>(i.value);
+                if (!otioTrack)
+                {
+                    continue;
+                }
+                const bool video = OTIO_NS::Track::Kind::video == otioTrack->kind();
+                const bool audio = OTIO_NS::Track::Kind::audio == otioTrack->kind();
+                if (!video && !audio)
+                {
+                    continue;
+                }
+
+                // Create a segment for each item. Audio tracks only use clips.
+                CompiledTrack track;
+                track.enabled = otioTrack->enabled();
+                std::vector<int> childToSegment;
+                const auto& children = otioTrack->children();
+                for (const auto& child : children)
+                {
+                    int index = -1;
+                    auto otioItem = dynamic_cast<const OTIO_NS::Item*>(child.value);
+                    auto otioClip = dynamic_cast<const OTIO_NS::Clip*>(child.value);
+                    if (otioItem && (video || otioClip))
+                    {
+                        OTIO_NS::ErrorStatus errorStatus;
+                        const auto range = otioItem->trimmed_range_in_parent(&errorStatus);
+                        if (range.has_value())
+                        {
+                            Segment segment;
+                            segment.range = range.value();
+                            segment.seconds = OTIO_NS::TimeRange(
+                                segment.range.start_time().rescaled_to(1.0),
+                                segment.range.duration().rescaled_to(1.0));
+                            if (otioClip)
+                            {
+                                segment.clip = otioClip;
+                                segment.name = otioClip->name();
+                                segment.trimmedRange = otioClip->trimmed_range(&errorStatus);
+                                segment.availableRange = otioClip->available_range(&errorStatus);
+                                segment.path = timeline::getPath(
+                                    otioClip->media_reference(),
+                                    path.getDirectory(),
+                                    options.pathOptions);
+                                segment.readKey = getKey(segment.path);
+                                segment.memoryRead = getMemoryRead(otioClip->media_reference());
+                            }
+                            index = static_cast<int>(track.segments.size());
+                            track.segments.push_back(std::move(segment));
+                        }
+                    }
+                    childToSegment.push_back(index);
+                }
+
+                // Resolve the transitions between segments.
+                if (video)
                 {
-                    // The first video clip defines the video information for the timeline.
-                    if (auto read = getRead(clip, options.ioOptions))
+                    for (size_t j = 0; j < children.size(); ++j)
                     {
-                        const io::Info& ioInfo = read->getInfo().get();
-                        this->ioInfo.video = ioInfo.video;
-                        this->ioInfo.videoTime = ioInfo.videoTime;
-                        this->ioInfo.tags.insert(ioInfo.tags.begin(), ioInfo.tags.end());
-                        return true;
+                        auto otioTransition = dynamic_cast<const OTIO_NS::Transition*>(children[j].value);
+                        if (!otioTransition)
+                        {
+                            continue;
+                        }
+                        SegmentTransition transition;
+                        transition.transition = otioTransition;
+                        transition.type = toTransition(otioTransition->transition_type());
+                        transition.inOffset = otioTransition->in_offset();
+                        transition.outOffset = otioTransition->out_offset();
+                        const int prev = j > 0 ? childToSegment[j - 1] : -1;
+                        const int next = j + 1 < children.size() ? childToSegment[j + 1] : -1;
+                        if (prev != -1)
+                        {
+                            auto& segment = track.segments[prev];
+                            segment.outTransition = transition;
+                            if (next != -1 && track.segments[next].clip)
+                            {
+                                segment.outTransition.segment = next;
+                            }
+                        }
+                        if (next != -1)
+                        {
+                            auto& segment = track.segments[next];
+                            segment.inTransition = transition;
+                            if (prev != -1 && track.segments[prev].clip)
+                            {
+                                segment.inTransition.segment = prev;
+                            }
+                        }
                     }
+                    videoTracks.push_back(std::move(track));
+                }
+                else
+                {
+                    audioTracks.push_back(std::move(track));
                 }
             }
-            if (auto composition = dynamic_cast<const OTIO_NS::Composition*>(composable))
+        }
+
+        bool Timeline::Private::SegmentTransition::operator == (const SegmentTransition& other) const
+        {
+            return
+                (transition != nullptr) == (other.transition != nullptr) &&
+                type == other.type &&
+                inOffset == other.inOffset &&
+                outOffset == other.outOffset &&
+                (segment != -1) == (other.segment != -1);
+        }
+
+        bool Timeline::Private::SegmentTransition::operator != (const SegmentTransition& other) const
+        {
+            return !(*this == other);
+        }
+
+        bool Timeline::Private::Segment::operator == (const Segment& other) const
+        {
+            bool out =
+                range == other.range &&
+                (clip != nullptr) == (other.clip != nullptr) &&
+                name == other.name &&
+                trimmedRange == other.trimmedRange &&
+                availableRange == other.availableRange &&
+                readKey == other.readKey &&
+                memoryRead.size() == other.memoryRead.size() &&
+                inTransition == other.inTransition &&
+                outTransition == other.outTransition;
+            for (size_t i = 0; out && i < memoryRead.size(); ++i)
             {
-                for (const auto& child : composition->children())
+                out = memoryRead[i].p == other.memoryRead[i].p &&
+                    memoryRead[i].size == other.memoryRead[i].size;
+            }
+            return out;
+        }
+
+        bool Timeline::Private::Segment::operator != (const Segment& other) const
+        {
+            return !(*this == other);
+        }
+
+        OTIO_NS::TimeRange Timeline::Private::Segment::getExtent() const
+        {
+            // Include the neighboring frames that read this segment during
+            // a transition.
+            OTIO_NS::RationalTime start = range.start_time();
+            OTIO_NS::RationalTime end = range.end_time_exclusive();
+            if (inTransition.transition)
+            {
+                start -= inTransition.inOffset;
+            }
+            if (outTransition.transition)
+            {
+                end += outTransition.outOffset;
+            }
+            return OTIO_NS::TimeRange::range_from_start_end_time(start, end);
+        }
+
+        std::vector<OTIO_NS::TimeRange> Timeline::Private::getChangedRanges(
+            const std::vector<CompiledTrack>& a,
+            const std::vector<CompiledTrack>& b)
+        {
+            std::vector<OTIO_NS::TimeRange> ranges;
+            auto addTrack = [&ranges](const CompiledTrack& track)
+                {
+                    for (const auto& segment : track.segments)
+                    {
+                        ranges.push_back(segment.getExtent());
+                    }
+                };
+            auto addChanged = [&ranges](const CompiledTrack& a, const CompiledTrack& b)
+                {
+                    // Segments are matched by their start time.
+                    for (const auto& segment : a.segments)
+                    {
+                        auto i = std::lower_bound(
+                            b.segments.begin(),
+                            b.segments.end(),
+                            segment.range.start_time(),
+                            [](const Segment& value, const OTIO_NS::RationalTime& time)
+                            {
+                                return value.range.start_time() < time;
+                            });
+                        if (i == b.segments.end() || *i != segment)
+                        {
+                            ranges.push_back(segment.getExtent());
+                        }
+                    }
+                };
+            for (size_t i = 0; i < std::max(a.size(), b.size()); ++i)
+            {
+                if (i >= a.size() || i >= b.size())
                 {
-                    if (getVideoInfo(child))
+                    // Tracks were added or removed.
+                    if (i < a.size() && a[i].enabled)
                     {
-                        return true;
+                        addTrack(a[i]);
                     }
+                    if (i < b.size() && b[i].enabled)
+                    {
+                        addTrack(b[i]);
+                    }
+                }
+                else if (a[i].enabled != b[i].enabled)
+                {
+                    addTrack(a[i].enabled ? a[i] : b[i]);
+                }
+                else if (a[i].enabled)
+                {
+                    addChanged(a[i], b[i]);
+                    addChanged(b[i], a[i]);
+                }
+            }
+
+            // Merge the overlapping ranges.
+            std::sort(
+                ranges.begin(),
+                ranges.end(),
+                [](const OTIO_NS::TimeRange& a, const OTIO_NS::TimeRange& b)
+                {
+                    return a.start_time() < b.start_time();
+                });
+            std::vector<OTIO_NS::TimeRange> out;
+            for (const auto& range : ranges)
+            {
+                if (range.duration().value() <= 0.0)
+                {
+                    continue;
+                }
+                if (!out.empty() && range.start_time() <= out.back().end_time_exclusive())
+                {
+                    out.back() = OTIO_NS::TimeRange::range_from_start_end_time(
+                        out.back().start_time(),
+                        std::max(out.back().end_time_exclusive(), range.end_time_exclusive()));
+                }
+                else
+                {
+                    out.push_back(range);
                 }
             }
-            return false;
+            return out;
         }
 
-        bool Timeline::Private::getAudioInfo(const OTIO_NS::Composable* composable)
+        bool Timeline::Private::Segment::isOutTransition(const OTIO_NS::RationalTime& time) const
         {
-            if (auto clip = dynamic_cast<const OTIO_NS::Clip*>(composable))
+            return outTransition.transition &&
+                time > range.end_time_inclusive() - outTransition.inOffset;
+        }
+
+        bool Timeline::Private::Segment::isInTransition(const OTIO_NS::RationalTime& time) const
+        {
+            return inTransition.transition &&
+                time < range.start_time() + inTransition.outOffset;
+        }
+
+        const Timeline::Private::Segment* Timeline::Private::getSegment(
+            const CompiledTrack& track,
+            const OTIO_NS::RationalTime& time) const
+        {
+            const Segment* out = nullptr;
+            const auto& segments = track.segments;
+            auto i = std::upper_bound(
+                segments.begin(),
+                segments.end(),
+                time,
+                [](const OTIO_NS::RationalTime& value, const Segment& segment)
+                {
+                    return value < segment.range.start_time();
+                });
+            if (i != segments.begin())
             {
-                if (auto context = this->context.lock())
+                --i;
+                if (i->range.contains(time))
+                {
+                    out = &*i;
+                }
+            }
+            return out;
+        }
+
+        bool Timeline::Private::isOpaque(
+            const Segment& segment,
+            const OTIO_NS::RationalTime& time,
+            const io::Options& options)
+        {
+            // The segment hides the tracks below it when it is not in a
+            // transition, and the image has no alpha channel and fills the
+            // frame when it is fit to the timeline aspect ratio.
+            bool out = false;
+            if (segment.clip &&
+                !this->ioInfo.video.empty() &&
+                !segment.isOutTransition(time) &&
+                !segment.isInTransition(time))
+            {
+                // The media information is requested once and the segment
+                // is not opaque until it is ready, so the requests are never
+                // blocked waiting for a reader to open.
+                auto i = segmentInfo.find(segment.readKey);
+                if (i == segmentInfo.end())
+                {
+                    std::shared_future<io::Info> future;
+                    if (auto read = getRead(segment.path, segment.memoryRead))
+                    {
+                        future = read->getInfo().share();
+                    }
+                    i = segmentInfo.insert({ segment.readKey, future }).first;
+                }
+                if (i->second.valid() &&
+                    i->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
                 {
-                    // The first audio clip defines the audio information for the timeline.
-                    if (auto read = getRead(clip, options.ioOptions))
+                    const io::Options optionsMerged = io::merge(options, ioOptions);
+                    const io::Info& ioInfo = i->second.get();
+                    size_t layer = 0;
+                    const auto j = optionsMerged.find("Layer");
+                    if (j != optionsMerged.end())
                     {
-                        const io::Info& ioInfo = read->getInfo().get();
-                        this->ioInfo.audio = ioInfo.audio;
-                        this->ioInfo.audioTime = ioInfo.audioTime;
-                        this->ioInfo.tags.insert(ioInfo.tags.begin(), ioInfo.tags.end());
-                        return true;
+                        layer = std::max(0, std::atoi(j->second.c_str()));
+                    }
+                    if (layer < ioInfo.video.size())
+                    {
+                        const ftk::ImageInfo& info = ioInfo.video[layer];
+                        const int channelCount = ftk::getChannelCount(info.type);
+                        out =
+                            (1 == channelCount || 3 == channelCount) &&
+                            info.size.w > 0 &&
+                            info.size.h > 0 &&
+                            std::fabs(info.getAspect() - this->ioInfo.video.front().getAspect()) < aspectEpsilon;
                     }
                 }
             }
-            if (auto composition = dynamic_cast<const OTIO_NS::Composition*>(composable))
+            return out;
+        }
+
+        std::shared_ptr<io::IRead> Timeline::Private::getFirstRead(const OTIO_NS::Composable* composable)
+        {
+            std::shared_ptr<io::IRead> out;
+            if (auto clip = dynamic_cast<const OTIO_NS::Clip*>(composable))
+            {
+                out = getRead(clip);
+            }
+            else if (auto composition = dynamic_cast<const OTIO_NS::Composition*>(composable))
             {
                 for (const auto& child : composition->children())
                 {
-                    if (getAudioInfo(child))
+                    out = getFirstRead(child);
+                    if (out)
+                    {
+                        break;
+                    }
+                }
+            }
+            return out;
+        }
+
+        bool Timeline::Private::IOInfoRequest::isReady() const
+        {
+            return
+                (!audio.valid() || audio.wait_for(std::chrono::seconds(0)) == std::future_status::ready) &&
+                (!video.valid() || video.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        }
+
+        Timeline::Private::IOInfoRequest Timeline::Private::getIOInfoRequest(const OTIO_NS::Timeline* otioTimeline)
+        {
+            // The information for the first audio and video clips is
+            // requested concurrently.
+            IOInfoRequest out;
+            std::shared_ptr<io::IRead> audioRead;
+            std::shared_ptr<io::IRead> videoRead;
+            for (const auto& i : otioTimeline->tracks()->children())
+            {
+                if (auto otioTrack = dynamic_cast<const OTIO_NS::Track*>(i.value))
+                {
+                    if (OTIO_NS::Track::Kind::audio == otioTrack->kind() && !audioRead)
                     {
-                        return true;
+                        audioRead = getFirstRead(otioTrack);
                     }
+                    else if (OTIO_NS::Track::Kind::video == otioTrack->kind() && !videoRead)
+                    {
+                        videoRead = getFirstRead(otioTrack);
+                    }
+                }
+            }
+            if (audioRead)
+            {
+                out.audio = audioRead->getInfo();
+            }
+            if (videoRead)
+            {
+                out.video = videoRead->getInfo();
+            }
+            return out;
+        }
+
+        io::Info Timeline::Private::getIOInfo(IOInfoRequest& request)
+        {
+            io::Info out;
+            if (request.audio.valid())
+            {
+                const io::Info ioInfo = request.audio.get();
+                out.audio = ioInfo.audio;
+                out.audioTime = ioInfo.audioTime;
+                out.tags.insert(ioInfo.tags.begin(), ioInfo.tags.end());
+            }
+            if (request.video.valid())
+            {
+                const io::Info ioInfo = request.video.get();
+                out.video = ioInfo.video;
+                out.videoTime = ioInfo.videoTime;
+                out.videoProxy = ioInfo.videoProxy;
+                out.tags.insert(ioInfo.tags.begin(), ioInfo.tags.end());
+            }
+            return out;
+        }
+
+        io::Info Timeline::Private::getIOInfo(const OTIO_NS::Timeline* otioTimeline)
+        {
+            IOInfoRequest request = getIOInfoRequest(otioTimeline);
+            return getIOInfo(request);
+        }
+
+        io::Options Timeline::Private::getIOOptions(const io::Info& ioInfo) const
+        {
+            io::Options out = userIOOptions;
+            if (ioInfo.audio.isValid())
+            {
+                auto i = out.find("FFmpeg/AudioChannelCount");
+                if (i == out.end())
+                {
+                    out["FFmpeg/AudioChannelCount"] =
+                        ftk::Format("{0}").arg(ioInfo.audio.channelCount);
+                }
+                i = out.find("FFmpeg/AudioDataType");
+                if (i == out.end())
+                {
+                    out["FFmpeg/AudioDataType"] =
+                        ftk::Format("{0}").arg(ioInfo.audio.dataType);
                 }
+                i = out.find("FFmpeg/AudioSampleRate");
+                if (i == out.end())
+                {
+                    out["FFmpeg/AudioSampleRate"] =
+                        ftk::Format("{0}").arg(ioInfo.audio.sampleRate);
+                }
+            }
+            return out;
+        }
+
+        void Timeline::Private::ioInfoUpdate()
+        {
+            std::unique_lock<std::mutex> lock(editMutex);
+            if (ioInfoRequest.isReady())
+            {
+                ioInfo = getIOInfo(ioInfoRequest);
+                ioOptions = getIOOptions(ioInfo);
+                updateReadOptions();
+                ioInfoPending = false;
             }
-            return false;
         }
 
         float Timeline::Private::transitionValue(double frame, double in, double out) const
@@ -93,6 +515,12 @@ namespace tl
         {
             const auto t0 = std::chrono::steady_clock::now();
 
+            // Update the I/O information after an edit.
+            if (ioInfoPending)
+            {
+                ioInfoUpdate();
+            }
+
             requests();
 
             // Logging.
@@ -104,10 +532,12 @@ namespace tl
                 if (auto context = this->context.lock())
                 {
                     size_t videoRequestsSize = 0;
+                    size_t videoRequestMax = 0;
                     size_t audioRequestsSize = 0;
                     {
                         std::unique_lock<std::mutex> lock(mutex.mutex);
                         videoRequestsSize = mutex.videoRequests.size();
+                        videoRequestMax = mutex.videoRequestMax;
                         audioRequestsSize = mutex.audioRequests.size();
                     }
                     auto logSystem = context->getLogSystem();
@@ -121,7 +551,7 @@ namespace tl
                         arg(path.get()).
                         arg(videoRequestsSize).
                         arg(thread.videoRequestsInProgress.size()).
-                        arg(options.videoRequestMax).
+                        arg(videoRequestMax).
                         arg(audioRequestsSize).
                         arg(thread.audioRequestsInProgress.size()).
                         arg(options.audioRequestMax));
@@ -152,7 +582,7 @@ namespace tl
                             !thread.audioRequestsInProgress.empty();
                     });
                 while (!mutex.videoRequests.empty() &&
-                    (thread.videoRequestsInProgress.size() + newVideoRequests.size()) < options.videoRequestMax)
+                    (thread.videoRequestsInProgress.size() + newVideoRequests.size()) < mutex.videoRequestMax)
                 {
                     newVideoRequests.push_back(mutex.videoRequests.front());
                     mutex.videoRequests.pop_front();
@@ -165,134 +595,204 @@ namespace tl
                 }
             }
 
-            // Traverse the timeline for new video requests.
+            // The compiled tracks are locked while requests are resolved and
+            // finished so that edits are applied between ticks.
+            std::unique_lock<std::mutex> editLock(editMutex);
+
+            // Resolve new video requests with the compiled tracks.
             for (auto& request : newVideoRequests)
             {
-                for (const auto& otioTrack : otioTimeline->video_tracks())
+                const auto requestTime = request->time - timeRange.start_time();
+                std::vector<const Segment*> segments(videoTracks.size(), nullptr);
+                for (size_t i = 0; i < videoTracks.size(); ++i)
+                {
+                    if (videoTracks[i].enabled)
+                    {
+                        segments[i] = getSegment(videoTracks[i], requestTime);
+                    }
+                }
+
+                // Skip the tracks that are hidden by an opaque full frame clip.
+                size_t first = 0;
+                if (isOcclusionCulling(request->options))
+                {
+                    for (size_t i = segments.size(); i > 1; --i)
+                    {
+                        if (segments[i - 1] && isOpaque(*segments[i - 1], requestTime, request->options))
+                        {
+                            first = i - 1;
+                            break;
+                        }
+                    }
+                }
+
+                for (size_t i = first; i < segments.size(); ++i)
                 {
-                    if (otioTrack->enabled())
+                    if (!segments[i])
                     {
-                        for (const auto& otioChild : otioTrack->children())
+                        continue;
+                    }
+                    const Segment& segment = *segments[i];
+                    const auto& trackSegments = videoTracks[i].segments;
+                    VideoLayerData videoData;
+                    try
+                    {
+                        if (segment.clip)
                         {
-                            if (auto otioItem = dynamic_cast<OTIO_NS::Item*>(otioChild.value))
+                            videoData.image = readVideo(segment, requestTime, request->options);
+                        }
+                        const SegmentTransition& outTransition = segment.outTransition;
+                        if (segment.isOutTransition(requestTime))
+                        {
+                            videoData.transition = outTransition.type;
+                            videoData.transitionValue = transitionValue(
+                                requestTime.value(),
+                                segment.range.end_time_inclusive().value() - outTransition.inOffset.value(),
+                                segment.range.end_time_inclusive().value() + outTransition.outOffset.value() + 1.0);
+                            if (outTransition.segment != -1)
                             {
-                                const auto requestTime = request->time - timeRange.start_time();
-                                OTIO_NS::ErrorStatus errorStatus;
-                                const auto range = otioItem->trimmed_range_in_parent(&errorStatus);
-                                if (range.has_value() && range.value().contains(requestTime))
-                                {
-                                    VideoLayerData videoData;
-                                    try
-                                    {
-                                        if (auto otioClip = dynamic_cast<const OTIO_NS::Clip*>(otioItem))
-                                        {
-                                            videoData.image = readVideo(otioClip, requestTime, request->options);
-                                        }
-                                        const auto neighbors = otioTrack->neighbors_of(otioItem, &errorStatus);
-                                        if (auto otioTransition = dynamic_cast<OTIO_NS::Transition*>(neighbors.second.value))
-                                        {
-                                            if (requestTime > range.value().end_time_inclusive() - otioTransition->in_offset())
-                                            {
-                                                videoData.transition = toTransition(otioTransition->transition_type());
-                                                videoData.transitionValue = transitionValue(
-                                                    requestTime.value(),
-                                                    range.value().end_time_inclusive().value() - otioTransition->in_offset().value(),
-                                                    range.value().end_time_inclusive().value() + otioTransition->out_offset().value() + 1.0);
-                                                const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
-                                                if (const auto otioClipB = dynamic_cast<OTIO_NS::Clip*>(transitionNeighbors.second.value))
-                                                {
-                                                    videoData.imageB = readVideo(otioClipB, requestTime, request->options);
-                                                }
-                                            }
-                                        }
-                                        if (auto otioTransition = dynamic_cast<OTIO_NS::Transition*>(neighbors.first.value))
-                                        {
-                                            if (requestTime < range.value().start_time() + otioTransition->out_offset())
-                                            {
-                                                std::swap(videoData.image, videoData.imageB);
-                                                videoData.transition = toTransition(otioTransition->transition_type());
-                                                videoData.transitionValue = transitionValue(
-                                                    requestTime.value(),
-                                                    range.value().start_time().value() - otioTransition->in_offset().value() - 1.0,
-                                                    range.value().start_time().value() + otioTransition->out_offset().value());
-                                                const auto transitionNeighbors = otioTrack->neighbors_of(otioTransition, &errorStatus);
-                                                if (const auto otioClipB = dynamic_cast<OTIO_NS::Clip*>(transitionNeighbors.first.value))
-                                                {
-                                                    videoData.image = readVideo(otioClipB, requestTime, request->options);
-                                                }
-                                            }
-                                        }
-                                    }
-                                    catch (const std::exception&)
-                                    {
-                                        //! \todo How should this be handled?
-                                    }
-                                    request->layerData.push_back(std::move(videoData));
-                                }
+                                videoData.imageB = readVideo(
+                                    trackSegments[outTransition.segment],
+                                    requestTime,
+                                    request->options);
                             }
                         }
+                        const SegmentTransition& inTransition = segment.inTransition;
+                        if (segment.isInTransition(requestTime))
+                        {
+                            std::swap(videoData.image, videoData.imageB);
+                            videoData.transition = inTransition.type;
+                            videoData.transitionValue = transitionValue(
+                                requestTime.value(),
+                                segment.range.start_time().value() - inTransition.inOffset.value() - 1.0,
+                                segment.range.start_time().value() + inTransition.outOffset.value());
+                            if (inTransition.segment != -1)
+                            {
+                                videoData.image = readVideo(
+                                    trackSegments[inTransition.segment],
+                                    requestTime,
+                                    request->options);
+                            }
+                        }
+                    }
+                    catch (const std::exception&)
+                    {
+                        //! \todo How should this be handled?
                     }
+                    request->layerData.push_back(std::move(videoData));
                 }
 
                 thread.videoRequestsInProgress.push_back(request);
             }
 
-            // Traverse the timeline for new audio requests.
+            // Resolve new audio requests with the compiled tracks.
             for (auto& request : newAudioRequests)
             {
-                for (const auto& otioTrack : otioTimeline->audio_tracks())
+                const double start = request->seconds -
+                    timeRange.start_time().rescaled_to(1.0).value();
+                const OTIO_NS::TimeRange requestTimeRange = OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(start, 1.0),
+                    OTIO_NS::RationalTime(1.0, 1.0));
+                for (const auto& track : audioTracks)
                 {
-                    if (otioTrack->enabled())
+                    if (!track.enabled)
                     {
-                        for (const auto& otioChild : otioTrack->children())
+                        continue;
+                    }
+
+                    // Find the first segment that ends after the start of the
+                    // request. The previous segment is also checked so that
+                    // the intersection test below has the final word.
+                    const auto& segments = track.segments;
+                    auto i = std::partition_point(
+                        segments.begin(),
+                        segments.end(),
+                        [start](const Segment& segment)
                         {
-                            if (auto otioClip = dynamic_cast<OTIO_NS::Clip*>(otioChild.value))
+                            return segment.seconds.end_time_exclusive().value() <= start;
+                        });
+                    if (i != segments.begin())
+                    {
+                        --i;
+                    }
+                    for (; i != segments.end() &&
+                        i->seconds.start_time().value() <= start + 1.0; ++i)
+                    {
+                        const Segment& segment = *i;
+                        const OTIO_NS::TimeRange& clipTimeRange = segment.seconds;
+                        if (requestTimeRange.intersects(clipTimeRange))
+                        {
+                            AudioLayerData audioData;
+                            audioData.seconds = request->seconds;
+                            try
                             {
-                                const auto rangeOptional = otioClip->trimmed_range_in_parent();
-                                if (rangeOptional.has_value())
-                                {
-                                    const OTIO_NS::TimeRange clipTimeRange(
-                                        rangeOptional.value().start_time().rescaled_to(1.0),
-                                        rangeOptional.value().duration().rescaled_to(1.0));
-                                    const double start = request->seconds -
-                                        timeRange.start_time().rescaled_to(1.0).value();
-                                    const OTIO_NS::TimeRange requestTimeRange = OTIO_NS::TimeRange(
-                                        OTIO_NS::RationalTime(start, 1.0),
-                                        OTIO_NS::RationalTime(1.0, 1.0));
-                                    if (requestTimeRange.intersects(clipTimeRange))
-                                    {
-                                        AudioLayerData audioData;
-                                        audioData.seconds = request->seconds;
-                                        try
-                                        {
-                                            //! \bug Why is OTIO_NS::TimeRange::clamped() not giving us the
-                                            //! result we expect?
-                                            //audioData.timeRange = requestTimeRange.clamped(clipTimeRange);
-                                            const double start = std::max(
-                                                clipTimeRange.start_time().value(),
-                                                requestTimeRange.start_time().value());
-                                            const double end = std::min(
-                                                clipTimeRange.start_time().value() + clipTimeRange.duration().value(),
-                                                requestTimeRange.start_time().value() + requestTimeRange.duration().value());
-                                            audioData.timeRange = OTIO_NS::TimeRange(
-                                                OTIO_NS::RationalTime(start, 1.0),
-                                                OTIO_NS::RationalTime(end - start, 1.0));
-                                            audioData.audio = readAudio(otioClip, audioData.timeRange, request->options);
-                                        }
-                                        catch (const std::exception&)
-                                        {
-                                            //! \todo How should this be handled?
-                                        }
-                                        request->layerData.push_back(std::move(audioData));
-                                    }
-                                }
+                                //! \bug Why is OTIO_NS::TimeRange::clamped() not giving us the
+                                //! result we expect?
+                                //audioData.timeRange = requestTimeRange.clamped(clipTimeRange);
+                                const double start = std::max(
+                                    clipTimeRange.start_time().value(),
+                                    requestTimeRange.start_time().value());
+                                const double end = std::min(
+                                    clipTimeRange.start_time().value() + clipTimeRange.duration().value(),
+                                    requestTimeRange.start_time().value() + requestTimeRange.duration().value());
+                                audioData.timeRange = OTIO_NS::TimeRange(
+                                    OTIO_NS::RationalTime(start, 1.0),
+                                    OTIO_NS::RationalTime(end - start, 1.0));
+                                audioData.audio = readAudio(segment, audioData.timeRange, request->options);
+                            }
+                            catch (const std::exception&)
+                            {
+                                //! \todo How should this be handled?
                             }
+                            request->layerData.push_back(std::move(audioData));
                         }
                     }
                 }
                 thread.audioRequestsInProgress.push_back(request);
             }
 
+            // Check for finished disk cache reads. Frames that cannot be
+            // read from the disk cache are decoded instead.
+            auto diskCacheReadIt = thread.diskCacheReads.begin();
+            while (diskCacheReadIt != thread.diskCacheReads.end())
+            {
+                if (diskCacheReadIt->cacheFuture.valid() &&
+                    diskCacheReadIt->cacheFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    const io::VideoData videoData = diskCacheReadIt->cacheFuture.get();
+                    if (videoData.image)
+                    {
+                        diskCacheReadIt->promise.set_value(videoData);
+                        diskCacheReadIt = thread.diskCacheReads.erase(diskCacheReadIt);
+                        continue;
+                    }
+                    diskCacheReadIt->readFuture = diskCacheReadIt->read->readVideo(
+                        diskCacheReadIt->time,
+                        diskCacheReadIt->options).share();
+                    DiskCacheWrite write;
+                    write.mediaKey = diskCacheReadIt->mediaKey;
+                    write.frameKey = diskCacheReadIt->frameKey;
+                    write.read = diskCacheReadIt->read;
+                    write.future = diskCacheReadIt->readFuture;
+                    thread.diskCacheWrites.push_back(write);
+                }
+                if (diskCacheReadIt->readFuture.valid() &&
+                    diskCacheReadIt->readFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    try
+                    {
+                        diskCacheReadIt->promise.set_value(diskCacheReadIt->readFuture.get());
+                    }
+                    catch (const std::exception&)
+                    {
+                        diskCacheReadIt->promise.set_exception(std::current_exception());
+                    }
+                    diskCacheReadIt = thread.diskCacheReads.erase(diskCacheReadIt);
+                    continue;
+                }
+                ++diskCacheReadIt;
+            }
+
             // Check for finished video requests.
             auto videoRequestIt = thread.videoRequestsInProgress.begin();
             while (videoRequestIt != thread.videoRequestsInProgress.end())
@@ -339,6 +839,43 @@ namespace tl
                 ++videoRequestIt;
             }
 
+            // Write the decoded frames to the disk cache.
+            if (!thread.diskCacheWrites.empty())
+            {
+                auto diskCache = diskCacheSystem.lock();
+                auto i = thread.diskCacheWrites.begin();
+                while (i != thread.diskCacheWrites.end())
+                {
+                    if (i->future.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                    {
+                        if (diskCache)
+                        {
+                            try
+                            {
+                                const io::VideoData videoData = i->future.get();
+                                if (videoData.image)
+                                {
+                                    // The decode time is measured by the
+                                    // reader, so it does not include the
+                                    // time the request waited.
+                                    const float decodeTime = i->read->getVideoDecodeTime();
+                                    if (decodeTime > 0.F)
+                                    {
+                                        diskCache->addDecodeTime(i->mediaKey, decodeTime);
+                                    }
+                                    diskCache->write(i->mediaKey, i->frameKey, videoData);
+                                }
+                            }
+                            catch (const std::exception&)
+                            {}
+                        }
+                        i = thread.diskCacheWrites.erase(i);
+                        continue;
+                    }
+                    ++i;
+                }
+            }
+
             // Check for finished audio requests.
             auto audioRequestIt = thread.audioRequestsInProgress.begin();
             while (audioRequestIt != thread.audioRequestsInProgress.end())
@@ -442,90 +979,145 @@ namespace tl
             }
         }
 
-        namespace
+        void Timeline::Private::updateReadOptions()
         {
-            std::string getKey(const file::Path& path)
-            {
-                std::vector<std::string> out;
-                out.push_back(path.get());
-                out.push_back(path.getNumber());
-                return ftk::join(out, ';');
-            }
+            readOptions = ioOptions;
+            readOptions["SequenceIO/DefaultSpeed"] = ftk::Format("{0}").arg(timeRange.duration().rate());
         }
 
-        std::shared_ptr<io::IRead> Timeline::Private::getRead(
-            const OTIO_NS::Clip* clip,
-            const io::Options& ioOptions)
+        std::shared_ptr<io::IRead> Timeline::Private::getRead(const OTIO_NS::Clip* clip)
         {
-            std::shared_ptr<io::IRead> out;
             const auto path = timeline::getPath(
                 clip->media_reference(),
                 this->path.getDirectory(),
                 options.pathOptions);
-            const std::string key = getKey(path);
-            if (!readCache.get(key, out))
+            return getRead(path, getMemoryRead(clip->media_reference()));
+        }
+
+        std::shared_ptr<io::IRead> Timeline::Private::getRead(
+            const file::Path& path,
+            const std::vector<ftk::InMemoryFile>& memoryRead)
+        {
+            std::shared_ptr<io::IRead> out;
+            if (auto readSystem = this->readSystem.lock())
             {
-                if (auto context = this->context.lock())
-                {
-                    const auto memoryRead = getMemoryRead(clip->media_reference());
-                    io::Options options = ioOptions;
-                    options["SequenceIO/DefaultSpeed"] = ftk::Format("{0}").arg(timeRange.duration().rate());
-                    const auto ioSystem = context->getSystem<io::ReadSystem>();
-                    out = ioSystem->read(path, memoryRead, options);
-                    readCache.add(key, out);
-                }
+                out = readSystem->getRead(path, memoryRead, readOptions);
             }
             return out;
         }
 
-        std::future<io::VideoData> Timeline::Private::readVideo(
-            const OTIO_NS::Clip* clip,
+        bool Timeline::Private::VideoFrameKey::operator < (const VideoFrameKey& other) const
+        {
+            if (readKey != other.readKey)
+            {
+                return readKey < other.readKey;
+            }
+            if (time.value() != other.time.value())
+            {
+                return time.value() < other.time.value();
+            }
+            if (time.rate() != other.time.rate())
+            {
+                return time.rate() < other.time.rate();
+            }
+            return options < other.options;
+        }
+
+        std::shared_future<io::VideoData> Timeline::Private::readVideo(
+            const Segment& segment,
             const OTIO_NS::RationalTime& time,
             const io::Options& options)
         {
-            std::future<io::VideoData> out;
-            io::Options optionsMerged = io::merge(options, this->options.ioOptions);
-            optionsMerged["USD/CameraName"] = clip->name();
-            auto read = getRead(clip, optionsMerged);
-            const auto timeRangeOpt = clip->trimmed_range_in_parent();
-            if (read && timeRangeOpt.has_value())
+            std::shared_future<io::VideoData> out;
+            io::Options optionsMerged = io::merge(options, ioOptions);
+            optionsMerged["USD/CameraName"] = segment.name;
+            auto read = getRead(segment.path, segment.memoryRead);
+            if (read)
             {
                 const io::Info& ioInfo = read->getInfo().get();
-                OTIO_NS::TimeRange availableRange = clip->available_range();
-                OTIO_NS::TimeRange trimmedRange = clip->trimmed_range();
+                OTIO_NS::TimeRange trimmedRange = segment.trimmedRange;
                 if (this->options.compat &&
-                    availableRange.start_time() > ioInfo.videoTime.start_time())
+                    segment.availableRange.start_time() > ioInfo.videoTime.start_time())
                 {
                     //! \bug If the available range is greater than the media time,
                     //! assume the media time is wrong (e.g., Picchu) and
                     //! compensate for it.
                     trimmedRange = OTIO_NS::TimeRange(
-                        trimmedRange.start_time() - availableRange.start_time(),
+                        trimmedRange.start_time() - segment.availableRange.start_time(),
                         trimmedRange.duration());
                 }
                 const auto mediaTime = timeline::toVideoMediaTime(
                     time,
-                    timeRangeOpt.value(),
+                    segment.range,
                     trimmedRange,
                     ioInfo.videoTime.duration().rate());
-                out = read->readVideo(mediaTime, optionsMerged);
+
+                // Share the request with any in-flight or recent request
+                // for the same media frame.
+                VideoFrameKey key;
+                key.readKey = segment.readKey;
+                key.time = mediaTime;
+                key.options = optionsMerged;
+                if (!videoFrameCache.get(key, out))
+                {
+                    // Check the disk cache. Frames are read from the disk
+                    // cache when that is faster than decoding them, and
+                    // decoded frames are written to the disk cache when
+                    // they are finished.
+                    std::string mediaKey;
+                    std::string frameKey;
+                    auto diskCache = diskCacheSystem.lock();
+                    if (diskCache && segment.memoryRead.empty())
+                    {
+                        mediaKey = diskCache->getMediaKey(segment.path);
+                        if (!mediaKey.empty())
+                        {
+                            frameKey = io::DiskCacheSystem::getFrameKey(mediaKey, mediaTime, optionsMerged);
+                        }
+                    }
+                    if (!frameKey.empty() && diskCache->canRead(mediaKey, frameKey))
+                    {
+                        DiskCacheRead diskCacheRead;
+                        diskCacheRead.mediaKey = mediaKey;
+                        diskCacheRead.frameKey = frameKey;
+                        diskCacheRead.read = read;
+                        diskCacheRead.time = mediaTime;
+                        diskCacheRead.options = optionsMerged;
+                        diskCacheRead.cacheFuture = diskCache->readRequest(mediaKey, frameKey, mediaTime);
+                        out = diskCacheRead.promise.get_future().share();
+                        thread.diskCacheReads.push_back(std::move(diskCacheRead));
+                    }
+                    else
+                    {
+                        out = read->readVideo(mediaTime, optionsMerged).share();
+                        if (!frameKey.empty())
+                        {
+                            DiskCacheWrite write;
+                            write.mediaKey = mediaKey;
+                            write.frameKey = frameKey;
+                            write.read = read;
+                            write.future = out;
+                            thread.diskCacheWrites.push_back(write);
+                        }
+                    }
+                    videoFrameCache.add(key, out);
+                }
             }
             return out;
         }
 
         std::future<io::AudioData> Timeline::Private::readAudio(
-            const OTIO_NS::Clip* clip,
+            const Segment& segment,
             const OTIO_NS::TimeRange& timeRange,
             const io::Options& options)
         {
             std::future<io::AudioData> out;
-            io::Options optionsMerged = io::merge(options, this->options.ioOptions);
-            auto read = getRead(clip, optionsMerged);
-            const auto timeRangeOpt = clip->trimmed_range_in_parent();
-            if (read && timeRangeOpt.has_value())
+            io::Options optionsMerged = io::merge(options, ioOptions);
+            auto read = getRead(segment.path, segment.memoryRead);
+            if (read)
             {
                 const io::Info& ioInfo = read->getInfo().get();
-                OTIO_NS::TimeRange trimmedRange = clip->trimmed_range();
+                OTIO_NS::TimeRange trimmedRange = segment.trimmedRange;
                 if (this->options.compat &&
                     trimmedRange.start_time() < ioInfo.audioTime.start_time())
                 {
@@ -538,7 +1130,7 @@ namespace tl
                 }
                 const auto mediaRange = timeline::toAudioMediaTime(
                     timeRange,
-                    timeRangeOpt.value(),
+                    segment.range,
                     trimmedRange,
                     ioInfo.audio.sampleRate);
                 out = read->readAudio(mediaRange, optionsMerged);
@@ -5,14 +5,17 @@
 
 #include <tlTimeline/Timeline.h>
 
-#include <tlIO/Read.h>
+#include <tlIO/DiskCache.h>
+#include <tlIO/System.h>
 
 #include <ftk/Core/LRUCache.h>
 
 #include <opentimelineio/clip.h>
+#include <opentimelineio/transition.h>
 
 #include <atomic>
 #include <list>
+#include <map>
 #include <mutex>
 #include <thread>
 
@@ -22,8 +25,102 @@ namespace tl
     {
         struct Timeline::Private
         {
-            bool getVideoInfo(const OTIO_NS::Composable*);
-            bool getAudioInfo(const OTIO_NS::Composable*);
+            //! Transition between neighboring segments.
+            struct SegmentTransition
+            {
+                const OTIO_NS::Transition* transition = nullptr;
+                Transition                 type       = Transition::None;
+                OTIO_NS::RationalTime      inOffset;
+                OTIO_NS::RationalTime      outOffset;
+                int                        segment    = -1;
+
+                bool operator == (const SegmentTransition&) const;
+                bool operator != (const SegmentTransition&) const;
+            };
+
+            //! Compiled track item. The media reference is resolved and the
+            //! ranges are cached so that requests do not need to traverse
+            //! the OTIO timeline.
+            struct Segment
+            {
+                OTIO_NS::TimeRange               range          = time::invalidTimeRange;
+                OTIO_NS::TimeRange               seconds        = time::invalidTimeRange;
+                const OTIO_NS::Clip*             clip           = nullptr;
+                std::string                      name;
+                OTIO_NS::TimeRange               trimmedRange   = time::invalidTimeRange;
+                OTIO_NS::TimeRange               availableRange = time::invalidTimeRange;
+                file::Path                       path;
+                std::string                      readKey;
+                std::vector<ftk::InMemoryFile>   memoryRead;
+                SegmentTransition                inTransition;
+                SegmentTransition                outTransition;
+
+                //! Get whether the time is in the outgoing transition.
+                bool isOutTransition(const OTIO_NS::RationalTime&) const;
+
+                //! Get whether the time is in the incoming transition.
+                bool isInTransition(const OTIO_NS::RationalTime&) const;
+
+                //! Get the time range of the segment including the frames of
+                //! the neighboring segments that read it in a transition.
+                OTIO_NS::TimeRange getExtent() const;
+
+                bool operator == (const Segment&) const;
+                bool operator != (const Segment&) const;
+            };
+
+            //! Compiled track. The segments are sorted by start time and do
+            //! not overlap, so they can be searched with a binary search.
+            struct CompiledTrack
+            {
+                bool                 enabled = true;
+                std::vector<Segment> segments;
+            };
+
+            //! Compile the tracks of an OTIO timeline.
+            void compile(
+                const OTIO_NS::Timeline*,
+                std::vector<CompiledTrack>& videoTracks,
+                std::vector<CompiledTrack>& audioTracks) const;
+
+            //! Get the time ranges that differ between compiled tracks.
+            static std::vector<OTIO_NS::TimeRange> getChangedRanges(
+                const std::vector<CompiledTrack>&,
+                const std::vector<CompiledTrack>&);
+
+            //! Get the segment at the given time.
+            const Segment* getSegment(
+                const CompiledTrack&,
+                const OTIO_NS::RationalTime&) const;
+
+            //! Get whether the segment hides the tracks below it.
+            bool isOpaque(
+                const Segment&,
+                const OTIO_NS::RationalTime&,
+                const io::Options&);
+
+            //! Get a reader for the first clip with media.
+            std::shared_ptr<io::IRead> getFirstRead(const OTIO_NS::Composable*);
+
+            //! Information requests for the first audio and video clips.
+            struct IOInfoRequest
+            {
+                std::future<io::Info> audio;
+                std::future<io::Info> video;
+
+                bool isReady() const;
+            };
+            IOInfoRequest getIOInfoRequest(const OTIO_NS::Timeline*);
+            static io::Info getIOInfo(IOInfoRequest&);
+            io::Info getIOInfo(const OTIO_NS::Timeline*);
+
+            //! Get the I/O options with the audio format of the timeline.
+            //! Audio options given by the user are not changed.
+            io::Options getIOOptions(const io::Info&) const;
+
+            //! Update the I/O information when the requests started by an
+            //! edit are finished.
+            void ioInfoUpdate();
 
             float transitionValue(double frame, double in, double out) const;
 
@@ -31,15 +128,17 @@ namespace tl
             void requests();
             void finishRequests();
 
+            void updateReadOptions();
+            std::shared_ptr<io::IRead> getRead(const OTIO_NS::Clip*);
             std::shared_ptr<io::IRead> getRead(
-                const OTIO_NS::Clip*,
-                const io::Options&);
-            std::future<io::VideoData> readVideo(
-                const OTIO_NS::Clip*,
+                const file::Path&,
+                const std::vector<ftk::InMemoryFile>&);
+            std::shared_future<io::VideoData> readVideo(
+                const Segment&,
                 const OTIO_NS::RationalTime&,
                 const io::Options&);
             std::future<io::AudioData> readAudio(
-                const OTIO_NS::Clip*,
+                const Segment&,
                 const OTIO_NS::TimeRange&,
                 const io::Options&);
 
@@ -53,9 +152,36 @@ namespace tl
             file::Path path;
             file::Path audioPath;
             Options options;
-            ftk::LRUCache<std::string, std::shared_ptr<io::IRead> > readCache;
+            std::weak_ptr<io::ReadSystem> readSystem;
+            std::weak_ptr<io::DiskCacheSystem> diskCacheSystem;
+            io::Options readOptions;
+
+            //! Media frame key. Requests for the same media frame from
+            //! different timeline times or tracks share a single read.
+            struct VideoFrameKey
+            {
+                std::string           readKey;
+                OTIO_NS::RationalTime time;
+                io::Options           options;
+
+                bool operator < (const VideoFrameKey&) const;
+            };
+            ftk::LRUCache<VideoFrameKey, std::shared_future<io::VideoData> > videoFrameCache;
+
+            //! Media information used to check whether segments are opaque,
+            //! indexed by the read key.
+            std::map<std::string, std::shared_future<io::Info> > segmentInfo;
+
             OTIO_NS::TimeRange timeRange = time::invalidTimeRange;
+            std::vector<CompiledTrack> videoTracks;
+            std::vector<CompiledTrack> audioTracks;
+            std::shared_ptr<ftk::ObservableValue<TimelineEdit> > edit;
+            std::mutex editMutex;
             io::Info ioInfo;
+            io::Options userIOOptions;
+            io::Options ioOptions;
+            IOInfoRequest ioInfoRequest;
+            std::atomic<bool> ioInfoPending;
             uint64_t requestId = 0;
 
             struct VideoLayerData
@@ -63,8 +189,8 @@ namespace tl
                 VideoLayerData() {};
                 VideoLayerData(VideoLayerData&&) = default;
 
-                std::future<io::VideoData> image;
-                std::future<io::VideoData> imageB;
+                std::shared_future<io::VideoData> image;
+                std::shared_future<io::VideoData> imageB;
                 Transition transition = Transition::None;
                 float transitionValue = 0.F;
             };
@@ -107,14 +233,43 @@ namespace tl
             {
                 std::list<std::shared_ptr<VideoRequest> > videoRequests;
                 std::list<std::shared_ptr<AudioRequest> > audioRequests;
+                size_t videoRequestMax = 0;
                 bool stopped = false;
                 std::mutex mutex;
             };
             Mutex mutex;
+            //! Frame being read from the disk cache. If the frame cannot
+            //! be read it is decoded instead.
+            struct DiskCacheRead
+            {
+                DiskCacheRead() {};
+                DiskCacheRead(DiskCacheRead&&) = default;
+
+                std::string mediaKey;
+                std::string frameKey;
+                std::shared_ptr<io::IRead> read;
+                OTIO_NS::RationalTime time = time::invalidTime;
+                io::Options options;
+                std::future<io::VideoData> cacheFuture;
+                std::shared_future<io::VideoData> readFuture;
+                std::promise<io::VideoData> promise;
+            };
+
+            //! Decoded frame waiting to be written to the disk cache.
+            struct DiskCacheWrite
+            {
+                std::string mediaKey;
+                std::string frameKey;
+                std::shared_ptr<io::IRead> read;
+                std::shared_future<io::VideoData> future;
+            };
+
             struct Thread
             {
                 std::list<std::shared_ptr<VideoRequest> > videoRequestsInProgress;
                 std::list<std::shared_ptr<AudioRequest> > audioRequestsInProgress;
+                std::list<DiskCacheRead> diskCacheReads;
+                std::list<DiskCacheWrite> diskCacheWrites;
                 std::condition_variable cv;
                 std::thread thread;
                 std::atomic<bool> running;
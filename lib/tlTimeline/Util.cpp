@@ -20,7 +20,10 @@
 #include <opentimelineio/externalReference.h>
 #include <opentimelineio/imageSequenceReference.h>
 
+#include <atomic>
 #include <ctime>
+#include <filesystem>
+#include <future>
 
 #include <mz.h>
 #include <mz_os.h>
@@ -420,7 +423,103 @@ namespace tl
         FTK_ENUM_IMPL(
             ToMemoryReference,
             "Shared",
-            "Raw");
+            "Raw",
+            "Mapped");
+
+        namespace
+        {
+            //! Maximum number of files read concurrently when converting
+            //! to memory references.
+            const size_t memoryReadMax = 16;
+
+            //! File read into memory.
+            struct MemoryRead
+            {
+                std::string fileName;
+                std::shared_ptr<ftk::FileIO> fileIO;
+                std::shared_ptr<MemoryReferenceData> shared;
+                uint8_t* raw = nullptr;
+                size_t size = 0;
+            };
+
+            void readMemory(
+                MemoryRead& memoryRead,
+                ToMemoryReference toMemoryReference)
+            {
+                auto fileIO = ftk::FileIO::create(memoryRead.fileName, ftk::FileMode::Read);
+                memoryRead.size = fileIO->getSize();
+                switch (toMemoryReference)
+                {
+                case ToMemoryReference::Mapped:
+                    if (memoryRead.size > 0 && !fileIO->getMemoryStart())
+                    {
+                        throw std::runtime_error(ftk::Format(
+                            "Cannot memory map file: \"{0}\"").arg(memoryRead.fileName));
+                    }
+                    memoryRead.fileIO = fileIO;
+                    break;
+                case ToMemoryReference::Shared:
+                    memoryRead.shared = std::make_shared<MemoryReferenceData>();
+                    memoryRead.shared->resize(memoryRead.size);
+                    fileIO->read(memoryRead.shared->data(), memoryRead.size);
+                    break;
+                case ToMemoryReference::Raw:
+                    memoryRead.raw = new uint8_t[memoryRead.size];
+                    fileIO->read(memoryRead.raw, memoryRead.size);
+                    break;
+                default: break;
+                }
+            }
+
+            //! Read the files into memory with a bounded number of threads.
+            void readMemory(
+                std::vector<MemoryRead>& memoryReads,
+                ToMemoryReference toMemoryReference)
+            {
+                std::atomic<size_t> index(0);
+                std::vector<std::future<void> > futures;
+                const size_t threadCount = std::min(memoryReadMax, memoryReads.size());
+                for (size_t i = 0; i < threadCount; ++i)
+                {
+                    futures.push_back(std::async(
+                        std::launch::async,
+                        [&memoryReads, &index, toMemoryReference]
+                        {
+                            size_t j = index++;
+                            while (j < memoryReads.size())
+                            {
+                                readMemory(memoryReads[j], toMemoryReference);
+                                j = index++;
+                            }
+                        }));
+                }
+
+                // Wait for all of the threads before reporting an error.
+                std::exception_ptr error;
+                for (auto& future : futures)
+                {
+                    try
+                    {
+                        future.get();
+                    }
+                    catch (const std::exception&)
+                    {
+                        if (!error)
+                        {
+                            error = std::current_exception();
+                        }
+                    }
+                }
+                if (error)
+                {
+                    for (auto& memoryRead : memoryReads)
+                    {
+                        delete [] memoryRead.raw;
+                    }
+                    std::rethrow_exception(error);
+                }
+            }
+        }
 
         void toMemoryReferences(
             OTIO_NS::Timeline* otioTimeline,
@@ -428,114 +527,141 @@ namespace tl
             ToMemoryReference toMemoryReference,
             const file::PathOptions& pathOptions)
         {
-            // Recursively iterate over all clips in the timeline.
+            // Recursively iterate over all clips in the timeline and gather
+            // the files to read.
+            struct ClipRead
+            {
+                OTIO_NS::Clip* clip = nullptr;
+                file::Path path;
+                bool sequence = false;
+                size_t first = 0;
+                size_t count = 0;
+            };
+            std::vector<ClipRead> clipReads;
+            std::vector<MemoryRead> memoryReads;
             for (auto clip : otioTimeline->find_children<OTIO_NS::Clip>())
             {
                 if (auto ref = dynamic_cast<OTIO_NS::ExternalReference*>(clip->media_reference()))
                 {
                     // Get the external reference path.
-                    const auto path = getPath(ref->target_url(), directory, pathOptions);
+                    ClipRead clipRead;
+                    clipRead.clip = clip;
+                    clipRead.path = getPath(ref->target_url(), directory, pathOptions);
+                    clipRead.first = memoryReads.size();
+                    clipRead.count = 1;
+                    clipReads.push_back(clipRead);
+
+                    MemoryRead memoryRead;
+                    memoryRead.fileName = clipRead.path.get();
+                    memoryReads.push_back(memoryRead);
+                }
+                else if (auto ref = dynamic_cast<OTIO_NS::ImageSequenceReference*>(
+                    clip->media_reference()))
+                {
+                    // Get the image sequence reference path.
+                    const int padding = ref->frame_zero_padding();
+                    std::stringstream ss;
+                    ss << ref->target_url_base() <<
+                        ref->name_prefix() <<
+                        std::setfill('0') << std::setw(padding) << ref->start_frame() <<
+                        ref->name_suffix();
+                    ClipRead clipRead;
+                    clipRead.clip = clip;
+                    clipRead.path = getPath(ss.str(), directory, pathOptions);
+                    clipRead.sequence = true;
+                    clipRead.first = memoryReads.size();
+                    const auto range = clip->trimmed_range();
+                    for (
+                        int64_t frame = ref->start_frame();
+                        frame < ref->start_frame() + range.duration().value();
+                        ++frame)
+                    {
+                        MemoryRead memoryRead;
+                        memoryRead.fileName = clipRead.path.get(frame);
+                        memoryReads.push_back(memoryRead);
+                    }
+                    clipRead.count = memoryReads.size() - clipRead.first;
+                    clipReads.push_back(clipRead);
+                }
+            }
 
-                    // Read the external reference into memory.
-                    auto fileIO = ftk::FileIO::create(path.get(), ftk::FileMode::Read);
-                    const size_t size = fileIO->getSize();
+            // Read the files into memory.
+            readMemory(memoryReads, toMemoryReference);
 
-                    // Replace the external reference with a memory reference.
+            // Replace the media references with memory references.
+            for (const auto& clipRead : clipReads)
+            {
+                OTIO_NS::Clip* clip = clipRead.clip;
+                const auto ref = clip->media_reference();
+                if (!clipRead.sequence)
+                {
+                    const auto& memoryRead = memoryReads[clipRead.first];
+                    const std::string url =
+                        dynamic_cast<OTIO_NS::ExternalReference*>(ref)->target_url();
                     switch (toMemoryReference)
                     {
                     case ToMemoryReference::Shared:
-                    {
-                        auto memory = std::make_shared<MemoryReferenceData>();
-                        memory->resize(size);
-                        fileIO->read(memory->data(), size);
                         clip->set_media_reference(new SharedMemoryReference(
-                            ref->target_url(),
-                            memory,
+                            url,
+                            memoryRead.shared,
                             clip->available_range(),
                             ref->metadata()));
                         break;
-                    }
                     case ToMemoryReference::Raw:
-                    {
-                        uint8_t* memory = new uint8_t [size];
-                        fileIO->read(memory, size);
                         clip->set_media_reference(new RawMemoryReference(
-                            ref->target_url(),
-                            memory,
-                            size,
+                            url,
+                            memoryRead.raw,
+                            memoryRead.size,
+                            clip->available_range(),
+                            ref->metadata()));
+                        break;
+                    case ToMemoryReference::Mapped:
+                        clip->set_media_reference(new MappedMemoryReference(
+                            memoryRead.fileIO,
+                            url,
                             clip->available_range(),
                             ref->metadata()));
                         break;
-                    }
                     default: break;
                     }
                 }
-                else if (auto ref = dynamic_cast<OTIO_NS::ImageSequenceReference*>(
-                    clip->media_reference()))
+                else
                 {
-                    // Get the image sequence reference path.
-                    const int padding = ref->frame_zero_padding();
-                    std::stringstream ss;
-                    ss << ref->target_url_base() <<
-                        ref->name_prefix() <<
-                        std::setfill('0') << std::setw(padding) << ref->start_frame() <<
-                        ref->name_suffix();
-                    const auto path = getPath(ss.str(), directory, pathOptions);
-
-                    // Read the image sequence reference into memory.
                     std::vector<std::shared_ptr<MemoryReferenceData> > sharedMemoryList;
                     std::vector<const uint8_t*> rawMemoryList;
                     std::vector<size_t> rawMemorySizeList;
-                    const auto range = clip->trimmed_range();
-                    for (
-                        int64_t frame = ref->start_frame();
-                        frame < ref->start_frame() + range.duration().value();
-                        ++frame)
+                    std::vector<std::shared_ptr<ftk::FileIO> > fileIOList;
+                    for (size_t i = clipRead.first; i < clipRead.first + clipRead.count; ++i)
                     {
-                        const auto fileName = path.get(frame);
-                        auto fileIO = ftk::FileIO::create(fileName, ftk::FileMode::Read);
-                        const size_t size = fileIO->getSize();
-                        switch (toMemoryReference)
-                        {
-                        case ToMemoryReference::Shared:
-                        {
-                            auto memory = std::make_shared<MemoryReferenceData>();
-                            memory->resize(size);
-                            fileIO->read(memory->data(), size);
-                            sharedMemoryList.push_back(memory);
-                            break;
-                        }
-                        case ToMemoryReference::Raw:
-                        {
-                            auto memory = new uint8_t [size];
-                            fileIO->read(memory, size);
-                            rawMemoryList.push_back(memory);
-                            rawMemorySizeList.push_back(size);
-                            break;
-                        }
-                        default: break;
-                        }
+                        fileIOList.push_back(memoryReads[i].fileIO);
+                        sharedMemoryList.push_back(memoryReads[i].shared);
+                        rawMemoryList.push_back(memoryReads[i].raw);
+                        rawMemorySizeList.push_back(memoryReads[i].size);
                     }
-
-                    // Replace the image sequence reference with a memory
-                    // sequence reference.
                     switch (toMemoryReference)
                     {
                     case ToMemoryReference::Shared:
                         clip->set_media_reference(new SharedMemorySequenceReference(
-                            path.get(),
+                            clipRead.path.get(),
                             sharedMemoryList,
                             clip->available_range(),
                             ref->metadata()));
                         break;
                     case ToMemoryReference::Raw:
                         clip->set_media_reference(new RawMemorySequenceReference(
-                            path.get(),
+                            clipRead.path.get(),
                             rawMemoryList,
                             rawMemorySizeList,
                             clip->available_range(),
                             ref->metadata()));
                         break;
+                    case ToMemoryReference::Mapped:
+                        clip->set_media_reference(new MappedMemorySequenceReference(
+                            fileIOList,
+                            clipRead.path.get(),
+                            clip->available_range(),
+                            ref->metadata()));
+                        break;
                     default: break;
                     }
                 }
@@ -658,13 +784,17 @@ namespace tl
 
         namespace
         {
+            //! Block size for streaming media into .otioz files.
+            const size_t otiozBufferSize = 4 * 1024 * 1024;
+
             class OTIOZWriter
             {
             public:
                 OTIOZWriter(
                     const std::string& fileName,
                     const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>&,
-                    const std::string& directory = std::string());
+                    const std::string& directory = std::string(),
+                    const std::function<void(uint64_t, uint64_t)>& progress = nullptr);
 
                 ~OTIOZWriter();
 
@@ -685,14 +815,20 @@ namespace tl
 
                 std::string _fileName;
                 void* _writer = nullptr;
+                std::vector<uint8_t> _buffer;
+                uint64_t _bytes = 0;
+                uint64_t _totalBytes = 0;
+                std::function<void(uint64_t, uint64_t)> _progress;
             };
 
             OTIOZWriter::OTIOZWriter(
                 const std::string& fileName,
                 const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>& timeline,
-                const std::string& directory)
+                const std::string& directory,
+                const std::function<void(uint64_t, uint64_t)>& progress)
             {
                 _fileName = fileName;
+                _progress = progress;
 
                 // Copy the timeline.
                 OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> timelineCopy(
@@ -757,6 +893,18 @@ namespace tl
 
                 // Add the media files.
                 for (const auto& i : mediaFilesNames)
+                {
+                    std::error_code ec;
+                    const auto size = std::filesystem::file_size(
+                        std::filesystem::u8path(i.first),
+                        ec);
+                    if (!ec)
+                    {
+                        _totalBytes += size;
+                    }
+                }
+                _buffer.resize(otiozBufferSize);
+                for (const auto& i : mediaFilesNames)
                 {
                     _addUncompressed(i.first, i.second);
                 }
@@ -804,31 +952,42 @@ namespace tl
                 const std::string& fileName,
                 const std::string& fileNameInZip)
             {
-                /*auto fileIO = ftk::FileIO::create(fileName, ftk::FileMode::Read);
-                std::vector<uint8_t> buf(fileIO->getSize());
-                fileIO->read(buf.data(), buf.size());
+                // Stream the file into the archive in large blocks so the
+                // media is never held in memory.
+                auto fileIO = ftk::FileIO::create(fileName, ftk::FileMode::Read);
+                const uint64_t size = fileIO->getSize();
                 mz_zip_file fileInfo;
                 memset(&fileInfo, 0, sizeof(mz_zip_file));
                 fileInfo.version_madeby = MZ_VERSION_MADEBY;
+                fileInfo.flag = MZ_ZIP_FLAG_UTF8;
                 fileInfo.modified_date = std::time(nullptr);
                 fileInfo.compression_method = MZ_COMPRESS_METHOD_STORE;
                 fileInfo.filename = fileNameInZip.c_str();
-                int32_t err = mz_zip_writer_add_buffer(
-                    _writer,
-                    (void*)buf.data(),
-                    buf.size(),
-                    &fileInfo);
+                fileInfo.uncompressed_size = size;
+                int32_t err = mz_zip_writer_entry_open(_writer, &fileInfo);
                 if (err != MZ_OK)
                 {
-                    throw std::runtime_error(ftk::Format("Cannot add file: \"{0}\"").arg(_fileName));
-                }*/
-                mz_zip_writer_set_compress_method(
-                    _writer,
-                    MZ_COMPRESS_METHOD_STORE);
-                int32_t err = mz_zip_writer_add_file(
-                    _writer,
-                    fileName.c_str(),
-                    fileNameInZip.c_str());
+                    throw std::runtime_error(ftk::Format("Cannot add file: \"{0}\"").arg(fileName));
+                }
+                for (uint64_t i = 0; i < size;)
+                {
+                    const int32_t blockSize = static_cast<int32_t>(std::min(
+                        static_cast<uint64_t>(_buffer.size()),
+                        size - i));
+                    fileIO->read(_buffer.data(), blockSize);
+                    if (mz_zip_writer_entry_write(_writer, _buffer.data(), blockSize) != blockSize)
+                    {
+                        mz_zip_writer_entry_close(_writer);
+                        throw std::runtime_error(ftk::Format("Cannot write file: \"{0}\"").arg(fileName));
+                    }
+                    i += blockSize;
+                    _bytes += blockSize;
+                    if (_progress)
+                    {
+                        _progress(_bytes, _totalBytes);
+                    }
+                }
+                err = mz_zip_writer_entry_close(_writer);
                 if (err != MZ_OK)
                 {
                     throw std::runtime_error(ftk::Format("Cannot add file: \"{0}\"").arg(fileName));
@@ -903,12 +1062,13 @@ namespace tl
         bool writeOTIOZ(
             const std::string& fileName,
             const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>& timeline,
-            const std::string& directory)
+            const std::string& directory,
+            const std::function<void(uint64_t, uint64_t)>& progress)
         {
             bool out = false;
             try
             {
-                OTIOZWriter(fileName, timeline, directory);
+                OTIOZWriter(fileName, timeline, directory, progress);
                 out = true;
             }
             catch (const std::exception&)
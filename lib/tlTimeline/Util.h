@@ -10,6 +10,8 @@
 #include <opentimelineio/mediaReference.h>
 #include <opentimelineio/timeline.h>
 
+#include <functional>
+
 namespace tl
 {
     namespace timeline
@@ -94,11 +96,13 @@ namespace tl
         std::vector<ftk::InMemoryFile> getMemoryRead(
             const OTIO_NS::MediaReference*);
 
-        //! Convert to memory references.
+        //! Convert to memory references. Mapped references use memory mapped
+        //! files instead of copying the data.
         enum class ToMemoryReference
         {
             Shared,
             Raw,
+            Mapped,
 
             Count,
             First = Shared
@@ -134,11 +138,14 @@ namespace tl
             int64_t frame,
             int64_t size);
 
-        //! Write a timeline to an .otioz file.
+        //! Write a timeline to an .otioz file. The media files are streamed
+        //! into the archive, the progress callback is given the number of
+        //! bytes written and the total number of bytes.
         bool writeOTIOZ(
             const std::string& fileName,
             const OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline>&,
-            const std::string& directory = std::string());
+            const std::string& directory = std::string(),
+            const std::function<void(uint64_t, uint64_t)>& progress = nullptr);
     }
 }
 
@@ -10,6 +10,7 @@
 #include <tlIO/System.h>
 
 #include <tlCore/AudioResample.h>
+#include <tlCore/MemorySystem.h>
 
 #include <ftk/GL/GL.h>
 #include <ftk/GL/Window.h>
@@ -19,20 +20,19 @@
 #include <ftk/Core/LRUCache.h>
 #include <ftk/Core/String.h>
 
+#include <algorithm>
 #include <sstream>
 
 namespace tl
 {
     namespace timelineui
     {
-        namespace
-        {
-            const size_t ioCacheMax = 16;
-        }
-
         struct ThumbnailCache::Private
         {
+            std::weak_ptr<memory::System> memorySystem;
+            int memoryCache = 0;
             size_t max = 1000;
+            float scale = 1.F;
             ftk::LRUCache<std::string, io::Info> info;
             ftk::LRUCache<std::string, std::shared_ptr<ftk::Image> > thumbnails;
             ftk::LRUCache<std::string, std::shared_ptr<ftk::TriMesh2F> > waveforms;
@@ -41,7 +41,23 @@ namespace tl
 
         void ThumbnailCache::_init(const std::shared_ptr<ftk::Context>& context)
         {
+            FTK_P();
             _maxUpdate();
+
+            // Shrink the cache when the memory pressure is high.
+            if (auto memorySystem = context->getSystem<memory::System>())
+            {
+                p.memorySystem = memorySystem;
+                p.memoryCache = memorySystem->addCache(
+                    [this](float value)
+                    {
+                        {
+                            std::unique_lock<std::mutex> lock(_p->mutex);
+                            _p->scale = value;
+                        }
+                        _maxUpdate();
+                    });
+            }
         }
 
         ThumbnailCache::ThumbnailCache() :
@@ -49,7 +65,13 @@ namespace tl
         {}
 
         ThumbnailCache::~ThumbnailCache()
-        {}
+        {
+            FTK_P();
+            if (auto memorySystem = p.memorySystem.lock())
+            {
+                memorySystem->removeCache(p.memoryCache);
+            }
+        }
 
         std::shared_ptr<ThumbnailCache> ThumbnailCache::create(
             const std::shared_ptr<ftk::Context>& context)
@@ -219,9 +241,10 @@ namespace tl
         {
             FTK_P();
             std::unique_lock<std::mutex> lock(p.mutex);
-            p.info.setMax(p.max);
-            p.thumbnails.setMax(p.max);
-            p.waveforms.setMax(p.max);
+            const size_t max = std::max(static_cast<size_t>(p.max * p.scale), size_t(1));
+            p.info.setMax(max);
+            p.thumbnails.setMax(max);
+            p.waveforms.setMax(max);
         }
 
         struct ThumbnailGenerator::Private
@@ -301,7 +324,6 @@ namespace tl
             {
                 std::shared_ptr<timeline_gl::Render> render;
                 std::shared_ptr<ftk::gl::OffscreenBuffer> buffer;
-                ftk::LRUCache<std::string, std::shared_ptr<io::IRead> > ioCache;
                 std::condition_variable cv;
                 std::thread thread;
                 std::atomic<bool> running;
@@ -310,7 +332,6 @@ namespace tl
 
             struct WaveformThread
             {
-                ftk::LRUCache<std::string, std::shared_ptr<io::IRead> > ioCache;
                 std::condition_variable cv;
                 std::thread thread;
                 std::atomic<bool> running;
@@ -355,7 +376,6 @@ namespace tl
                     _infoCancel();
                 });
 
-            p.thumbnailThread.ioCache.setMax(ioCacheMax);
             p.thumbnailThread.running = true;
             p.thumbnailThread.thread = std::thread(
                 [this]
@@ -377,7 +397,6 @@ namespace tl
                     p.window->clearCurrent();
                 });
 
-            p.waveformThread.ioCache.setMax(ioCacheMax);
             p.waveformThread.running = true;
             p.waveformThread.thread = std::thread(
                 [this]
@@ -667,7 +686,7 @@ namespace tl
                         {
                             const std::string& fileName = request->path.get();
                             //std::cout << "info request: " << request->path.get() << std::endl;
-                            std::shared_ptr<io::IRead> read = ioSystem->read(
+                            std::shared_ptr<io::IRead> read = ioSystem->getRead(
                                 request->path,
                                 request->memoryRead,
                                 request->options);
@@ -723,15 +742,10 @@ namespace tl
                             const std::string& fileName = request->path.get();
                             //std::cout << "thumbnail request: " << fileName << " " <<
                             //    request->time << std::endl;
-                            std::shared_ptr<io::IRead> read;
-                            if (!p.thumbnailThread.ioCache.get(fileName, read))
-                            {
-                                read = ioSystem->read(
-                                    request->path,
-                                    request->memoryRead,
-                                    request->options);
-                                p.thumbnailThread.ioCache.add(fileName, read);
-                            }
+                            std::shared_ptr<io::IRead> read = ioSystem->getRead(
+                                request->path,
+                                request->memoryRead,
+                                request->options);
                             if (read)
                             {
                                 const io::Info info = read->getInfo().get();
@@ -751,7 +765,21 @@ namespace tl
                                     request->time != time::invalidTime ?
                                     request->time :
                                     info.videoTime.start_time();
-                                const auto videoData = read->readVideo(time, request->options).get();
+                                // Use a proxy resolution when the image is much
+                                // larger than the thumbnail.
+                                io::Options ioOptions = request->options;
+                                if (!info.video.empty() &&
+                                    ioOptions.find("Proxy") == ioOptions.end())
+                                {
+                                    int proxy = 1;
+                                    while (proxy < 8 &&
+                                        info.video[0].size.h / (proxy * 2) >= request->height)
+                                    {
+                                        proxy *= 2;
+                                    }
+                                    ioOptions["Proxy"] = ftk::Format("{0}").arg(proxy);
+                                }
+                                const auto videoData = read->readVideo(time, ioOptions).get();
                                 if (p.thumbnailThread.render && p.thumbnailThread.buffer && videoData.image)
                                 {
                                     ftk::gl::OffscreenBufferBinding binding(p.thumbnailThread.buffer);
@@ -997,17 +1025,11 @@ namespace tl
                     {
                         try
                         {
-                            const std::string& fileName = request->path.get();
-                            std::shared_ptr<io::IRead> read;
-                            if (!p.waveformThread.ioCache.get(fileName, read))
-                            {
-                                auto ioSystem = context->getSystem<io::ReadSystem>();
-                                read = ioSystem->read(
-                                    request->path,
-                                    request->memoryRead,
-                                    request->options);
-                                p.waveformThread.ioCache.add(fileName, read);
-                            }
+                            auto ioSystem = context->getSystem<io::ReadSystem>();
+                            std::shared_ptr<io::IRead> read = ioSystem->getRead(
+                                request->path,
+                                request->memoryRead,
+                                request->options);
                             if (read)
                             {
                                 const auto info = read->getInfo().get();
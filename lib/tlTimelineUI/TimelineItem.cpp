@@ -470,6 +470,7 @@ namespace tl
                 const OTIO_NS::RationalTime time = posToTime(event.pos.x);
                 p.scrub->setIfChanged(true);
                 p.timeScrub->setIfChanged(time);
+                p.player->setScrub(true);
                 p.player->seek(time);
             }
         }
@@ -479,6 +480,7 @@ namespace tl
             IItem::mouseReleaseEvent(event);
             FTK_P();
             p.scrub->setIfChanged(false);
+            p.player->setScrub(false);
             p.mouseMode = Private::MouseMode::None;
         }
 
@@ -649,13 +651,15 @@ namespace tl
 
             const ftk::Box2I& g = getGeometry();
 
-            // Draw the video cache.
+            // Draw the video cache, including the pinned ranges.
             if (CacheDisplay::VideoAndAudio == _displayOptions.cacheDisplay ||
                 CacheDisplay::VideoOnly == _displayOptions.cacheDisplay)
             {
+                std::vector<OTIO_NS::TimeRange> ranges = p.cacheInfo.video;
+                ranges.insert(ranges.end(), p.cacheInfo.pinnedVideo.begin(), p.cacheInfo.pinnedVideo.end());
                 ftk::TriMesh2F mesh;
                 size_t i = 1;
-                for (const auto& t : p.cacheInfo.video)
+                for (const auto& t : ranges)
                 {
                     const int x0 = timeToPos(t.start_time());
                     const int x1 = timeToPos(t.end_time_exclusive());
@@ -693,9 +697,11 @@ namespace tl
             // Draw the audio cache.
             if (CacheDisplay::VideoAndAudio == _displayOptions.cacheDisplay)
             {
+                std::vector<OTIO_NS::TimeRange> ranges = p.cacheInfo.audio;
+                ranges.insert(ranges.end(), p.cacheInfo.pinnedAudio.begin(), p.cacheInfo.pinnedAudio.end());
                 ftk::TriMesh2F mesh;
                 size_t i = 1;
-                for (const auto& t : p.cacheInfo.audio)
+                for (const auto& t : ranges)
                 {
                     const int x0 = timeToPos(t.start_time());
                     const int x1 = timeToPos(t.end_time_exclusive());
@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+// Check that the player's audio device callback does not allocate memory.
+// This is a separate executable since it replaces the global operator new
+// to count the allocations.
+
+#include <tlTimeline/Audio.h>
+
+#include <ftk/Core/Assert.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+using namespace tl;
+using namespace tl::audio;
+
+namespace
+{
+    // Count the memory allocations made by a thread.
+    thread_local bool countAllocations = false;
+    thread_local size_t allocationCount = 0;
+}
+
+void* operator new(std::size_t size)
+{
+    if (countAllocations)
+    {
+        ++allocationCount;
+    }
+    if (void* out = std::malloc(size > 0 ? size : 1))
+    {
+        return out;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    // The ring buffer is primed and then filled by a producer thread like
+    // the player thread, and read from another thread with the player's
+    // audio callback, with byte counts that are not always a whole number
+    // of samples.
+    const Info info(2, DataType::S16, 48000);
+    const size_t sampleCount = 48000;
+    const size_t bufferSampleCount = 256;
+    auto ringBuffer = AudioRingBuffer::create(info, bufferSampleCount * 4);
+    std::vector<S16_T> prime(bufferSampleCount * info.channelCount);
+    for (size_t i = 0; i < bufferSampleCount; ++i)
+    {
+        prime[i * 2] = i;
+        prime[i * 2 + 1] = i;
+    }
+    FTK_ASSERT(bufferSampleCount == ringBuffer->write(
+        reinterpret_cast<const uint8_t*>(prime.data()),
+        bufferSampleCount));
+    std::thread thread(
+        [ringBuffer, info, sampleCount, bufferSampleCount]
+        {
+            std::vector<S16_T> data(100 * info.channelCount);
+            size_t value = bufferSampleCount;
+            while (value < sampleCount)
+            {
+                size_t count = 0;
+                for (; count < 100 && value + count < sampleCount; ++count)
+                {
+                    data[count * 2] = value + count;
+                    data[count * 2 + 1] = value + count;
+                }
+                const auto p = reinterpret_cast<const uint8_t*>(data.data());
+                size_t written = 0;
+                while (written < count)
+                {
+                    written += ringBuffer->write(
+                        p + written * info.getByteCount(),
+                        count - written);
+                    std::this_thread::yield();
+                }
+                value += count;
+            }
+        });
+
+    std::vector<uint8_t> out(bufferSampleCount * info.getByteCount());
+    size_t read = 0;
+    size_t expected = 0;
+    bool valid = true;
+    size_t callbacks = 0;
+    countAllocations = true;
+    while (read < sampleCount)
+    {
+        const size_t byteCount = 0 == callbacks % 2 ? out.size() : (out.size() - 2);
+        const int64_t readCount = ringBuffer->getReadCount();
+        timeline::audioCallback(ringBuffer, out.data(), byteCount);
+        const size_t count = ringBuffer->getReadCount() - readCount;
+        const S16_T* samples = reinterpret_cast<const S16_T*>(out.data());
+        for (size_t i = 0; i < count; ++i, ++expected)
+        {
+            valid &= static_cast<S16_T>(expected) == samples[i * 2];
+            valid &= static_cast<S16_T>(expected) == samples[i * 2 + 1];
+        }
+        for (size_t i = count * info.getByteCount(); i < byteCount; ++i)
+        {
+            valid &= 0 == out[i];
+        }
+        read += count;
+        ++callbacks;
+        std::this_thread::yield();
+    }
+    countAllocations = false;
+    thread.join();
+    FTK_ASSERT(valid);
+    FTK_ASSERT(sampleCount == ringBuffer->getReadCount());
+    FTK_ASSERT(0 == allocationCount);
+
+    // Silence is output without a ring buffer.
+    out.assign(out.size(), 1);
+    countAllocations = true;
+    timeline::audioCallback(nullptr, out.data(), out.size());
+    countAllocations = false;
+    for (const auto i : out)
+    {
+        FTK_ASSERT(0 == i);
+    }
+    FTK_ASSERT(0 == allocationCount);
+    std::cout << "Finished tests" << std::endl;
+    return 0;
+}
@@ -4,9 +4,11 @@
 #include <tlCoreTest/AudioTest.h>
 
 #include <tlCore/AudioResample.h>
+#include <tlCore/AudioRingBuffer.h>
 #include <tlCore/AudioSystem.h>
 
 #include <cstring>
+#include <thread>
 
 using namespace tl::audio;
 
@@ -35,6 +37,7 @@ namespace tl
             _convert();
             _move();
             _resample();
+            _ringBuffer();
         }
 
         void AudioTest::_enums()
@@ -420,5 +423,131 @@ namespace tl
                 r->flush();
             }
         }
+
+        void AudioTest::_ringBuffer()
+        {
+            {
+                const Info info(2, DataType::S16, 48000);
+                auto ringBuffer = AudioRingBuffer::create(info, 10);
+                FTK_ASSERT(info == ringBuffer->getInfo());
+                FTK_ASSERT(10 == ringBuffer->getSampleCount());
+                FTK_ASSERT(0 == ringBuffer->getReadAvailable());
+                FTK_ASSERT(10 == ringBuffer->getWriteAvailable());
+
+                std::vector<S16_T> in(20 * 2);
+                for (size_t i = 0; i < 20; ++i)
+                {
+                    in[i * 2] = i;
+                    in[i * 2 + 1] = i;
+                }
+                std::vector<S16_T> out(20 * 2, 0);
+                auto inP = reinterpret_cast<const uint8_t*>(in.data());
+                auto outP = reinterpret_cast<uint8_t*>(out.data());
+
+                // Write past the end of the buffer.
+                FTK_ASSERT(8 == ringBuffer->write(inP, 8));
+                FTK_ASSERT(5 == ringBuffer->read(outP, 5));
+                FTK_ASSERT(7 == ringBuffer->write(inP + 8 * info.getByteCount(), 12));
+                FTK_ASSERT(10 == ringBuffer->getReadAvailable());
+                FTK_ASSERT(0 == ringBuffer->getWriteAvailable());
+                FTK_ASSERT(10 == ringBuffer->read(outP + 5 * info.getByteCount(), 10));
+                for (size_t i = 0; i < 15; ++i)
+                {
+                    FTK_ASSERT(i == out[i * 2]);
+                    FTK_ASSERT(i == out[i * 2 + 1]);
+                }
+                FTK_ASSERT(15 == ringBuffer->getReadCount());
+
+                // Read past the end of the samples.
+                std::fill(out.begin(), out.end(), 1);
+                FTK_ASSERT(2 == ringBuffer->write(inP, 2));
+                FTK_ASSERT(2 == ringBuffer->read(outP, 4));
+                FTK_ASSERT(1 == out[2]);
+                FTK_ASSERT(0 == out[4]);
+                FTK_ASSERT(0 == out[7]);
+
+                // Flush the buffer.
+                FTK_ASSERT(6 == ringBuffer->write(inP, 6));
+                ringBuffer->flush();
+                FTK_ASSERT(0 == ringBuffer->getReadAvailable());
+                FTK_ASSERT(4 == ringBuffer->getWriteAvailable());
+                FTK_ASSERT(0 == ringBuffer->getReadCount());
+                FTK_ASSERT(0 == ringBuffer->read(outP, 4));
+                FTK_ASSERT(10 == ringBuffer->getWriteAvailable());
+                FTK_ASSERT(3 == ringBuffer->write(inP + 10 * info.getByteCount(), 3));
+                FTK_ASSERT(3 == ringBuffer->read(outP, 3));
+                FTK_ASSERT(10 == out[0]);
+                FTK_ASSERT(12 == out[4]);
+                FTK_ASSERT(3 == ringBuffer->getReadCount());
+
+                // Read bytes that are not a whole number of samples.
+                std::fill(out.begin(), out.end(), 1);
+                FTK_ASSERT(2 == ringBuffer->write(inP, 2));
+                FTK_ASSERT(2 == ringBuffer->readBytes(outP, 2 * info.getByteCount() + 2));
+                FTK_ASSERT(0 == out[0]);
+                FTK_ASSERT(1 == out[3]);
+                FTK_ASSERT(0 == out[4]);
+                FTK_ASSERT(1 == out[5]);
+                out[0] = 1;
+                FTK_ASSERT(0 == ringBuffer->readBytes(outP, 2));
+                FTK_ASSERT(0 == out[0]);
+            }
+            {
+                // Read from another thread like an audio callback. The
+                // memory allocations are checked by tlAudioCallbackTest.
+                const Info info(1, DataType::S32, 48000);
+                const size_t sampleCount = 48000;
+                const size_t bufferSampleCount = 256;
+                auto ringBuffer = AudioRingBuffer::create(info, bufferSampleCount * 4);
+                std::thread thread(
+                    [ringBuffer, sampleCount]
+                    {
+                        S32_T value = 0;
+                        while (value < static_cast<S32_T>(sampleCount))
+                        {
+                            std::vector<S32_T> data(100);
+                            size_t count = 0;
+                            for (; count < data.size() && value + count < sampleCount; ++count)
+                            {
+                                data[count] = value + count;
+                            }
+                            const auto p = reinterpret_cast<const uint8_t*>(data.data());
+                            size_t written = 0;
+                            while (written < count)
+                            {
+                                written += ringBuffer->write(
+                                    p + written * sizeof(S32_T),
+                                    count - written);
+                                std::this_thread::yield();
+                            }
+                            value += count;
+                        }
+                    });
+
+                std::vector<S32_T> out(bufferSampleCount);
+                size_t read = 0;
+                S32_T expected = 0;
+                bool valid = true;
+                while (read < sampleCount)
+                {
+                    const size_t count = ringBuffer->read(
+                        reinterpret_cast<uint8_t*>(out.data()),
+                        bufferSampleCount);
+                    for (size_t i = 0; i < count; ++i, ++expected)
+                    {
+                        valid &= expected == out[i];
+                    }
+                    for (size_t i = count; i < bufferSampleCount; ++i)
+                    {
+                        valid &= 0 == out[i];
+                    }
+                    read += count;
+                    std::this_thread::yield();
+                }
+                thread.join();
+                FTK_ASSERT(valid);
+                FTK_ASSERT(sampleCount == ringBuffer->getReadCount());
+            }
+        }
     }
 }
@@ -30,6 +30,7 @@ namespace tl
             void _convert();
             void _move();
             void _resample();
+            void _ringBuffer();
         };
     }
 }
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlCoreTest/MemorySystemTest.h>
+
+#include <tlCore/MemorySystem.h>
+
+#include <ftk/Core/Assert.h>
+#include <ftk/Core/FileIO.h>
+#include <ftk/Core/Format.h>
+#include <ftk/Core/Memory.h>
+
+#include <cmath>
+
+using namespace tl::memory;
+
+namespace tl
+{
+    namespace core_tests
+    {
+        MemorySystemTest::MemorySystemTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "core_tests::MemorySystemTest")
+        {}
+
+        std::shared_ptr<MemorySystemTest> MemorySystemTest::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<MemorySystemTest>(new MemorySystemTest(context));
+        }
+
+        void MemorySystemTest::run()
+        {
+            _enums();
+            _operators();
+            _read();
+            _scale();
+            _system();
+        }
+
+        void MemorySystemTest::_enums()
+        {
+            _enum<Source>("Source", getSourceEnums);
+        }
+
+        void MemorySystemTest::_operators()
+        {
+            {
+                Info a;
+                Info b;
+                FTK_ASSERT(a == b);
+                b.used = 1;
+                FTK_ASSERT(a != b);
+            }
+            {
+                PressureOptions a;
+                PressureOptions b;
+                FTK_ASSERT(a == b);
+                b.scaleMin = 0.F;
+                FTK_ASSERT(a != b);
+            }
+        }
+
+        void MemorySystemTest::_read()
+        {
+            const std::filesystem::path dir("MemorySystemTest");
+            std::filesystem::create_directory(dir);
+            {
+                auto io = ftk::FileIO::create(dir / "memory.current", ftk::FileMode::Write);
+                io->write("1000\n");
+                io = ftk::FileIO::create(dir / "memory.max", ftk::FileMode::Write);
+                io->write("4000\n");
+                io = ftk::FileIO::create(dir / "memory.stat", ftk::FileMode::Write);
+                io->write("anon 600\nfile 400\nactive_file 200\ninactive_file 200\n");
+                io = ftk::FileIO::create(dir / "memory.pressure", ftk::FileMode::Write);
+                io->write(
+                    "some avg10=12.50 avg60=1.00 avg300=0.00 total=100\n"
+                    "full avg10=5.00 avg60=0.00 avg300=0.00 total=50\n");
+            }
+            Info info = readCGroup(dir);
+            FTK_ASSERT(Source::CGroup == info.source);
+            FTK_ASSERT(4000 == info.limit);
+            FTK_ASSERT(800 == info.used);
+            FTK_ASSERT(std::fabs(info.pressure - .125F) < .001F);
+
+            // Without a limit.
+            {
+                auto io = ftk::FileIO::create(dir / "memory.max", ftk::FileMode::Write);
+                io->write("max\n");
+            }
+            info = readCGroup(dir);
+            FTK_ASSERT(Source::CGroup == info.source);
+            FTK_ASSERT(0 == info.limit);
+
+            {
+                auto io = ftk::FileIO::create(dir / "meminfo", ftk::FileMode::Write);
+                io->write(
+                    "MemTotal:        1000 kB\n"
+                    "MemFree:          100 kB\n"
+                    "MemAvailable:     250 kB\n");
+            }
+            info = readMemInfo(dir / "meminfo", dir / "memory.pressure");
+            FTK_ASSERT(Source::MemInfo == info.source);
+            FTK_ASSERT(1000 * ftk::kilobyte == info.limit);
+            FTK_ASSERT(750 * ftk::kilobyte == info.used);
+            FTK_ASSERT(std::fabs(info.pressure - .125F) < .001F);
+
+            // Missing files.
+            info = readCGroup(dir / "missing");
+            FTK_ASSERT(Info() == info);
+            info = readMemInfo(dir / "missing", dir / "missing");
+            FTK_ASSERT(Info() == info);
+            FTK_ASSERT(0.F == readPressure(dir / "missing"));
+
+            std::filesystem::remove_all(dir);
+        }
+
+        void MemorySystemTest::_scale()
+        {
+            PressureOptions options;
+            options.usageLow = .5F;
+            options.usageHigh = 1.F;
+            options.pressureLow = .1F;
+            options.pressureHigh = .2F;
+            options.scaleMin = .2F;
+            Info info;
+            FTK_ASSERT(1.F == getScale(info, options));
+            info.limit = 100;
+            info.used = 50;
+            FTK_ASSERT(1.F == getScale(info, options));
+            info.used = 75;
+            FTK_ASSERT(std::fabs(getScale(info, options) - .6F) < .001F);
+            info.used = 100;
+            FTK_ASSERT(std::fabs(getScale(info, options) - .2F) < .001F);
+            info.used = 0;
+            info.pressure = .15F;
+            FTK_ASSERT(std::fabs(getScale(info, options) - .6F) < .001F);
+            info.pressure = 1.F;
+            FTK_ASSERT(std::fabs(getScale(info, options) - .2F) < .001F);
+        }
+
+        void MemorySystemTest::_system()
+        {
+            auto system = _context->getSystem<System>();
+            FTK_ASSERT(system);
+            _print(ftk::Format("Source: {0}").arg(to_string(system->getInfo().source)));
+            _print(ftk::Format("Limit: {0}MB").arg(system->getInfo().limit / ftk::megabyte));
+            _print(ftk::Format("Used: {0}MB").arg(system->getInfo().used / ftk::megabyte));
+            _print(ftk::Format("Pressure: {0}").arg(system->getInfo().pressure));
+            _print(ftk::Format("Scale: {0}").arg(system->getScale()));
+            const PressureOptions options = system->getOptions();
+
+            float scale = 0.F;
+            const int id = system->addCache(
+                [&scale](float value)
+                {
+                    scale = value;
+                });
+            FTK_ASSERT(system->getScale() == scale);
+
+            // The caches shrink immediately.
+            PressureOptions options2;
+            options2.usageLow = 0.F;
+            options2.usageHigh = 0.F;
+            options2.pressureLow = 0.F;
+            options2.pressureHigh = 0.F;
+            options2.scaleMin = .5F;
+            system->setOptions(options2);
+            FTK_ASSERT(options2 == system->getOptions());
+            FTK_ASSERT(std::fabs(system->getScale() - .5F) < .001F);
+            FTK_ASSERT(std::fabs(scale - .5F) < .001F);
+
+            // The caches grow back slowly.
+            options2.usageLow = 2.F;
+            options2.usageHigh = 2.F;
+            options2.pressureLow = 2.F;
+            options2.pressureHigh = 2.F;
+            options2.scaleGrow = .25F;
+            system->setOptions(options2);
+            FTK_ASSERT(std::fabs(scale - .75F) < .001F);
+            system->setOptions(options2);
+            FTK_ASSERT(std::fabs(scale - 1.F) < .001F);
+
+            system->removeCache(id);
+            system->setOptions(options);
+        }
+    }
+}
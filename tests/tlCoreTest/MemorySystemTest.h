@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace core_tests
+    {
+        class MemorySystemTest : public tests::ITest
+        {
+        protected:
+            MemorySystemTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<MemorySystemTest> create(const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _enums();
+            void _operators();
+            void _read();
+            void _scale();
+            void _system();
+        };
+    }
+}
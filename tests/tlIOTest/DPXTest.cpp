@@ -0,0 +1,265 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIOTest/DPXTest.h>
+
+#include <tlIO/DPX.h>
+#include <tlIO/System.h>
+
+#include <ftk/Core/Assert.h>
+#include <ftk/Core/FileIO.h>
+#include <ftk/Core/Memory.h>
+
+#include <cstring>
+#include <sstream>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        DPXTest::DPXTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "io_tests::DPXTest")
+        {}
+
+        std::shared_ptr<DPXTest> DPXTest::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<DPXTest>(new DPXTest(context));
+        }
+
+        void DPXTest::run()
+        {
+            _enums();
+            _util();
+            _io();
+        }
+
+        void DPXTest::_enums()
+        {
+            _enum<dpx::Packing>("Packing", dpx::getPackingEnums);
+        }
+
+        namespace
+        {
+            void setU32MSB(uint8_t* p, uint32_t value)
+            {
+                p[0] = (value >> 24) & 0xff;
+                p[1] = (value >> 16) & 0xff;
+                p[2] = (value >> 8) & 0xff;
+                p[3] = value & 0xff;
+            }
+
+            void setU16MSB(uint8_t* p, uint16_t value)
+            {
+                p[0] = (value >> 8) & 0xff;
+                p[1] = value & 0xff;
+            }
+
+            uint16_t to16(uint16_t value)
+            {
+                return (value << 6) | (value >> 4);
+            }
+        }
+
+        void DPXTest::_util()
+        {
+            // Use enough words to cover both the vectorized and scalar code.
+            const size_t wordCount = 11;
+            std::vector<uint16_t> components;
+            for (size_t i = 0; i < wordCount * 3; ++i)
+            {
+                components.push_back((i * 37) & 0x3ff);
+            }
+            for (const auto packing : { dpx::Packing::FilledA, dpx::Packing::FilledB })
+            {
+                const int shift = dpx::Packing::FilledA == packing ? 2 : 0;
+                std::vector<uint32_t> words;
+                std::vector<uint8_t> wordsMSB(wordCount * 4);
+                for (size_t i = 0; i < wordCount; ++i)
+                {
+                    const uint32_t w =
+                        (components[i * 3] << (20 + shift)) |
+                        (components[i * 3 + 1] << (10 + shift)) |
+                        (components[i * 3 + 2] << shift);
+                    words.push_back(w);
+                    setU32MSB(wordsMSB.data() + i * 4, w);
+                }
+                for (const size_t componentCount : { components.size(), components.size() - 2 })
+                {
+                    std::vector<uint16_t> out(componentCount, 0);
+                    dpx::unpack10(
+                        reinterpret_cast<const uint8_t*>(words.data()),
+                        out.data(),
+                        componentCount,
+                        packing,
+                        false);
+                    for (size_t i = 0; i < componentCount; ++i)
+                    {
+                        FTK_ASSERT(to16(components[i]) == out[i]);
+                    }
+                    const bool swap = ftk::getEndian() != ftk::Endian::MSB;
+                    std::vector<uint16_t> outMSB(componentCount, 0);
+                    dpx::unpack10(
+                        swap ? wordsMSB.data() : reinterpret_cast<const uint8_t*>(words.data()),
+                        outMSB.data(),
+                        componentCount,
+                        packing,
+                        swap);
+                    FTK_ASSERT(out == outMSB);
+                }
+                {
+                    std::vector<uint32_t> out(wordCount, 0);
+                    dpx::copy10(
+                        reinterpret_cast<const uint8_t*>(words.data()),
+                        reinterpret_cast<uint8_t*>(out.data()),
+                        wordCount,
+                        packing,
+                        false);
+                    for (size_t i = 0; i < wordCount; ++i)
+                    {
+                        FTK_ASSERT(((out[i] >> 22) & 0x3ff) == components[i * 3]);
+                        FTK_ASSERT(((out[i] >> 12) & 0x3ff) == components[i * 3 + 1]);
+                        FTK_ASSERT(((out[i] >> 2) & 0x3ff) == components[i * 3 + 2]);
+                    }
+                }
+            }
+            {
+                std::vector<uint32_t> words((components.size() * 10 + 31) / 32, 0);
+                size_t bit = 0;
+                for (const auto c : components)
+                {
+                    for (int i = 9; i >= 0; --i, ++bit)
+                    {
+                        if ((c >> i) & 1)
+                        {
+                            words[bit / 32] |= 1U << (31 - bit % 32);
+                        }
+                    }
+                }
+                std::vector<uint16_t> out(components.size(), 0);
+                dpx::unpack10Packed(
+                    reinterpret_cast<const uint8_t*>(words.data()),
+                    out.data(),
+                    out.size(),
+                    false);
+                for (size_t i = 0; i < components.size(); ++i)
+                {
+                    FTK_ASSERT(to16(components[i]) == out[i]);
+                }
+            }
+        }
+
+        namespace
+        {
+            void writeDPX(
+                const std::string& fileName,
+                const ftk::Size2I& size,
+                const std::vector<uint16_t>& components)
+            {
+                const size_t dataOffset = 2048;
+                std::vector<uint8_t> data(dataOffset + size.w * size.h * 4, 0);
+                uint8_t* p = data.data();
+                std::memcpy(p, "SDPX", 4);
+                setU32MSB(p + 4, dataOffset);
+                std::memcpy(p + 8, "V2.0", 4);
+                setU32MSB(p + 16, data.size());
+                std::memcpy(p + 160, "DPXTest", 7);
+                setU16MSB(p + 768, 0);
+                setU16MSB(p + 770, 1);
+                setU32MSB(p + 772, size.w);
+                setU32MSB(p + 776, size.h);
+                p[800] = 50;
+                p[803] = 10;
+                setU16MSB(p + 804, 1);
+                setU16MSB(p + 806, 0);
+                setU32MSB(p + 808, dataOffset);
+                setU32MSB(p + 812, 0);
+                setU32MSB(p + 1628, 1);
+                setU32MSB(p + 1632, 1);
+                setU32MSB(p + 1920, 0x01020304);
+                for (int i = 0; i < size.w * size.h; ++i)
+                {
+                    setU32MSB(
+                        p + dataOffset + i * 4,
+                        (components[i * 3] << 22) |
+                        (components[i * 3 + 1] << 12) |
+                        (components[i * 3 + 2] << 2));
+                }
+                auto fileIO = ftk::FileIO::create(fileName, ftk::FileMode::Write);
+                fileIO->write(data.data(), data.size());
+            }
+        }
+
+        void DPXTest::_io()
+        {
+            auto readSystem = _context->getSystem<ReadSystem>();
+            auto readPlugin = readSystem->getPlugin<dpx::ReadPlugin>();
+
+            const ftk::Size2I size(17, 5);
+            std::vector<uint16_t> components;
+            for (int i = 0; i < size.w * size.h * 3; ++i)
+            {
+                components.push_back((i * 13) & 0x3ff);
+            }
+            const file::Path path("DPXTest.0.dpx");
+            writeDPX(path.get(), size, components);
+
+            for (const bool memoryIO : { false, true })
+            {
+                for (const bool passthrough : { false, true })
+                {
+                    try
+                    {
+                        std::vector<uint8_t> memoryData;
+                        std::vector<ftk::InMemoryFile> memory;
+                        if (memoryIO)
+                        {
+                            auto fileIO = ftk::FileIO::create(path.get(), ftk::FileMode::Read);
+                            memoryData.resize(fileIO->getSize());
+                            fileIO->read(memoryData.data(), memoryData.size());
+                            memory.push_back(ftk::InMemoryFile(memoryData.data(), memoryData.size()));
+                        }
+                        Options options;
+                        options["DPX/Passthrough"] = passthrough ? "1" : "0";
+                        auto read = readPlugin->read(path, memory, options);
+                        const auto ioInfo = read->getInfo().get();
+                        FTK_ASSERT(!ioInfo.video.empty());
+                        FTK_ASSERT(size == ioInfo.video[0].size);
+                        FTK_ASSERT(ioInfo.video[0].type == (passthrough ?
+                            ftk::ImageType::RGB_U10 :
+                            ftk::ImageType::RGB_U16));
+                        const auto i = ioInfo.tags.find("Time Code");
+                        FTK_ASSERT(i != ioInfo.tags.end() && "01:02:03:04" == i->second);
+
+                        const auto videoData = read->readVideo(OTIO_NS::RationalTime(0.0, 24.0)).get();
+                        FTK_ASSERT(videoData.image);
+                        FTK_ASSERT(videoData.image->getSize() == size);
+                        if (passthrough)
+                        {
+                            const uint32_t* data = reinterpret_cast<const uint32_t*>(videoData.image->getData());
+                            for (int j = 0; j < size.w * size.h; ++j)
+                            {
+                                FTK_ASSERT(((data[j] >> 22) & 0x3ff) == components[j * 3]);
+                                FTK_ASSERT(((data[j] >> 12) & 0x3ff) == components[j * 3 + 1]);
+                                FTK_ASSERT(((data[j] >> 2) & 0x3ff) == components[j * 3 + 2]);
+                            }
+                        }
+                        else
+                        {
+                            const uint16_t* data = reinterpret_cast<const uint16_t*>(videoData.image->getData());
+                            for (size_t j = 0; j < components.size(); ++j)
+                            {
+                                FTK_ASSERT(to16(components[j]) == data[j]);
+                            }
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _printError(e.what());
+                    }
+                }
+            }
+        }
+    }
+}
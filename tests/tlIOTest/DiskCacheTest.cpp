@@ -0,0 +1,254 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIOTest/DiskCacheTest.h>
+
+#include <tlIO/DiskCache.h>
+
+#include <ftk/Core/Assert.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Memory.h>
+
+#include <cstring>
+#include <fstream>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        DiskCacheTest::DiskCacheTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "io_tests::DiskCacheTest")
+        {}
+
+        std::shared_ptr<DiskCacheTest> DiskCacheTest::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<DiskCacheTest>(new DiskCacheTest(context));
+        }
+
+        void DiskCacheTest::run()
+        {
+            _options();
+            _keys();
+            _cache();
+        }
+
+        void DiskCacheTest::_options()
+        {
+            {
+                DiskCacheOptions a;
+                DiskCacheOptions b;
+                FTK_ASSERT(a == b);
+                b.path = "DiskCacheTest";
+                FTK_ASSERT(a != b);
+            }
+            {
+                DiskCacheOptions v;
+                v.path = "DiskCacheTest";
+                v.gb = 2.F;
+                nlohmann::json json;
+                to_json(json, v);
+                DiskCacheOptions v2;
+                from_json(json, v2);
+                FTK_ASSERT(v == v2);
+            }
+        }
+
+        void DiskCacheTest::_keys()
+        {
+            auto system = _context->getSystem<DiskCacheSystem>();
+            const std::filesystem::path dir("DiskCacheTest");
+            const std::filesystem::path media("DiskCacheTest.bin");
+            try
+            {
+                // The media key is empty when the cache is disabled.
+                {
+                    std::ofstream f(media);
+                    f << "DiskCacheTest";
+                }
+                FTK_ASSERT(system->getMediaKey(file::Path(media.u8string())).empty());
+
+                DiskCacheOptions options;
+                options.path = dir.u8string();
+                options.gb = 1.F;
+                system->setOptions(options);
+                const std::string mediaKey = system->getMediaKey(file::Path(media.u8string()));
+                FTK_ASSERT(!mediaKey.empty());
+                FTK_ASSERT(system->getMediaKey(file::Path("DiskCacheTest.missing")).empty());
+
+                // The media key changes when the file changes.
+                {
+                    std::ofstream f(media, std::ios::app);
+                    f << "DiskCacheTest";
+                }
+                system->setOptions(DiskCacheOptions());
+                system->setOptions(options);
+                FTK_ASSERT(system->getMediaKey(file::Path(media.u8string())) != mediaKey);
+
+                // The frame keys are different for each time and option.
+                const OTIO_NS::RationalTime time(1.0, 24.0);
+                Options ioOptions;
+                const std::string frameKey = DiskCacheSystem::getFrameKey(mediaKey, time, ioOptions);
+                FTK_ASSERT(frameKey == DiskCacheSystem::getFrameKey(mediaKey, time, ioOptions));
+                FTK_ASSERT(frameKey != DiskCacheSystem::getFrameKey(
+                    mediaKey,
+                    OTIO_NS::RationalTime(1.0 + 1.0 / 1000.0, 24.0),
+                    ioOptions));
+                ioOptions["Layer"] = "1";
+                FTK_ASSERT(frameKey != DiskCacheSystem::getFrameKey(mediaKey, time, ioOptions));
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            system->setOptions(DiskCacheOptions());
+            std::filesystem::remove(media);
+            std::filesystem::remove_all(dir);
+        }
+
+        void DiskCacheTest::_cache()
+        {
+            auto system = _context->getSystem<DiskCacheSystem>();
+            const std::filesystem::path dir("DiskCacheTest");
+            try
+            {
+                DiskCacheOptions options;
+                options.path = dir.u8string();
+                options.gb = 1.F;
+                system->setOptions(options);
+                FTK_ASSERT(0 == system->getSize());
+
+                // Write some frames.
+                const ftk::ImageInfo imageInfo(ftk::Size2I(64, 32), ftk::ImageType::RGBA_U16);
+                const std::string mediaKey = "DiskCacheTest";
+                const double speed = 24.0;
+                const int frameCount = 4;
+                std::vector<std::string> frameKeys;
+                for (int i = 0; i < frameCount; ++i)
+                {
+                    const OTIO_NS::RationalTime time(i, speed);
+                    frameKeys.push_back(DiskCacheSystem::getFrameKey(mediaKey, time, Options()));
+                    auto image = ftk::Image::create(imageInfo);
+                    std::memset(image->getData(), i + 1, imageInfo.getByteCount());
+                    image->setTags({ { "Frame", std::to_string(i) } });
+                    FTK_ASSERT(!system->canRead(mediaKey, frameKeys.back()));
+                    system->write(mediaKey, frameKeys.back(), VideoData(time, 1, image));
+                }
+                system->wait();
+                FTK_ASSERT(frameCount == system->getSize());
+                FTK_ASSERT(system->getByteCount() > 0);
+                FTK_ASSERT(system->getByteCount() < frameCount * imageInfo.getByteCount());
+
+                // Read the frames.
+                for (int i = 0; i < frameCount; ++i)
+                {
+                    const OTIO_NS::RationalTime time(i, speed);
+                    FTK_ASSERT(system->canRead(mediaKey, frameKeys[i]));
+                    VideoData videoData;
+                    FTK_ASSERT(system->read(mediaKey, frameKeys[i], time, videoData));
+                    FTK_ASSERT(time == videoData.time);
+                    FTK_ASSERT(1 == videoData.layer);
+                    FTK_ASSERT(videoData.image);
+                    FTK_ASSERT(imageInfo == videoData.image->getInfo());
+                    FTK_ASSERT(std::to_string(i) == videoData.image->getTags().at("Frame"));
+                    FTK_ASSERT(i + 1 == videoData.image->getData()[0]);
+                    FTK_ASSERT(i + 1 == videoData.image->getData()[imageInfo.getByteCount() - 1]);
+                }
+                VideoData videoData;
+                FTK_ASSERT(!system->read(
+                    mediaKey,
+                    DiskCacheSystem::getFrameKey(mediaKey, OTIO_NS::RationalTime(frameCount, speed), Options()),
+                    OTIO_NS::RationalTime(frameCount, speed),
+                    videoData));
+
+                // Read the frames on the read threads.
+                {
+                    const OTIO_NS::RationalTime time(1, speed);
+                    auto future = system->readRequest(mediaKey, frameKeys[1], time);
+                    const VideoData videoData = future.get();
+                    FTK_ASSERT(time == videoData.time);
+                    FTK_ASSERT(videoData.image);
+                    FTK_ASSERT(std::to_string(1) == videoData.image->getTags().at("Frame"));
+                }
+                {
+                    const OTIO_NS::RationalTime time(frameCount, speed);
+                    auto future = system->readRequest(
+                        mediaKey,
+                        DiskCacheSystem::getFrameKey(mediaKey, time, Options()),
+                        time);
+                    const VideoData videoData = future.get();
+                    FTK_ASSERT(time == videoData.time);
+                    FTK_ASSERT(!videoData.image);
+                }
+
+                // Truncated files are not read, and are removed from the
+                // cache.
+                {
+                    std::filesystem::path path;
+                    for (const auto& i : std::filesystem::directory_iterator(dir))
+                    {
+                        path = i.path();
+                    }
+                    const auto size = std::filesystem::file_size(path);
+                    std::filesystem::resize_file(path, size / 2);
+                    std::vector<int> invalid;
+                    for (int i = 0; i < frameCount; ++i)
+                    {
+                        VideoData videoData;
+                        if (!system->read(mediaKey, frameKeys[i], OTIO_NS::RationalTime(i, speed), videoData))
+                        {
+                            invalid.push_back(i);
+                        }
+                    }
+                    FTK_ASSERT(1 == invalid.size());
+                    FTK_ASSERT(frameCount - 1 == system->getSize());
+                    system->write(
+                        mediaKey,
+                        frameKeys[invalid[0]],
+                        VideoData(OTIO_NS::RationalTime(invalid[0], speed), 1, ftk::Image::create(imageInfo)));
+                    system->wait();
+                    FTK_ASSERT(frameCount == system->getSize());
+                }
+
+                // Frames are not read when decoding is faster.
+                system->addDecodeTime(mediaKey, 0.000000001F);
+                size_t count = 0;
+                for (int i = 0; i < 100; ++i)
+                {
+                    if (system->canRead(mediaKey, frameKeys[0]))
+                    {
+                        ++count;
+                    }
+                }
+                FTK_ASSERT(count > 0 && count < 10);
+
+                // The frames persist between sessions.
+                system->setOptions(DiskCacheOptions());
+                FTK_ASSERT(0 == system->getSize());
+                system->setOptions(options);
+                FTK_ASSERT(frameCount == system->getSize());
+
+                // The least recently used frames are removed when the cache
+                // is larger than the maximum size.
+                const size_t byteCount = system->getByteCount();
+                options.gb = (byteCount / 2) / static_cast<float>(ftk::gigabyte);
+                system->setOptions(options);
+                FTK_ASSERT(system->getSize() > 0);
+                FTK_ASSERT(system->getSize() < frameCount);
+                FTK_ASSERT(system->getByteCount() <= byteCount / 2);
+
+                system->clear();
+                FTK_ASSERT(0 == system->getSize());
+                FTK_ASSERT(0 == system->getByteCount());
+                FTK_ASSERT(std::filesystem::is_empty(dir));
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            system->setOptions(DiskCacheOptions());
+            std::filesystem::remove_all(dir);
+        }
+    }
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        class DiskCacheTest : public tests::ITest
+        {
+        protected:
+            DiskCacheTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<DiskCacheTest> create(const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _options();
+            void _keys();
+            void _cache();
+        };
+    }
+}
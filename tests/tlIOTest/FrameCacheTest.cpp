@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIOTest/FrameCacheTest.h>
+
+#include <tlIO/FrameCache.h>
+#include <tlIO/System.h>
+
+#include <ftk/Core/Assert.h>
+#include <ftk/Core/FileIO.h>
+
+#include <cstring>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        FrameCacheTest::FrameCacheTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "io_tests::FrameCacheTest")
+        {}
+
+        std::shared_ptr<FrameCacheTest> FrameCacheTest::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<FrameCacheTest>(new FrameCacheTest(context));
+        }
+
+        void FrameCacheTest::run()
+        {
+            _io();
+        }
+
+        void FrameCacheTest::_io()
+        {
+            auto readSystem = _context->getSystem<ReadSystem>();
+            auto readPlugin = readSystem->getPlugin<framecache::ReadPlugin>();
+            auto writeSystem = _context->getSystem<WriteSystem>();
+            auto writePlugin = writeSystem->getPlugin<framecache::WritePlugin>();
+
+            const ftk::ImageInfo imageInfo(ftk::Size2I(17, 5), ftk::ImageType::RGBA_F16);
+            const audio::Info audioInfo(2, audio::DataType::F32, 48000);
+            const double speed = 24.0;
+            const int frameCount = 3;
+            const size_t samplesPerFrame = static_cast<size_t>(audioInfo.sampleRate / speed);
+            const file::Path path("FrameCacheTest.tlfc");
+            try
+            {
+                Info info;
+                info.video.push_back(imageInfo);
+                info.videoTime = OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(10.0, speed),
+                    OTIO_NS::RationalTime(frameCount, speed));
+                info.audio = audioInfo;
+                info.tags["Description"] = "FrameCacheTest";
+                {
+                    auto write = writePlugin->write(path, info);
+                    auto audio = audio::Audio::create(audioInfo, samplesPerFrame * frameCount);
+                    float* audioP = reinterpret_cast<float*>(audio->getData());
+                    for (size_t i = 0; i < samplesPerFrame * frameCount * audioInfo.channelCount; ++i)
+                    {
+                        audioP[i] = i / static_cast<float>(samplesPerFrame * frameCount * audioInfo.channelCount);
+                    }
+                    write->writeAudio(
+                        OTIO_NS::TimeRange(
+                            OTIO_NS::RationalTime(0.0, audioInfo.sampleRate),
+                            OTIO_NS::RationalTime(audio->getSampleCount(), audioInfo.sampleRate)),
+                        audio);
+                    for (int i = 0; i < frameCount; ++i)
+                    {
+                        auto image = ftk::Image::create(imageInfo);
+                        std::memset(image->getData(), i + 1, imageInfo.getByteCount());
+                        write->writeVideo(OTIO_NS::RationalTime(i, speed), image);
+                    }
+                    FTK_ASSERT(write->hasAudio());
+                    write->finish();
+                }
+
+                auto read = readPlugin->read(path);
+                const auto ioInfo = read->getInfo().get();
+                FTK_ASSERT(1 == ioInfo.video.size());
+                FTK_ASSERT(imageInfo.size == ioInfo.video[0].size);
+                FTK_ASSERT(imageInfo.type == ioInfo.video[0].type);
+                FTK_ASSERT(info.videoTime == ioInfo.videoTime);
+                FTK_ASSERT(audioInfo.channelCount == ioInfo.audio.channelCount);
+                FTK_ASSERT(audioInfo.dataType == ioInfo.audio.dataType);
+                FTK_ASSERT(audioInfo.sampleRate == ioInfo.audio.sampleRate);
+                FTK_ASSERT(samplesPerFrame * frameCount == ioInfo.audioTime.duration().value());
+                const auto i = ioInfo.tags.find("Description");
+                FTK_ASSERT(i != ioInfo.tags.end() && "FrameCacheTest" == i->second);
+
+                for (int j = 0; j < frameCount; ++j)
+                {
+                    const auto videoData = read->readVideo(OTIO_NS::RationalTime(10.0 + j, speed)).get();
+                    FTK_ASSERT(videoData.image);
+                    FTK_ASSERT(videoData.image->getSize() == imageInfo.size);
+                    const uint8_t* data = videoData.image->getData();
+                    for (size_t k = 0; k < imageInfo.getByteCount(); ++k)
+                    {
+                        FTK_ASSERT(j + 1 == data[k]);
+                    }
+                }
+                const auto videoData = read->readVideo(OTIO_NS::RationalTime(10.0 + frameCount, speed)).get();
+                FTK_ASSERT(!videoData.image);
+
+                // Cancel the requests, the pending requests return without
+                // an image.
+                std::vector<std::future<VideoData> > futures;
+                for (int j = 0; j < 100; ++j)
+                {
+                    futures.push_back(read->readVideo(OTIO_NS::RationalTime(10.0 + j % frameCount, speed)));
+                }
+                read->cancelRequests();
+                for (int j = 0; j < 100; ++j)
+                {
+                    FTK_ASSERT(OTIO_NS::RationalTime(10.0 + j % frameCount, speed) == futures[j].get().time);
+                }
+
+                // Read audio that spans a frame boundary and the end of the
+                // file.
+                const OTIO_NS::TimeRange audioRange(
+                    ioInfo.audioTime.start_time() + OTIO_NS::RationalTime(samplesPerFrame / 2, audioInfo.sampleRate),
+                    OTIO_NS::RationalTime(samplesPerFrame * frameCount, audioInfo.sampleRate));
+                const auto audioData = read->readAudio(audioRange).get();
+                FTK_ASSERT(audioData.audio);
+                FTK_ASSERT(audioData.audio->getSampleCount() == samplesPerFrame * frameCount);
+                const float* audioP = reinterpret_cast<const float*>(audioData.audio->getData());
+                const size_t valueCount = samplesPerFrame * frameCount * audioInfo.channelCount;
+                for (size_t j = 0; j < valueCount; ++j)
+                {
+                    const size_t k = j + samplesPerFrame / 2 * audioInfo.channelCount;
+                    FTK_ASSERT(audioP[j] == (k < valueCount ? k / static_cast<float>(valueCount) : 0.F));
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+            try
+            {
+                // A file that is not finished does not have a trailer and
+                // is rejected by the reader.
+                Info info;
+                info.video.push_back(imageInfo);
+                info.videoTime = OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(0.0, speed),
+                    OTIO_NS::RationalTime(1.0, speed));
+                {
+                    auto write = writePlugin->write(path, info);
+                    FTK_ASSERT(!write->hasAudio());
+                    write->writeVideo(OTIO_NS::RationalTime(0.0, speed), ftk::Image::create(imageInfo));
+                }
+                auto read = readPlugin->read(path);
+                FTK_ASSERT(read->getInfo().get().video.empty());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+    }
+}
@@ -0,0 +1,26 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        class FrameCacheTest : public tests::ITest
+        {
+        protected:
+            FrameCacheTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<FrameCacheTest> create(const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _io();
+        };
+    }
+}
@@ -29,6 +29,7 @@ namespace tl
         {
             _videoData();
             _ioSystem();
+            _readPool();
         }
 
         void IOTest::_videoData()
@@ -137,5 +138,78 @@ namespace tl
             auto writeSystem = _context->getSystem<WriteSystem>();
             FTK_ASSERT(!writeSystem->write(file::Path(), Info()));
         }
+
+        void IOTest::_readPool()
+        {
+            auto readSystem = _context->getSystem<ReadSystem>();
+            const size_t readMax = readSystem->getReadMax();
+            readSystem->clearReads();
+            const size_t readCount = readSystem->getReadCount();
+
+            // Create in-memory files that the readers can open.
+            std::vector<std::vector<uint8_t> > data;
+            std::vector<std::vector<ftk::InMemoryFile> > memory;
+            for (size_t i = 0; i < 3; ++i)
+            {
+                const std::string header = "YUV4MPEG2 W2 H2 F24:1 C420jpeg\nFRAME\n";
+                data.push_back(std::vector<uint8_t>(header.begin(), header.end()));
+                data.back().resize(data.back().size() + 2 * 2 + 1 * 1 * 2);
+            }
+            for (const auto& i : data)
+            {
+                memory.push_back({ ftk::InMemoryFile(i.data(), i.size()) });
+            }
+
+            // Consumers with the same path, memory, and options share readers.
+            const file::Path path("IOTest.y4m");
+            auto read0 = readSystem->getRead(path, memory[0]);
+            FTK_ASSERT(read0);
+            FTK_ASSERT(read0 == readSystem->getRead(path, memory[0]));
+            Options options;
+            options["Layer"] = "1";
+            auto read1 = readSystem->getRead(path, memory[0], options);
+            FTK_ASSERT(read1);
+            FTK_ASSERT(read0 != read1);
+            auto read2 = readSystem->getRead(path, memory[1]);
+            FTK_ASSERT(read0 != read2);
+            FTK_ASSERT(readCount + 3 == readSystem->getReadCount());
+
+            // Readers that are held by consumers are not closed.
+            readSystem->setReadMax(readCount + 1);
+            FTK_ASSERT(readCount + 3 == readSystem->getReadCount());
+            read1.reset();
+            read2.reset();
+            readSystem->setReadMax(readCount + 1);
+            FTK_ASSERT(readCount + 1 == readSystem->getReadCount());
+            auto read3 = readSystem->getRead(path, memory[2]);
+            FTK_ASSERT(readCount + 2 == readSystem->getReadCount());
+            FTK_ASSERT(read0 == readSystem->getRead(path, memory[0]));
+
+            // The least recently used idle reader is closed first.
+            std::weak_ptr<IRead> weak0 = read0;
+            std::weak_ptr<IRead> weak3 = read3;
+            read0.reset();
+            read3.reset();
+            readSystem->setReadMax(readCount + 2);
+            FTK_ASSERT(readCount + 2 == readSystem->getReadCount());
+            FTK_ASSERT(readSystem->getRead(path, memory[0]) == weak0.lock());
+            auto read4 = readSystem->getRead(path, memory[1]);
+            FTK_ASSERT(readCount + 2 == readSystem->getReadCount());
+            FTK_ASSERT(!weak0.expired());
+            FTK_ASSERT(weak3.expired());
+
+            // Readers that become idle are closed by the next request.
+            read0 = readSystem->getRead(path, memory[0]);
+            readSystem->setReadMax(readCount + 1);
+            FTK_ASSERT(readCount + 2 == readSystem->getReadCount());
+            read4.reset();
+            FTK_ASSERT(read0 == readSystem->getRead(path, memory[0]));
+            FTK_ASSERT(readCount + 1 == readSystem->getReadCount());
+            read0.reset();
+
+            readSystem->clearReads();
+            FTK_ASSERT(readCount == readSystem->getReadCount());
+            readSystem->setReadMax(readMax);
+        }
     }
 }
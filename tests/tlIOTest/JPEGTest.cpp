@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIOTest/JPEGTest.h>
+
+#include <tlIO/JPEG.h>
+#include <tlIO/System.h>
+
+#include <ftk/Core/Assert.h>
+#include <ftk/Core/FileIO.h>
+#include <ftk/Core/Format.h>
+
+#include <sstream>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        JPEGTest::JPEGTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "io_tests::JPEGTest")
+        {}
+
+        std::shared_ptr<JPEGTest> JPEGTest::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<JPEGTest>(new JPEGTest(context));
+        }
+
+        void JPEGTest::run()
+        {
+            _io();
+        }
+
+        void JPEGTest::_io()
+        {
+            auto readSystem = _context->getSystem<ReadSystem>();
+            auto readPlugin = readSystem->getPlugin<jpeg::ReadPlugin>();
+            FTK_ASSERT(readPlugin);
+
+            const file::Path path(TLRENDER_SAMPLE_DATA, "Seq/BART_2021-02-07.0001.jpg");
+            const std::vector<std::pair<int, ftk::Size2I> > proxies =
+            {
+                { 1, ftk::Size2I(320, 180) },
+                { 2, ftk::Size2I(160, 90) },
+                { 4, ftk::Size2I(80, 45) },
+                { 8, ftk::Size2I(40, 23) }
+            };
+            for (const bool memoryIO : { false, true })
+            {
+                for (const auto& proxy : proxies)
+                {
+                    std::stringstream ss;
+                    ss << "Proxy: " << proxy.first << " memory: " << memoryIO;
+                    _print(ss.str());
+                    try
+                    {
+                        std::vector<uint8_t> memoryData;
+                        std::vector<ftk::InMemoryFile> memory;
+                        if (memoryIO)
+                        {
+                            auto fileIO = ftk::FileIO::create(path.get(), ftk::FileMode::Read);
+                            memoryData.resize(fileIO->getSize());
+                            fileIO->read(memoryData.data(), memoryData.size());
+                            memory.push_back(ftk::InMemoryFile(memoryData.data(), memoryData.size()));
+                        }
+                        Options options;
+                        options["Proxy"] = ftk::Format("{0}").arg(proxy.first);
+                        auto read = readPlugin->read(path, memory, options);
+                        const auto ioInfo = read->getInfo().get();
+                        FTK_ASSERT(!ioInfo.video.empty());
+                        FTK_ASSERT(proxy.second == ioInfo.video[0].size);
+                        FTK_ASSERT(ftk::ImageType::RGB_U8 == ioInfo.video[0].type);
+                        FTK_ASSERT(ioInfo.videoProxy);
+                        const auto videoData = read->readVideo(ioInfo.videoTime.start_time()).get();
+                        FTK_ASSERT(videoData.image);
+                        FTK_ASSERT(proxy.second == videoData.image->getSize());
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _printError(e.what());
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlIOTest/YUVTest.h>
+
+#include <tlIO/System.h>
+#include <tlIO/YUV.h>
+
+#include <ftk/Core/Assert.h>
+#include <ftk/Core/FileIO.h>
+
+#include <cstring>
+
+using namespace tl::io;
+
+namespace tl
+{
+    namespace io_tests
+    {
+        YUVTest::YUVTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "io_tests::YUVTest")
+        {}
+
+        std::shared_ptr<YUVTest> YUVTest::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<YUVTest>(new YUVTest(context));
+        }
+
+        void YUVTest::run()
+        {
+            _enums();
+            _y4m();
+            _raw();
+        }
+
+        void YUVTest::_enums()
+        {
+            _enum<yuv::Format>("Format", yuv::getFormatEnums);
+        }
+
+        void YUVTest::_y4m()
+        {
+            auto readSystem = _context->getSystem<ReadSystem>();
+            auto plugin = readSystem->getPlugin<yuv::ReadPlugin>();
+
+            // Odd sized 4:2:0 frames, the chroma planes are rounded up in
+            // the file and cropped in the image. The frame headers have
+            // different sizes.
+            const ftk::Size2I size(5, 3);
+            const int frameCount = 3;
+            const size_t lumaByteCount = size.w * size.h;
+            const size_t chromaByteCount = 3 * 2;
+            std::string data = "YUV4MPEG2 W5 H3 F25:1 Ip A1:1 C420jpeg XYSCSS=420JPEG\n";
+            for (int i = 0; i < frameCount; ++i)
+            {
+                data += 1 == i ? "FRAME Ip XCOMMENT=1\n" : "FRAME\n";
+                for (size_t j = 0; j < lumaByteCount + chromaByteCount * 2; ++j)
+                {
+                    data.push_back(static_cast<char>(i * 50 + j));
+                }
+            }
+            const file::Path path("YUVTest.y4m");
+            {
+                auto fileIO = ftk::FileIO::create(path.get(), ftk::FileMode::Write);
+                fileIO->write(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+            }
+            try
+            {
+                auto read = plugin->read(path);
+                const auto ioInfo = read->getInfo().get();
+                FTK_ASSERT(!ioInfo.video.empty());
+                FTK_ASSERT(size == ioInfo.video[0].size);
+                FTK_ASSERT(ftk::ImageType::YUV_420P_U8 == ioInfo.video[0].type);
+                FTK_ASSERT(OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(0.0, 25.0),
+                    OTIO_NS::RationalTime(frameCount, 25.0)) == ioInfo.videoTime);
+
+                for (int i = 0; i < frameCount; ++i)
+                {
+                    const auto videoData = read->readVideo(OTIO_NS::RationalTime(i, 25.0)).get();
+                    FTK_ASSERT(videoData.image);
+                    const uint8_t* p = videoData.image->getData();
+                    for (size_t j = 0; j < lumaByteCount; ++j)
+                    {
+                        FTK_ASSERT(static_cast<uint8_t>(i * 50 + j) == p[j]);
+                    }
+                    p += lumaByteCount;
+                    for (size_t plane = 0; plane < 2; ++plane)
+                    {
+                        for (size_t x = 0; x < 2; ++x)
+                        {
+                            const size_t j = lumaByteCount + plane * chromaByteCount + x;
+                            FTK_ASSERT(static_cast<uint8_t>(i * 50 + j) == p[plane * 2 + x]);
+                        }
+                    }
+                }
+                const auto videoData = read->readVideo(OTIO_NS::RationalTime(frameCount, 25.0)).get();
+                FTK_ASSERT(!videoData.image);
+
+                // Cancel the requests, the pending requests return without
+                // an image.
+                std::vector<std::future<VideoData> > futures;
+                for (int i = 0; i < 100; ++i)
+                {
+                    futures.push_back(read->readVideo(OTIO_NS::RationalTime(i % frameCount, 25.0)));
+                }
+                read->cancelRequests();
+                for (int i = 0; i < 100; ++i)
+                {
+                    FTK_ASSERT(OTIO_NS::RationalTime(i % frameCount, 25.0) == futures[i].get().time);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
+        void YUVTest::_raw()
+        {
+            auto readSystem = _context->getSystem<ReadSystem>();
+            auto plugin = readSystem->getPlugin<yuv::ReadPlugin>();
+
+            // 10-bit 4:4:4 frames, the samples are expanded to 16 bits.
+            yuv::Options options;
+            options.width = 4;
+            options.height = 2;
+            options.format = yuv::Format::YUV444;
+            options.bitDepth = 10;
+            options.speed = 30.0;
+            const size_t sampleCount = options.width * options.height * 3;
+            std::vector<uint8_t> data;
+            for (size_t i = 0; i < sampleCount; ++i)
+            {
+                const uint16_t v = (i * 41) & 0x3ff;
+                data.push_back(v & 0xff);
+                data.push_back(v >> 8);
+            }
+            const file::Path path("YUVTest.yuv");
+            {
+                auto fileIO = ftk::FileIO::create(path.get(), ftk::FileMode::Write);
+                fileIO->write(data.data(), data.size());
+            }
+            try
+            {
+                {
+                    auto read = plugin->read(path);
+                    const auto ioInfo = read->getInfo().get();
+                    FTK_ASSERT(ioInfo.video.empty());
+                }
+
+                auto read = plugin->read(path, yuv::getOptions(options));
+                const auto ioInfo = read->getInfo().get();
+                FTK_ASSERT(!ioInfo.video.empty());
+                FTK_ASSERT(ftk::Size2I(options.width, options.height) == ioInfo.video[0].size);
+                FTK_ASSERT(ftk::ImageType::YUV_444P_U16 == ioInfo.video[0].type);
+                FTK_ASSERT(1 == ioInfo.videoTime.duration().value());
+                FTK_ASSERT(30.0 == ioInfo.videoTime.duration().rate());
+
+                const auto videoData = read->readVideo(OTIO_NS::RationalTime(0.0, 30.0)).get();
+                FTK_ASSERT(videoData.image);
+                const uint16_t* p = reinterpret_cast<const uint16_t*>(videoData.image->getData());
+                for (size_t i = 0; i < sampleCount; ++i)
+                {
+                    const uint16_t v = (i * 41) & 0x3ff;
+                    FTK_ASSERT(static_cast<uint16_t>((v << 6) | (v >> 4)) == p[i]);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+    }
+}
@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#pragma once
+
+#include <tlTestLib/ITest.h>
+
+namespace tl
+{
+    namespace io_tests
+    {
+        class YUVTest : public tests::ITest
+        {
+        protected:
+            YUVTest(const std::shared_ptr<ftk::Context>&);
+
+        public:
+            static std::shared_ptr<YUVTest> create(const std::shared_ptr<ftk::Context>&);
+
+            void run() override;
+
+        private:
+            void _enums();
+            void _y4m();
+            void _raw();
+        };
+    }
+}
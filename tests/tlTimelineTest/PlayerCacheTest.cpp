@@ -0,0 +1,426 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the tlRender project.
+
+#include <tlTimelineTest/PlayerCacheTest.h>
+
+#include <tlTimeline/PlayerCache.h>
+#include <tlTimeline/Util.h>
+
+#include <tlCore/MemorySystem.h>
+
+#include <ftk/Core/Assert.h>
+#include <ftk/Core/Context.h>
+#include <ftk/Core/Format.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+using namespace tl::timeline;
+
+namespace tl
+{
+    namespace timeline_tests
+    {
+        PlayerCacheTest::PlayerCacheTest(const std::shared_ptr<ftk::Context>& context) :
+            ITest(context, "timeline_tests::PlayerCacheTest")
+        {}
+
+        std::shared_ptr<PlayerCacheTest> PlayerCacheTest::create(const std::shared_ptr<ftk::Context>& context)
+        {
+            return std::shared_ptr<PlayerCacheTest>(new PlayerCacheTest(context));
+        }
+
+        void PlayerCacheTest::run()
+        {
+            _enums();
+            _video();
+            _compressed();
+            _benchmark();
+            _system();
+        }
+
+        void PlayerCacheTest::_enums()
+        {
+            _enum<PlayerCachePriority>("PlayerCachePriority", getPlayerCachePriorityEnums);
+        }
+
+        namespace
+        {
+            std::vector<VideoData> getVideoData(
+                const OTIO_NS::RationalTime& time,
+                const std::shared_ptr<ftk::Image>& image)
+            {
+                VideoData videoData;
+                videoData.time = time;
+                VideoLayer layer;
+                layer.image = image;
+                videoData.layers.push_back(layer);
+                return { videoData };
+            }
+        }
+
+        void PlayerCacheTest::_video()
+        {
+            const OTIO_NS::TimeRange timeRange(
+                OTIO_NS::RationalTime(100.0, 24.0),
+                OTIO_NS::RationalTime(3000.0, 24.0));
+            PlayerVideoCache cache;
+            cache.setTimeRange(timeRange);
+            FTK_ASSERT(timeRange == cache.getTimeRange());
+            FTK_ASSERT(0 == cache.getSize());
+            FTK_ASSERT(cache.getRanges().empty());
+
+            // Add frames out of order and check that the intervals are
+            // merged.
+            auto image = ftk::Image::create(16, 16, ftk::ImageType::L_U8);
+            for (double frame : { 102.0, 100.0, 104.0, 101.0, 103.0, 2000.0 })
+            {
+                const OTIO_NS::RationalTime time(frame, 24.0);
+                cache.add(time, getVideoData(time, image));
+            }
+            cache.add(OTIO_NS::RationalTime(99.0, 24.0), getVideoData(OTIO_NS::RationalTime(99.0, 24.0), image));
+            cache.add(OTIO_NS::RationalTime(3100.0, 24.0), getVideoData(OTIO_NS::RationalTime(3100.0, 24.0), image));
+            FTK_ASSERT(6 == cache.getSize());
+            FTK_ASSERT(image->getInfo().getByteCount() == cache.getByteCount());
+            auto ranges = cache.getRanges();
+            FTK_ASSERT(2 == ranges.size());
+            FTK_ASSERT(OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(100.0, 24.0),
+                OTIO_NS::RationalTime(5.0, 24.0)) == ranges[0]);
+            FTK_ASSERT(OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(2000.0, 24.0),
+                OTIO_NS::RationalTime(1.0, 24.0)) == ranges[1]);
+            FTK_ASSERT(cache.contains(OTIO_NS::RationalTime(102.0, 24.0)));
+            FTK_ASSERT(!cache.contains(OTIO_NS::RationalTime(105.0, 24.0)));
+            FTK_ASSERT(!cache.contains(OTIO_NS::RationalTime(99.0, 24.0)));
+            auto videoData = cache.get(OTIO_NS::RationalTime(103.0, 24.0));
+            FTK_ASSERT(videoData);
+            FTK_ASSERT(OTIO_NS::RationalTime(103.0, 24.0) == videoData->front().time);
+
+            // Remove a frame from the middle of an interval.
+            FTK_ASSERT(cache.remove({ OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(102.0, 24.0),
+                OTIO_NS::RationalTime(1.0, 24.0)) }));
+            FTK_ASSERT(!cache.remove({ OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(102.0, 24.0),
+                OTIO_NS::RationalTime(1.0, 24.0)) }));
+            ranges = cache.getRanges();
+            FTK_ASSERT(3 == ranges.size());
+            FTK_ASSERT(OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(100.0, 24.0),
+                OTIO_NS::RationalTime(2.0, 24.0)) == ranges[0]);
+            FTK_ASSERT(OTIO_NS::TimeRange(
+                OTIO_NS::RationalTime(103.0, 24.0),
+                OTIO_NS::RationalTime(2.0, 24.0)) == ranges[1]);
+
+            // Keep the frames inside of looped ranges.
+            FTK_ASSERT(cache.keep({
+                OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(1990.0, 24.0),
+                    OTIO_NS::RationalTime(20.0, 24.0)),
+                OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(101.0, 24.0),
+                    OTIO_NS::RationalTime(3.0, 24.0)) }));
+            FTK_ASSERT(3 == cache.getSize());
+            ranges = cache.getRanges();
+            FTK_ASSERT(3 == ranges.size());
+            FTK_ASSERT(OTIO_NS::RationalTime(101.0, 24.0) == ranges[0].start_time());
+            FTK_ASSERT(OTIO_NS::RationalTime(103.0, 24.0) == ranges[1].start_time());
+            FTK_ASSERT(OTIO_NS::RationalTime(2000.0, 24.0) == ranges[2].start_time());
+            FTK_ASSERT(image->getInfo().getByteCount() == cache.getByteCount());
+
+            // Replace a frame with a different image.
+            auto image2 = ftk::Image::create(32, 32, ftk::ImageType::L_U8);
+            cache.add(OTIO_NS::RationalTime(101.0, 24.0), getVideoData(OTIO_NS::RationalTime(101.0, 24.0), image2));
+            FTK_ASSERT(3 == cache.getSize());
+            FTK_ASSERT(
+                image->getInfo().getByteCount() + image2->getInfo().getByteCount() ==
+                cache.getByteCount());
+
+            // Get the nearest cached frames.
+            for (const auto& i : std::vector<std::pair<double, double> >({
+                { 101.0, 101.0 },
+                { 102.0, 101.0 },
+                { 50.0, 101.0 },
+                { 1500.0, 2000.0 },
+                { 5000.0, 2000.0 } }))
+            {
+                videoData = cache.getNearest(OTIO_NS::RationalTime(i.first, 24.0));
+                FTK_ASSERT(videoData);
+                FTK_ASSERT(OTIO_NS::RationalTime(i.second, 24.0) == videoData->front().time);
+            }
+
+            cache.clear();
+            FTK_ASSERT(0 == cache.getSize());
+            FTK_ASSERT(0 == cache.getByteCount());
+            FTK_ASSERT(cache.getRanges().empty());
+        }
+
+        void PlayerCacheTest::_compressed()
+        {
+            // Compress an image with flat regions, like a CG render, and
+            // check that the decompressed image is identical.
+            auto image = ftk::Image::create(64, 64, ftk::ImageType::RGBA_F32);
+            float* p = reinterpret_cast<float*>(image->getData());
+            for (int y = 0; y < 64; ++y)
+            {
+                for (int x = 0; x < 64; ++x, p += 4)
+                {
+                    p[0] = x < 32 ? 0.F : .5F;
+                    p[1] = y < 32 ? .25F : 1.F;
+                    p[2] = x / 63.F;
+                    p[3] = 1.F;
+                }
+            }
+            ftk::ImageTags tags;
+            tags["Name"] = "Value";
+            image->setTags(tags);
+            auto videoData = getVideoData(OTIO_NS::RationalTime(0.0, 24.0), image);
+            videoData.front().layers.front().imageB = image;
+            VideoLayer layer;
+            videoData.front().layers.push_back(layer);
+            auto compressed = compressVideo(videoData);
+            FTK_ASSERT(compressed);
+            FTK_ASSERT(1 == compressed->images.size());
+            FTK_ASSERT(compressed->images.front().compressed);
+            FTK_ASSERT(image->getInfo().getByteCount() == compressed->rawByteCount);
+            FTK_ASSERT(compressed->byteCount < compressed->rawByteCount);
+            const auto decompressed = decompressVideo(*compressed);
+            FTK_ASSERT(1 == decompressed.size());
+            FTK_ASSERT(2 == decompressed.front().layers.size());
+            const auto& image2 = decompressed.front().layers.front().image;
+            FTK_ASSERT(image2);
+            FTK_ASSERT(image2 == decompressed.front().layers.front().imageB);
+            FTK_ASSERT(!decompressed.front().layers.back().image);
+            FTK_ASSERT(image->getInfo() == image2->getInfo());
+            FTK_ASSERT(tags == image2->getTags());
+            FTK_ASSERT(0 == memcmp(
+                image->getData(),
+                image2->getData(),
+                image->getInfo().getByteCount()));
+
+            // Images that do not compress are stored uncompressed.
+            auto noise = ftk::Image::create(16, 16, ftk::ImageType::L_U8);
+            uint32_t seed = 1;
+            for (size_t i = 0; i < noise->getInfo().getByteCount(); ++i)
+            {
+                seed = seed * 1664525 + 1013904223;
+                noise->getData()[i] = seed >> 24;
+            }
+            compressed = compressVideo(getVideoData(OTIO_NS::RationalTime(1.0, 24.0), noise));
+            FTK_ASSERT(!compressed->images.front().compressed);
+            FTK_ASSERT(0 == memcmp(
+                noise->getData(),
+                decompressVideo(*compressed).front().layers.front().image->getData(),
+                noise->getInfo().getByteCount()));
+
+            // Frames removed from the video cache are returned.
+            const OTIO_NS::TimeRange timeRange(
+                OTIO_NS::RationalTime(0.0, 24.0),
+                OTIO_NS::RationalTime(100.0, 24.0));
+            PlayerVideoCache videoCache;
+            videoCache.setTimeRange(timeRange);
+            for (double frame = 0.0; frame < 10.0; frame += 1.0)
+            {
+                const OTIO_NS::RationalTime time(frame, 24.0);
+                videoCache.add(time, getVideoData(time, image));
+            }
+            std::vector<std::pair<OTIO_NS::RationalTime, std::vector<VideoData> > > removed;
+            FTK_ASSERT(videoCache.keep(
+                { OTIO_NS::TimeRange(OTIO_NS::RationalTime(2.0, 24.0), OTIO_NS::RationalTime(6.0, 24.0)) },
+                &removed));
+            FTK_ASSERT(6 == videoCache.getSize());
+            FTK_ASSERT(4 == removed.size());
+            FTK_ASSERT(OTIO_NS::RationalTime(0.0, 24.0) == removed[0].first);
+            FTK_ASSERT(OTIO_NS::RationalTime(9.0, 24.0) == removed[3].first);
+            FTK_ASSERT(image == removed[3].second.front().layers.front().image);
+
+            // Add the removed frames to the compressed cache.
+            PlayerCompressedVideoCache cache;
+            FTK_ASSERT(0 == cache.getSize());
+            FTK_ASSERT(0.F == cache.getRatio());
+            cache.add(OTIO_NS::RationalTime(0.0, 24.0), compressVideo(removed[0].second));
+            FTK_ASSERT(0 == cache.getSize());
+            const OTIO_NS::TimeRange timeRange(
+                OTIO_NS::RationalTime(0.0, 24.0),
+                OTIO_NS::RationalTime(10.0, 24.0));
+            cache.setTimeRange(timeRange);
+            FTK_ASSERT(timeRange == cache.getTimeRange());
+            for (const auto& i : removed)
+            {
+                cache.add(i.first, compressVideo(i.second));
+            }
+            cache.add(OTIO_NS::RationalTime(10.0, 24.0), compressVideo(removed[0].second));
+            FTK_ASSERT(4 == cache.getSize());
+            const size_t byteCount = cache.getByteCount();
+            cache.add(removed[0].first, compressVideo(removed[0].second));
+            FTK_ASSERT(4 == cache.getSize());
+            FTK_ASSERT(byteCount == cache.getByteCount());
+            FTK_ASSERT(cache.getByteCount() > 0);
+            FTK_ASSERT(cache.getRatio() > 1.F);
+            FTK_ASSERT(cache.contains(OTIO_NS::RationalTime(1.0, 24.0)));
+            FTK_ASSERT(!cache.contains(OTIO_NS::RationalTime(2.0, 24.0)));
+            FTK_ASSERT(cache.get(OTIO_NS::RationalTime(8.0, 24.0)));
+            FTK_ASSERT(!cache.get(OTIO_NS::RationalTime(2.0, 24.0)));
+
+            FTK_ASSERT(cache.remove(
+                { OTIO_NS::TimeRange(OTIO_NS::RationalTime(0.0, 24.0), OTIO_NS::RationalTime(1.0, 24.0)) }));
+            FTK_ASSERT(3 == cache.getSize());
+            FTK_ASSERT(cache.keep(
+                { OTIO_NS::TimeRange(OTIO_NS::RationalTime(8.0, 24.0), OTIO_NS::RationalTime(2.0, 24.0)) }));
+            FTK_ASSERT(2 == cache.getSize());
+            FTK_ASSERT(!cache.keep(
+                { OTIO_NS::TimeRange(OTIO_NS::RationalTime(8.0, 24.0), OTIO_NS::RationalTime(2.0, 24.0)) }));
+            cache.clear();
+            FTK_ASSERT(0 == cache.getSize());
+            FTK_ASSERT(0 == cache.getByteCount());
+        }
+
+        void PlayerCacheTest::_benchmark()
+        {
+            // Simulate the player cache update with ten thousand cached
+            // frames: remove the frames outside of the looped cache range,
+            // look up the frames inside of it, add the next frame, and get
+            // the cached ranges.
+            const int64_t frameCount = 10000;
+            const OTIO_NS::TimeRange timeRange(
+                OTIO_NS::RationalTime(0.0, 24.0),
+                OTIO_NS::RationalTime(frameCount * 2, 24.0));
+            PlayerVideoCache cache;
+            cache.setTimeRange(timeRange);
+            auto image = ftk::Image::create(16, 16, ftk::ImageType::L_U8);
+            for (int64_t i = 0; i < frameCount; ++i)
+            {
+                const OTIO_NS::RationalTime time(i, 24.0);
+                cache.add(time, getVideoData(time, image));
+            }
+            FTK_ASSERT(frameCount == cache.getSize());
+
+            const size_t tickCount = 100;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (size_t tick = 0; tick < tickCount; ++tick)
+            {
+                const OTIO_NS::TimeRange cacheRange(
+                    OTIO_NS::RationalTime(tick, 24.0),
+                    OTIO_NS::RationalTime(frameCount, 24.0));
+                cache.keep(timeline::loop(cacheRange, timeRange));
+                const OTIO_NS::RationalTime next(tick + frameCount - 1, 24.0);
+                if (!cache.contains(next))
+                {
+                    cache.add(next, getVideoData(next, image));
+                }
+                FTK_ASSERT(1 == cache.getRanges().size());
+            }
+            const auto t1 = std::chrono::steady_clock::now();
+            FTK_ASSERT(frameCount == cache.getSize());
+            const std::chrono::duration<double, std::micro> diff = t1 - t0;
+            _print(ftk::Format("Cache update with {0} frames: {1}us per tick").
+                arg(frameCount).
+                arg(diff.count() / tickCount));
+        }
+
+        void PlayerCacheTest::_system()
+        {
+            auto system = _context->getSystem<PlayerCacheSystem>();
+            FTK_ASSERT(system);
+            const PlayerCacheBudget budget = system->getBudget();
+            const size_t playerCount = system->getPlayerCount();
+
+            // Make sure the caches are not scaled by the memory pressure.
+            auto memorySystem = _context->getSystem<memory::System>();
+            const memory::PressureOptions memoryOptions = memorySystem->getOptions();
+            memory::PressureOptions memoryOptions2;
+            memoryOptions2.usageLow = 2.F;
+            memoryOptions2.usageHigh = 2.F;
+            memoryOptions2.pressureLow = 2.F;
+            memoryOptions2.pressureHigh = 2.F;
+            memoryOptions2.scaleGrow = 1.F;
+            memorySystem->setOptions(memoryOptions2);
+
+            // The players are only used as keys.
+            const int a = 0;
+            const int b = 0;
+            const Player* playerA = reinterpret_cast<const Player*>(&a);
+            const Player* playerB = reinterpret_cast<const Player*>(&b);
+            system->addPlayer(playerA, PlayerCachePriority::Focused);
+            system->addPlayer(playerB, PlayerCachePriority::Background);
+            FTK_ASSERT(playerCount + 2 == system->getPlayerCount());
+
+            // Without a budget the players use their own options.
+            PlayerCacheOptions options;
+            options.videoGB = 4.F;
+            options.audioGB = 1.F;
+            options.videoCompressedGB = 2.F;
+            system->setBudget(PlayerCacheBudget());
+            FTK_ASSERT(options == system->getCacheOptions(playerA, options));
+
+            // With a budget the players share it by priority.
+            PlayerCacheBudget budget2;
+            budget2.videoGB = 17.F;
+            budget2.videoCompressedGB = 34.F;
+            system->setBudget(budget2);
+            FTK_ASSERT(budget2 == system->getBudget());
+            if (0 == playerCount)
+            {
+                auto optionsA = system->getCacheOptions(playerA, options);
+                auto optionsB = system->getCacheOptions(playerB, options);
+                FTK_ASSERT(std::fabs(optionsA.videoGB - 16.F) < .001F);
+                FTK_ASSERT(std::fabs(optionsB.videoGB - 1.F) < .001F);
+                FTK_ASSERT(std::fabs(optionsA.videoCompressedGB - 32.F) < .001F);
+                FTK_ASSERT(std::fabs(optionsB.videoCompressedGB - 2.F) < .001F);
+                FTK_ASSERT(1.F == optionsA.audioGB);
+                FTK_ASSERT(options.readBehind == optionsA.readBehind);
+
+                system->setPriority(playerB, PlayerCachePriority::Focused);
+                optionsA = system->getCacheOptions(playerA, options);
+                optionsB = system->getCacheOptions(playerB, options);
+                FTK_ASSERT(std::fabs(optionsA.videoGB - 8.5F) < .001F);
+                FTK_ASSERT(std::fabs(optionsB.videoGB - 8.5F) < .001F);
+
+                // Preloading players use the separate preload budget.
+                budget2.preloadVideoGB = 1.F;
+                budget2.preloadFrames = 10;
+                system->setBudget(budget2);
+                system->setPriority(playerB, PlayerCachePriority::Preload);
+                optionsA = system->getCacheOptions(playerA, options);
+                optionsB = system->getCacheOptions(playerB, options);
+                FTK_ASSERT(std::fabs(optionsA.videoGB - 17.F) < .001F);
+                FTK_ASSERT(0 == optionsA.videoFrames);
+                FTK_ASSERT(std::fabs(optionsB.videoGB - 1.F) < .001F);
+                FTK_ASSERT(0.F == optionsB.readBehind);
+                FTK_ASSERT(0.F == optionsB.videoCompressedGB);
+                FTK_ASSERT(10 == optionsB.videoFrames);
+                system->setPriority(playerA, PlayerCachePriority::Preload);
+                optionsB = system->getCacheOptions(playerB, options);
+                FTK_ASSERT(std::fabs(optionsB.videoGB - .5F) < .001F);
+            }
+
+            // The caches are scaled by the memory pressure.
+            memory::PressureOptions memoryOptions3;
+            memoryOptions3.usageLow = 0.F;
+            memoryOptions3.usageHigh = 0.F;
+            memoryOptions3.pressureLow = 0.F;
+            memoryOptions3.pressureHigh = 0.F;
+            memoryOptions3.scaleMin = .5F;
+            memorySystem->setOptions(memoryOptions3);
+            system->setBudget(PlayerCacheBudget());
+            {
+                const auto optionsA = system->getCacheOptions(playerA, options);
+                FTK_ASSERT(std::fabs(optionsA.videoGB - 2.F) < .001F);
+                FTK_ASSERT(std::fabs(optionsA.audioGB - .5F) < .001F);
+                FTK_ASSERT(std::fabs(optionsA.videoCompressedGB - 1.F) < .001F);
+                FTK_ASSERT(std::fabs(optionsA.pinnedVideoGB - options.pinnedVideoGB * .5F) < .001F);
+                FTK_ASSERT(std::fabs(optionsA.pinnedAudioGB - options.pinnedAudioGB * .5F) < .001F);
+            }
+            memorySystem->setOptions(memoryOptions2);
+            memorySystem->setOptions(memoryOptions);
+
+            system->removePlayer(playerA);
+            system->removePlayer(playerB);
+            FTK_ASSERT(playerCount == system->getPlayerCount());
+            FTK_ASSERT(options == system->getCacheOptions(playerA, options));
+            system->setBudget(budget);
+        }
+    }
+}
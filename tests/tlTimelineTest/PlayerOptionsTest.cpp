@@ -31,6 +31,69 @@ namespace tl
                 FTK_ASSERT(v == v);
                 FTK_ASSERT(v != PlayerCacheOptions());
             }
+            {
+                PlayerCacheOptions v;
+                v.videoFrames = 10;
+                FTK_ASSERT(v != PlayerCacheOptions());
+                nlohmann::json json;
+                to_json(json, v);
+                PlayerCacheOptions v2;
+                from_json(json, v2);
+                FTK_ASSERT(v == v2);
+                json.erase("VideoFrames");
+                from_json(json, v2);
+                FTK_ASSERT(PlayerCacheOptions() == v2);
+            }
+            {
+                PlayerCacheBudget v;
+                v.videoGB = 1.F;
+                FTK_ASSERT(v == v);
+                FTK_ASSERT(v != PlayerCacheBudget());
+            }
+            {
+                PlayerCacheOptions v;
+                v.videoCompressedGB = 1.F;
+                FTK_ASSERT(v != PlayerCacheOptions());
+                nlohmann::json json;
+                to_json(json, v);
+                PlayerCacheOptions v2;
+                from_json(json, v2);
+                FTK_ASSERT(v == v2);
+                json.erase("VideoCompressedGB");
+                from_json(json, v2);
+                FTK_ASSERT(PlayerCacheOptions() == v2);
+            }
+            {
+                PlayerCacheOptions v;
+                v.pinnedVideoGB = 2.F;
+                v.pinnedAudioGB = 1.F;
+                FTK_ASSERT(v != PlayerCacheOptions());
+                nlohmann::json json;
+                to_json(json, v);
+                PlayerCacheOptions v2;
+                from_json(json, v2);
+                FTK_ASSERT(v == v2);
+                json.erase("PinnedVideoGB");
+                json.erase("PinnedAudioGB");
+                from_json(json, v2);
+                FTK_ASSERT(PlayerCacheOptions() == v2);
+            }
+            {
+                PlayerCacheBudget v;
+                v.videoCompressedGB = 1.F;
+                FTK_ASSERT(v != PlayerCacheBudget());
+            }
+            {
+                PlayerCacheBudget v;
+                v.preloadVideoGB = 1.F;
+                FTK_ASSERT(v != PlayerCacheBudget());
+            }
+            {
+                PlayerOptions v;
+                v.scrubProxy = 1;
+                FTK_ASSERT(v == v);
+                FTK_ASSERT(v != PlayerOptions());
+            }
         }
     }
 }
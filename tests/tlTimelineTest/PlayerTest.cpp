@@ -319,6 +319,7 @@ namespace tl
                         cacheOptions = value;
                     });
                 cacheOptions.videoGB = 1.F;
+                cacheOptions.videoCompressedGB = .5F;
                 player->setCacheOptions(cacheOptions);
                 FTK_ASSERT(cacheOptions == player->getCacheOptions());
 
@@ -354,6 +355,25 @@ namespace tl
                             ss << "Video/audio cached frames: " << value.video.size() << "/" << value.audio.size();
                             _print(ss.str());
                         }
+                        {
+                            std::stringstream ss;
+                            ss << "Video requests: " << value.videoRequestMax << " max, " <<
+                                value.videoThroughput << " frames/s, " <<
+                                value.videoBufferAhead << "s ahead";
+                            _print(ss.str());
+                        }
+                        {
+                            std::stringstream ss;
+                            ss << "Video compressed cache: " << value.videoCompressedPercentage << "%, " <<
+                                value.videoCompressionRatio << ":1";
+                            _print(ss.str());
+                        }
+                        {
+                            std::stringstream ss;
+                            ss << "Pinned video/audio cache: " << value.pinnedVideoPercentage << "%/" <<
+                                value.pinnedAudioPercentage << "%";
+                            _print(ss.str());
+                        }
                     });
 
                 for (const auto& loop : getLoopEnums())
@@ -405,6 +425,67 @@ namespace tl
                     player->setSpeed(defaultSpeed);
                 }
                 player->setPlayback(Playback::Stop);
+
+                // Get the playback statistics.
+                const PlayerStats stats = player->observeStats()->get();
+                FTK_ASSERT(1 + player->getCompare().size() == stats.latency.size());
+                FTK_ASSERT(player->getPath().get() == stats.latency[0].path);
+                {
+                    std::stringstream ss;
+                    ss << "Frames presented/late/skipped: " << stats.framesPresented << "/" <<
+                        stats.framesLate << "/" << stats.framesSkipped;
+                    _print(ss.str());
+                }
+                {
+                    std::stringstream ss;
+                    ss << "Video latency p50/p95/p99: " << stats.latency[0].p50 << "/" <<
+                        stats.latency[0].p95 << "/" << stats.latency[0].p99 << "ms";
+                    _print(ss.str());
+                }
+                const nlohmann::json json = stats;
+                FTK_ASSERT(json.contains("FramesPresented"));
+                player->resetStats();
+
+                // Pin a range and play another one.
+                std::vector<OTIO_NS::TimeRange> pinnedRanges;
+                auto pinnedRangesObserver = ftk::ListObserver<OTIO_NS::TimeRange>::create(
+                    player->observePinnedRanges(),
+                    [&pinnedRanges](const std::vector<OTIO_NS::TimeRange>& value)
+                    {
+                        pinnedRanges = value;
+                    });
+                const OTIO_NS::TimeRange pinnedRange(
+                    timeRange.start_time(),
+                    OTIO_NS::RationalTime(10.0, timeRange.duration().rate()));
+                player->setPinnedRanges({ pinnedRange });
+                FTK_ASSERT(player->getPinnedRanges() == pinnedRanges);
+                FTK_ASSERT(1 == pinnedRanges.size());
+                player->seek(timeRange.end_time_inclusive());
+                player->setPlayback(Playback::Reverse);
+                auto t = std::chrono::steady_clock::now();
+                std::chrono::duration<float> diff;
+                do
+                {
+                    player->tick();
+                    ftk::sleep(std::chrono::milliseconds(10));
+                    const auto t2 = std::chrono::steady_clock::now();
+                    diff = t2 - t;
+                } while (diff.count() < 1.F);
+                player->setPlayback(Playback::Stop);
+                player->setPinnedRanges({});
+                FTK_ASSERT(pinnedRanges.empty());
+
+                // Scrub.
+                player->setScrub(true);
+                FTK_ASSERT(player->isScrub());
+                for (int i = 0; i < 10; ++i)
+                {
+                    player->seek(timeRange.start_time() + OTIO_NS::RationalTime(i * 2, timeRange.duration().rate()));
+                    player->tick();
+                    ftk::sleep(std::chrono::milliseconds(10));
+                }
+                player->setScrub(false);
+                FTK_ASSERT(!player->isScrub());
                 player->clearCache();
             }
         }
@@ -8,12 +8,18 @@
 
 #include <tlIO/System.h>
 
+#include <ftk/Core/FileIO.h>
 #include <ftk/Core/Format.h>
 
 #include <opentimelineio/clip.h>
 #include <opentimelineio/externalReference.h>
+#include <opentimelineio/gap.h>
 #include <opentimelineio/imageSequenceReference.h>
 #include <opentimelineio/timeline.h>
+#include <opentimelineio/transition.h>
+
+#include <cmath>
+#include <thread>
 
 using namespace tl::timeline;
 
@@ -38,6 +44,10 @@ namespace tl
             _transitions();
             _videoData();
             _timeline();
+            _segments();
+            _occlusion();
+            _sharedFrames();
+            _edit();
             _separateAudio();
         }
 
@@ -108,25 +118,39 @@ namespace tl
                     _printError(e.what());
                 }
             }
-            for (const auto& path : paths)
+            for (auto toMemoryReference : {
+                ToMemoryReference::Shared,
+                ToMemoryReference::Mapped })
             {
-                try
-                {
-                    _print(ftk::Format("Memory timeline: {0}").arg(path.get()));
-                    auto otioTimeline = timeline::create(_context, path);
-                    toMemoryReferences(otioTimeline, path.getDirectory(), ToMemoryReference::Shared);
-                    auto timeline = timeline::Timeline::create(_context, otioTimeline);
-                    _timeline(timeline);
-                }
-                catch (const std::exception& e)
+                for (const auto& path : paths)
                 {
-                    _printError(e.what());
+                    try
+                    {
+                        _print(ftk::Format("Memory timeline ({0}): {1}").
+                            arg(toMemoryReference).
+                            arg(path.get()));
+                        auto otioTimeline = timeline::create(_context, path);
+                        toMemoryReferences(otioTimeline, path.getDirectory(), toMemoryReference);
+                        auto timeline = timeline::Timeline::create(_context, otioTimeline);
+                        _timeline(timeline);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _printError(e.what());
+                    }
                 }
             }
         }
 
         void TimelineTest::_timeline(const std::shared_ptr<timeline::Timeline>& timeline)
         {
+            // Set the maximum number of video requests.
+            const size_t videoRequestMax = timeline->getVideoRequestMax();
+            FTK_ASSERT(timeline->getOptions().videoRequestMax == videoRequestMax);
+            timeline->setVideoRequestMax(0);
+            FTK_ASSERT(1 == timeline->getVideoRequestMax());
+            timeline->setVideoRequestMax(videoRequestMax);
+
             // Get video from the timeline.
             const OTIO_NS::TimeRange& timeRange = timeline->getTimeRange();
             std::vector<timeline::VideoData> videoData;
@@ -215,6 +239,268 @@ namespace tl
             timeline->cancelRequests(ids);
         }
 
+        void TimelineTest::_segments()
+        {
+            try
+            {
+                // Create a track with a transition and a gap. The media
+                // does not exist, so only the layers are checked.
+                OTIO_NS::ErrorStatus errorStatus;
+                auto otioTrack = new OTIO_NS::Track();
+                for (const auto& name : { "A", "B" })
+                {
+                    if (std::string("B") == name)
+                    {
+                        otioTrack->append_child(new OTIO_NS::Transition(
+                            "Dissolve",
+                            "SMPTE_Dissolve",
+                            OTIO_NS::RationalTime(6.0, 24.0),
+                            OTIO_NS::RationalTime(6.0, 24.0)),
+                            &errorStatus);
+                    }
+                    otioTrack->append_child(new OTIO_NS::Clip(
+                        name,
+                        new OTIO_NS::ExternalReference(std::string(name) + ".tlrender_segments"),
+                        OTIO_NS::TimeRange(
+                            OTIO_NS::RationalTime(0.0, 24.0),
+                            OTIO_NS::RationalTime(24.0, 24.0))),
+                        &errorStatus);
+                }
+                otioTrack->append_child(new OTIO_NS::Gap(
+                    OTIO_NS::TimeRange(
+                        OTIO_NS::RationalTime(0.0, 24.0),
+                        OTIO_NS::RationalTime(24.0, 24.0))),
+                    &errorStatus);
+                if (OTIO_NS::is_error(errorStatus))
+                {
+                    throw std::runtime_error("Cannot append child");
+                }
+                auto otioStack = new OTIO_NS::Stack;
+                otioStack->append_child(otioTrack, &errorStatus);
+                if (OTIO_NS::is_error(errorStatus))
+                {
+                    throw std::runtime_error("Cannot append child");
+                }
+                OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> otioTimeline(new OTIO_NS::Timeline);
+                otioTimeline->set_tracks(otioStack);
+                auto timeline = Timeline::create(_context, otioTimeline);
+                FTK_ASSERT(OTIO_NS::RationalTime(72.0, 24.0) == timeline->getTimeRange().duration());
+
+                auto videoData = timeline->getVideo(OTIO_NS::RationalTime(10.0, 24.0)).future.get();
+                FTK_ASSERT(1 == videoData.layers.size());
+                FTK_ASSERT(Transition::None == videoData.layers[0].transition);
+
+                videoData = timeline->getVideo(OTIO_NS::RationalTime(20.0, 24.0)).future.get();
+                FTK_ASSERT(1 == videoData.layers.size());
+                FTK_ASSERT(Transition::Dissolve == videoData.layers[0].transition);
+                FTK_ASSERT(std::fabs(videoData.layers[0].transitionValue - 3.F / 13.F) < .001F);
+
+                videoData = timeline->getVideo(OTIO_NS::RationalTime(26.0, 24.0)).future.get();
+                FTK_ASSERT(1 == videoData.layers.size());
+                FTK_ASSERT(Transition::Dissolve == videoData.layers[0].transition);
+                FTK_ASSERT(std::fabs(videoData.layers[0].transitionValue - 9.F / 13.F) < .001F);
+
+                videoData = timeline->getVideo(OTIO_NS::RationalTime(50.0, 24.0)).future.get();
+                FTK_ASSERT(1 == videoData.layers.size());
+                FTK_ASSERT(Transition::None == videoData.layers[0].transition);
+                FTK_ASSERT(!videoData.layers[0].image);
+
+                videoData = timeline->getVideo(OTIO_NS::RationalTime(80.0, 24.0)).future.get();
+                FTK_ASSERT(videoData.layers.empty());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
+        void TimelineTest::_occlusion()
+        {
+            try
+            {
+                // Create two tracks with opaque full frame clips.
+                OTIO_NS::ErrorStatus errorStatus;
+                auto otioStack = new OTIO_NS::Stack;
+                for (const auto& name : { "OcclusionA.y4m", "OcclusionB.y4m" })
+                {
+                    {
+                        std::string data = "YUV4MPEG2 W4 H2 F24:1 C420jpeg\nFRAME\n";
+                        data.append(4 * 2 + 2 * 2 * 1, static_cast<char>(0));
+                        auto fileIO = ftk::FileIO::create(name, ftk::FileMode::Write);
+                        fileIO->write(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+                    }
+                    auto otioTrack = new OTIO_NS::Track();
+                    otioTrack->append_child(new OTIO_NS::Clip(
+                        name,
+                        new OTIO_NS::ExternalReference(name),
+                        OTIO_NS::TimeRange(
+                            OTIO_NS::RationalTime(0.0, 24.0),
+                            OTIO_NS::RationalTime(1.0, 24.0))),
+                        &errorStatus);
+                    otioStack->append_child(otioTrack, &errorStatus);
+                }
+                if (OTIO_NS::is_error(errorStatus))
+                {
+                    throw std::runtime_error("Cannot append child");
+                }
+                OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> otioTimeline(new OTIO_NS::Timeline);
+                otioTimeline->set_tracks(otioStack);
+                auto timeline = Timeline::create(_context, otioTimeline);
+
+                // The lower track is hidden.
+                auto videoData = timeline->getVideo(OTIO_NS::RationalTime(0.0, 24.0)).future.get();
+                FTK_ASSERT(1 == videoData.layers.size());
+                FTK_ASSERT(videoData.layers[0].image);
+
+                // Disable occlusion culling.
+                io::Options ioOptions;
+                ioOptions["Timeline/OcclusionCulling"] = "0";
+                videoData = timeline->getVideo(OTIO_NS::RationalTime(0.0, 24.0), ioOptions).future.get();
+                FTK_ASSERT(2 == videoData.layers.size());
+                FTK_ASSERT(videoData.layers[0].image);
+                FTK_ASSERT(videoData.layers[1].image);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
+        void TimelineTest::_sharedFrames()
+        {
+            try
+            {
+                // Create a track that repeats the same media frame.
+                const std::string fileName = "SharedFrames.y4m";
+                {
+                    std::string data = "YUV4MPEG2 W4 H2 F24:1 C420jpeg\nFRAME\n";
+                    data.append(4 * 2 + 2 * 2 * 1, static_cast<char>(0));
+                    auto fileIO = ftk::FileIO::create(fileName, ftk::FileMode::Write);
+                    fileIO->write(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+                }
+                OTIO_NS::ErrorStatus errorStatus;
+                auto otioTrack = new OTIO_NS::Track();
+                for (size_t i = 0; i < 2; ++i)
+                {
+                    otioTrack->append_child(new OTIO_NS::Clip(
+                        "Clip",
+                        new OTIO_NS::ExternalReference(fileName),
+                        OTIO_NS::TimeRange(
+                            OTIO_NS::RationalTime(0.0, 24.0),
+                            OTIO_NS::RationalTime(1.0, 24.0))),
+                        &errorStatus);
+                }
+                auto otioStack = new OTIO_NS::Stack;
+                otioStack->append_child(otioTrack, &errorStatus);
+                if (OTIO_NS::is_error(errorStatus))
+                {
+                    throw std::runtime_error("Cannot append child");
+                }
+                OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> otioTimeline(new OTIO_NS::Timeline);
+                otioTimeline->set_tracks(otioStack);
+                auto timeline = Timeline::create(_context, otioTimeline);
+
+                // Both timeline frames share the same image.
+                auto request0 = timeline->getVideo(OTIO_NS::RationalTime(0.0, 24.0));
+                auto request1 = timeline->getVideo(OTIO_NS::RationalTime(1.0, 24.0));
+                const auto videoData0 = request0.future.get();
+                const auto videoData1 = request1.future.get();
+                FTK_ASSERT(1 == videoData0.layers.size());
+                FTK_ASSERT(1 == videoData1.layers.size());
+                FTK_ASSERT(videoData0.layers[0].image);
+                FTK_ASSERT(videoData0.layers[0].image == videoData1.layers[0].image);
+
+                // Different options are not shared.
+                io::Options ioOptions;
+                ioOptions["Layer"] = "0";
+                const auto videoData2 = timeline->getVideo(OTIO_NS::RationalTime(0.0, 24.0), ioOptions).future.get();
+                FTK_ASSERT(1 == videoData2.layers.size());
+                FTK_ASSERT(videoData2.layers[0].image);
+                FTK_ASSERT(videoData0.layers[0].image != videoData2.layers[0].image);
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
+        void TimelineTest::_edit()
+        {
+            try
+            {
+                // Create timelines with three clips, the second clip can be
+                // trimmed and the track can be disabled.
+                auto create = [](double offset, bool enabled)
+                    {
+                        OTIO_NS::ErrorStatus errorStatus;
+                        auto otioTrack = new OTIO_NS::Track();
+                        otioTrack->set_enabled(enabled);
+                        for (size_t i = 0; i < 3; ++i)
+                        {
+                            otioTrack->append_child(new OTIO_NS::Clip(
+                                ftk::Format("Clip{0}").arg(i),
+                                new OTIO_NS::ExternalReference(ftk::Format("Edit{0}.tlrender_edit").arg(i)),
+                                OTIO_NS::TimeRange(
+                                    OTIO_NS::RationalTime(1 == i ? offset : 0.0, 24.0),
+                                    OTIO_NS::RationalTime(24.0, 24.0))),
+                                &errorStatus);
+                        }
+                        auto otioStack = new OTIO_NS::Stack;
+                        otioStack->append_child(otioTrack, &errorStatus);
+                        if (OTIO_NS::is_error(errorStatus))
+                        {
+                            throw std::runtime_error("Cannot append child");
+                        }
+                        OTIO_NS::SerializableObject::Retainer<OTIO_NS::Timeline> otioTimeline(new OTIO_NS::Timeline);
+                        otioTimeline->set_tracks(otioStack);
+                        return otioTimeline;
+                    };
+                auto timeline = Timeline::create(_context, create(0.0, true));
+                TimelineEdit observed;
+                auto observer = ftk::ValueObserver<TimelineEdit>::create(
+                    timeline->observeEdit(),
+                    [&observed](const TimelineEdit& value)
+                    {
+                        observed = value;
+                    });
+
+                // Only the trimmed clip is changed.
+                auto edit = timeline->setTimeline(create(10.0, true));
+                FTK_ASSERT(edit == observed);
+                FTK_ASSERT(1 == edit.video.size());
+                FTK_ASSERT(OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(24.0, 24.0),
+                    OTIO_NS::RationalTime(24.0, 24.0)) == edit.video[0]);
+                FTK_ASSERT(edit.audio.empty());
+
+                // Nothing is changed.
+                edit = timeline->setTimeline(create(10.0, true));
+                FTK_ASSERT(edit.video.empty());
+
+                // The whole track is changed.
+                edit = timeline->setTimeline(create(10.0, false));
+                FTK_ASSERT(1 == edit.video.size());
+                FTK_ASSERT(OTIO_NS::TimeRange(
+                    OTIO_NS::RationalTime(0.0, 24.0),
+                    OTIO_NS::RationalTime(72.0, 24.0)) == edit.video[0]);
+
+                // Requests use the new timeline.
+                const auto videoData = timeline->getVideo(OTIO_NS::RationalTime(0.0, 24.0)).future.get();
+                FTK_ASSERT(videoData.layers.empty());
+
+                // The I/O information is read on the timeline thread.
+                while (timeline->isIOInfoPending())
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+                FTK_ASSERT(timeline->getIOInfo().video.empty());
+            }
+            catch (const std::exception& e)
+            {
+                _printError(e.what());
+            }
+        }
+
         void TimelineTest::_separateAudio()
         {
 #if defined(TLRENDER_FFMPEG)
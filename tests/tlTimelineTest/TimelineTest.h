@@ -29,6 +29,10 @@ namespace tl
             void _videoData();
             void _timeline();
             void _timeline(const std::shared_ptr<timeline::Timeline>&);
+            void _segments();
+            void _occlusion();
+            void _sharedFrames();
+            void _edit();
             void _separateAudio();
         };
     }
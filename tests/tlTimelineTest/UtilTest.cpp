@@ -3,14 +3,20 @@
 
 #include <tlTimelineTest/UtilTest.h>
 
+#include <tlTimeline/MemoryReference.h>
+#include <tlTimeline/Timeline.h>
 #include <tlTimeline/Util.h>
 
 #include <tlCore/FileInfo.h>
 
+#include <ftk/Core/Assert.h>
+#include <ftk/Core/FileIO.h>
 #include <ftk/Core/Format.h>
 
 #include <opentimelineio/clip.h>
 
+#include <cstring>
+
 using namespace tl::timeline;
 
 namespace tl
@@ -383,10 +389,54 @@ namespace tl
                         dynamic_cast<OTIO_NS::Timeline*>(OTIO_NS::Timeline::from_json_file(entry.getPath().get())));
                     file::Path outputPath = entry.getPath();
                     outputPath.setExtension(".otioz");
-                    writeOTIOZ(
+                    uint64_t bytes = 0;
+                    uint64_t totalBytes = 0;
+                    const bool r = writeOTIOZ(
                         outputPath.get(-1, file::PathType::FileName),
                         timeline,
-                        TLRENDER_SAMPLE_DATA);
+                        TLRENDER_SAMPLE_DATA,
+                        [&bytes, &totalBytes](uint64_t value, uint64_t total)
+                        {
+                            FTK_ASSERT(value > bytes);
+                            bytes = value;
+                            totalBytes = total;
+                        });
+                    if (r)
+                    {
+                        FTK_ASSERT(bytes == totalBytes);
+                    }
+
+                    // Check that the media is mapped from the file.
+                    try
+                    {
+                        auto otioz = timeline::create(
+                            _context,
+                            file::Path(outputPath.get(-1, file::PathType::FileName)));
+                        for (auto clip : otioz->find_children<OTIO_NS::Clip>())
+                        {
+                            if (auto ref = dynamic_cast<RawMemoryReference*>(clip->media_reference()))
+                            {
+                                const auto path = getPath(
+                                    ref->target_url(),
+                                    TLRENDER_SAMPLE_DATA,
+                                    file::PathOptions());
+                                auto fileIO = ftk::FileIO::create(path.get(), ftk::FileMode::Read);
+                                std::vector<uint8_t> data(fileIO->getSize());
+                                fileIO->read(data.data(), data.size());
+                                FTK_ASSERT(data.size() == ref->memory_size());
+                                FTK_ASSERT(0 == std::memcmp(data.data(), ref->memory(), data.size()));
+                            }
+                            else if (auto ref = dynamic_cast<RawMemorySequenceReference*>(clip->media_reference()))
+                            {
+                                FTK_ASSERT(!ref->memory().empty());
+                                FTK_ASSERT(ref->memory().size() == ref->memory_sizes().size());
+                            }
+                        }
+                    }
+                    catch (const std::exception& e)
+                    {
+                        _printError(e.what());
+                    }
                 }
             }
         }
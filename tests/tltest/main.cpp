@@ -10,15 +10,23 @@
 #include <tlTimelineTest/CompareOptionsTest.h>
 #include <tlTimelineTest/DisplayOptionsTest.h>
 #include <tlTimelineTest/MemoryReferenceTest.h>
+#include <tlTimelineTest/PlayerCacheTest.h>
 #include <tlTimelineTest/PlayerOptionsTest.h>
 #include <tlTimelineTest/PlayerTest.h>
 #include <tlTimelineTest/TimelineTest.h>
 #include <tlTimelineTest/UtilTest.h>
 
+#include <tlIOTest/DPXTest.h>
+#include <tlIOTest/DiskCacheTest.h>
+#include <tlIOTest/FrameCacheTest.h>
 #include <tlIOTest/IOTest.h>
+#include <tlIOTest/YUVTest.h>
 #if defined(TLRENDER_FFMPEG)
 #include <tlIOTest/FFmpegTest.h>
 #endif // TLRENDER_FFMPEG
+#if defined(TLRENDER_JPEG)
+#include <tlIOTest/JPEGTest.h>
+#endif // TLRENDER_JPEG
 #if defined(TLRENDER_EXR)
 #include <tlIOTest/OpenEXRTest.h>
 #endif // TLRENDER_EXR
@@ -29,6 +37,7 @@
 #include <tlCoreTest/AudioTest.h>
 #include <tlCoreTest/FileInfoTest.h>
 #include <tlCoreTest/HDRTest.h>
+#include <tlCoreTest/MemorySystemTest.h>
 #include <tlCoreTest/PathTest.h>
 #include <tlCoreTest/TimeTest.h>
 #include <tlCoreTest/URLTest.h>
@@ -50,6 +59,7 @@ void coreTests(
     tests.push_back(core_tests::AudioTest::create(context));
     tests.push_back(core_tests::FileInfoTest::create(context));
     tests.push_back(core_tests::HDRTest::create(context));
+    tests.push_back(core_tests::MemorySystemTest::create(context));
     tests.push_back(core_tests::PathTest::create(context));
     tests.push_back(core_tests::TimeTest::create(context));
     tests.push_back(core_tests::URLTest::create(context));
@@ -60,9 +70,16 @@ void ioTests(
     const std::shared_ptr<ftk::Context>& context)
 {
     tests.push_back(io_tests::IOTest::create(context));
+    tests.push_back(io_tests::DPXTest::create(context));
+    tests.push_back(io_tests::DiskCacheTest::create(context));
+    tests.push_back(io_tests::FrameCacheTest::create(context));
+    tests.push_back(io_tests::YUVTest::create(context));
 #if defined(TLRENDER_FFMPEG)
     tests.push_back(io_tests::FFmpegTest::create(context));
 #endif // TLRENDER_FFMPEG
+#if defined(TLRENDER_JPEG)
+    tests.push_back(io_tests::JPEGTest::create(context));
+#endif // TLRENDER_JPEG
 #if defined(TLRENDER_OIIO)
     tests.push_back(io_tests::OIIOTest::create(context));
 #endif // TLRENDER_OIIO
@@ -79,6 +96,7 @@ void timelineTests(
     tests.push_back(timeline_tests::CompareOptionsTest::create(context));
     tests.push_back(timeline_tests::DisplayOptionsTest::create(context));
     tests.push_back(timeline_tests::MemoryReferenceTest::create(context));
+    tests.push_back(timeline_tests::PlayerCacheTest::create(context));
     tests.push_back(timeline_tests::PlayerOptionsTest::create(context));
     tests.push_back(timeline_tests::PlayerTest::create(context));
     tests.push_back(timeline_tests::TimelineTest::create(context));